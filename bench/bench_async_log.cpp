@@ -0,0 +1,92 @@
+/**
+ * @file bench_async_log.cpp
+ * @brief Cost of the consumer's per-sample console line: std::ostream vs snprintf+fwrite vs AsyncLog.
+ *
+ * Each variant writes "consumer: T=%g C (avg=%g), P=%g (avg=%g)" with four floats to /dev/null. The
+ * timed part is what the calling (consumer) thread pays per line. AsyncLog calls are timed in bursts
+ * that fit its ring, with flush() between bursts outside the timing, so nothing is dropped; its writer
+ * thread's formatting is reported separately as lines/s. A filtered call (level below the logger's)
+ * shows the cost of a disabled debug line.
+ * Usage: bench_async_log [lines]   (default 200000)
+ */
+
+#include "industrial/AsyncLog.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+using clock_type = std::chrono::steady_clock;
+using industrial::AsyncLog;
+using industrial::LogFormat;
+using industrial::LogLevel;
+
+static const LogFormat kSample{LogLevel::Debug, "consumer: T=%g C (avg=%g), P=%g (avg=%g)"};
+
+static float value(size_t i) { return 20.0f + (float)(i % 1000) * 0.0137f; }
+
+static double ns_since(clock_type::time_point t0) {
+    return std::chrono::duration<double, std::nano>(clock_type::now() - t0).count();
+}
+
+int main(int argc, char** argv) {
+    const size_t lines = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+    {
+        std::ofstream os("/dev/null");
+        const auto t0 = clock_type::now();
+        for (size_t i = 0; i < lines; ++i) {
+            const float v = value(i);
+            os << "consumer: T=" << v << " C (avg=" << v + 0.5f << "), P=" << v * 5.0f << " (avg=" << v * 5.1f
+               << ")\n";
+        }
+        os.flush();
+        std::printf("%-22s %8.1f ns/line\n", "std::ostream", ns_since(t0) / (double)lines);
+    }
+    {
+        std::FILE* f = std::fopen("/dev/null", "w");
+        const auto t0 = clock_type::now();
+        for (size_t i = 0; i < lines; ++i) {
+            const float v = value(i);
+            std::fprintf(f, "consumer: T=%g C (avg=%g), P=%g (avg=%g)\n", v, v + 0.5f, v * 5.0f, v * 5.1f);
+        }
+        std::fflush(f);
+        std::printf("%-22s %8.1f ns/line\n", "fprintf", ns_since(t0) / (double)lines);
+        std::fclose(f);
+    }
+    {
+        static AsyncLog log;
+        std::FILE* f = std::fopen("/dev/null", "w");
+        log.start(f);
+        constexpr size_t kBurst = industrial::kLogRingRecords / 2;
+        double caller_ns = 0;
+        const auto t_all = clock_type::now();
+        for (size_t done = 0; done < lines;) {
+            const size_t n = lines - done < kBurst ? lines - done : kBurst;
+            const auto t0 = clock_type::now();
+            for (size_t i = done; i < done + n; ++i) {
+                const float v = value(i);
+                log.log(kSample, v, v + 0.5f, v * 5.0f, v * 5.1f);
+            }
+            caller_ns += ns_since(t0);
+            done += n;
+            log.flush();
+        }
+        const double all_ns = ns_since(t_all);
+        log.stop();
+        std::printf("%-22s %8.1f ns/line  (writer: %.0f lines/s in %llu writes, %llu dropped)\n", "AsyncLog (caller)",
+                    caller_ns / (double)lines, (double)log.written() * 1e9 / all_ns,
+                    (unsigned long long)log.batches(), (unsigned long long)log.dropped());
+
+        log.set_level(LogLevel::Info);
+        const auto t0 = clock_type::now();
+        for (size_t i = 0; i < lines; ++i) {
+            const float v = value(i);
+            log.log(kSample, v, v + 0.5f, v * 5.0f, v * 5.1f);
+        }
+        std::printf("%-22s %8.1f ns/line\n", "AsyncLog (filtered)", ns_since(t0) / (double)lines);
+        std::fclose(f);
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file bench_influx_sink.cpp
+ * @brief Line-protocol throughput: formatting cost (fixed-point vs snprintf) and samples/s through InfluxSink.
+ *
+ * Each sample becomes one 4-field line with an integer ns timestamp. The end-to-end runs format
+ * into a stack buffer and write() to an InfluxSink connected to the in-process stand-in listener
+ * (tests/support), over raw TCP and over HTTP keep-alive, for several flush sizes.
+ * Usage: bench_influx_sink [samples]   (default 1000000)
+ */
+
+#include "industrial/InfluxSink.hpp"
+#include "industrial/LineProtocol.hpp"
+#include "support/FakeLineServer.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+using industrial::Frame;
+using industrial::InfluxField;
+using industrial::InfluxSink;
+using industrial::testing::FakeLineServer;
+
+static volatile size_t g_sink; // keeps the formatters from being optimized away
+static const char kPrefix[] = "sensor_sim,host=gw1,sensor=sim0";
+
+static size_t format_line(char* buf, size_t cap, size_t i) {
+    const float t = 25.0f + (float)(i % 1000) * 0.013f;
+    const float p = 1400.0f + (float)(i % 777) * 0.07f;
+    const InfluxField f[4] = {{"temperature", t}, {"temperature_avg", t - 0.2f}, {"pressure", p}, {"pressure_avg", p + 0.4f}};
+    return industrial::influx_line(buf, cap, kPrefix, f, 4, 1700000000000000000LL + (int64_t)i * 50000000);
+}
+
+static size_t format_line_printf(char* buf, size_t cap, size_t i) {
+    const float t = 25.0f + (float)(i % 1000) * 0.013f;
+    const float p = 1400.0f + (float)(i % 777) * 0.07f;
+    int n = std::snprintf(buf, cap, "%s temperature=%.3f,temperature_avg=%.3f,pressure=%.3f,pressure_avg=%.3f %lld\n",
+                          kPrefix, t, t - 0.2f, p, p + 0.4f, 1700000000000000000LL + (long long)i * 50000000);
+    return n > 0 ? (size_t)n : 0;
+}
+
+template <typename Fn>
+static void bench_format(const char* label, Fn fn, size_t samples) {
+    char buf[256];
+    size_t bytes = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < samples; ++i) bytes += fn(buf, sizeof(buf), i);
+    auto t1 = std::chrono::steady_clock::now();
+    g_sink = bytes;
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / (double)samples;
+    std::printf("format %-12s %8.1f ns/line %8.1f bytes/line\n", label, ns, (double)bytes / (double)samples);
+}
+
+static void bench_sink(FakeLineServer::Mode mode, size_t flush_bytes, size_t samples) {
+    FakeLineServer server(mode);
+    server.set_keep_lines(false);
+    if (!server.start()) return;
+    auto owned = std::make_unique<InfluxSink>(); // 256 KiB batch buffer: keep it off the stack
+    InfluxSink& sink = *owned;
+    if (!sink.open(server.url())) return;
+    sink.set_flush(flush_bytes, std::chrono::milliseconds(1000));
+    char buf[256];
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < samples; ++i) {
+        const size_t n = format_line(buf, sizeof(buf), i);
+        (void)sink.write(Frame{"", (const uint8_t*)buf, n, false});
+    }
+    (void)sink.flush();
+    const bool all = server.wait_lines(samples, 10000);
+    auto t1 = std::chrono::steady_clock::now();
+    const double secs = std::chrono::duration<double>(t1 - t0).count();
+    std::printf("%-4s flush %6zu KiB %12.0f samples/s  batches=%llu dropped=%llu%s\n",
+                mode == FakeLineServer::Mode::Http ? "http" : "tcp", flush_bytes / 1024, (double)samples / secs,
+                (unsigned long long)sink.batches(), (unsigned long long)sink.dropped_lines(),
+                all ? "" : "  (listener incomplete)");
+    sink.close();
+    server.stop();
+}
+
+int main(int argc, char** argv) {
+    size_t samples = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    std::printf("bench_influx_sink: %zu samples, 4 fields each\n", samples);
+    bench_format("fixed-point", format_line, samples);
+    bench_format("snprintf", format_line_printf, samples);
+    for (size_t kib : {4, 64, 256}) bench_sink(FakeLineServer::Mode::Tcp, kib * 1024, samples);
+    for (size_t kib : {4, 64, 256}) bench_sink(FakeLineServer::Mode::Http, kib * 1024, samples);
+    return 0;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file bench_mqtt_pool.cpp
+ * @brief Aggregate publish throughput of MqttPublisherPool with 1, 2, 4 and 8 connections.
+ *
+ * One producer spreads messages of 64 sensors over the pool (QoS 0, Batched mode) against the
+ * in-process stand-in broker and times until the broker has parsed the last one. The stand-in
+ * serves all sessions from one thread, so on few cores it becomes the ceiling; point the pool at a
+ * real multi-threaded broker to see connection scaling.
+ * Usage: bench_mqtt_pool [messages]   (default 200000)
+ */
+
+#include "industrial/MqttPublisherPool.hpp"
+#include "industrial/PayloadPool.hpp"
+#include "support/FakeMqttBroker.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Pool = industrial::PayloadPool<industrial::kPayloadPoolSlots, industrial::kPayloadSlotBytes>;
+using PubPool = industrial::MqttPublisherPool<Pool>;
+using industrial::testing::FakeMqttBroker;
+
+static Pool pool;
+
+static void run(uint32_t connections, size_t messages) {
+    FakeMqttBroker broker;
+    broker.set_keep_messages(false);
+    if (!broker.start()) return;
+    PubPool pubs(pool);
+    if (pubs.connect(broker.uri(), "bench", 60, connections) != connections) {
+        std::printf("%u connections: connect failed\n", connections);
+        return;
+    }
+    pubs.set_mode(industrial::MqttPublisher::Mode::Batched, 32);
+    pubs.start();
+
+    constexpr uint32_t kSensors = 64;
+    std::vector<std::string> topics;
+    for (uint32_t s = 0; s < kSensors; ++s) topics.push_back("bench/sensor" + std::to_string(s));
+
+    size_t waits = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < messages; ++i) {
+        const uint32_t sensor = (uint32_t)(i % kSensors);
+        Pool::Handle h;
+        while ((h = pool.acquire()) == Pool::kInvalid) {
+            ++waits;
+            std::this_thread::yield();
+        }
+        std::memset(pool.data(h), '5', 40);
+        pool.set_len(h, 40);
+        while (pubs.stats(pubs.shard_of(sensor)).depth >= industrial::kMqttShardQueueCapacity) { // never measure drops
+            ++waits;
+            std::this_thread::yield();
+        }
+        pubs.submit(sensor, h, topics[sensor]);
+    }
+    const bool complete = broker.wait_publishes(messages, 20000);
+    auto t1 = std::chrono::steady_clock::now();
+    pubs.stop();
+    pubs.disconnect();
+
+    const double secs = std::chrono::duration<double>(t1 - t0).count();
+    std::printf("%2u connections %12.0f msg/s%s  waits=%zu\n", connections, (double)messages / secs,
+                complete ? "" : "  (incomplete)", waits);
+}
+
+int main(int argc, char** argv) {
+    size_t messages = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    std::printf("bench_mqtt_pool: %zu messages of 40 bytes, 64 sensors, QoS 0 batched, %u hw threads\n",
+                messages, std::thread::hardware_concurrency());
+    for (uint32_t n : {1u, 2u, 4u, 8u}) run(n, messages);
+    return 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file bench_payload_encoding.cpp
+ * @brief Bytes per sample and encode ns per sample: CSV vs Sparkplug B DDATA vs Gorilla blocks.
+ *
+ * Every format encodes the same SimSensor samples (temperature, its moving average, pressure, its
+ * moving average) into one reused buffer, exactly as the consumer does. Sparkplug is measured with
+ * one sample per DDATA and with the kSparkplugBatchSamples batch the demo uses; Gorilla blocks carry
+ * raw samples only (no averages), for reference.
+ * Usage: bench_payload_encoding [samples]   (default 1000000)
+ */
+
+#include "industrial/Config.hpp"
+#include "industrial/GorillaCodec.hpp"
+#include "industrial/MovingAverageFloat.hpp"
+#include "industrial/SimSensor.hpp"
+#include "industrial/Sparkplug.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using industrial::SensorSample;
+
+struct Row {
+    SensorSample s;
+    float t_avg;
+    float p_avg;
+};
+
+static volatile size_t g_sink; // keeps the encoders from being optimized away
+
+static void report(const char* label, size_t samples, size_t bytes, std::chrono::steady_clock::duration d) {
+    const double ns = std::chrono::duration<double, std::nano>(d).count() / (double)samples;
+    std::printf("%-18s %8.1f bytes/sample %8.1f ns/sample\n", label, (double)bytes / (double)samples, ns);
+}
+
+static void bench_csv(const std::vector<Row>& rows) {
+    char buf[industrial::kPayloadSlotBytes];
+    size_t bytes = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (const Row& r : rows) {
+        int n = std::snprintf(buf, sizeof(buf), "%.3f,%.3f,%.3f,%.3f", r.s.temperature_c, r.t_avg, r.s.pressure_kpa, r.p_avg);
+        bytes += (size_t)n;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    g_sink = bytes;
+    report("csv", rows.size(), bytes, t1 - t0);
+}
+
+static void bench_sparkplug(const char* label, const std::vector<Row>& rows, uint32_t batch) {
+    uint8_t buf[industrial::kPayloadSlotBytes];
+    industrial::SparkplugSession session;
+    session.rebirth();
+    (void)session.next_seq(); // NBIRTH took seq 0
+    const uint64_t base_ms = 1700000000000ull;
+    size_t bytes = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < rows.size(); i += batch) {
+        industrial::SparkplugEncoder enc(buf, sizeof(buf));
+        enc.begin(base_ms + i * 50);
+        for (size_t k = i; k < i + batch && k < rows.size(); ++k) {
+            const uint64_t ts = base_ms + k * 50;
+            enc.metric_float(1, ts, rows[k].s.temperature_c);
+            enc.metric_float(2, ts, rows[k].t_avg);
+            enc.metric_float(3, ts, rows[k].s.pressure_kpa);
+            enc.metric_float(4, ts, rows[k].p_avg);
+        }
+        bytes += enc.finish(session.next_seq());
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    g_sink = bytes;
+    report(label, rows.size(), bytes, t1 - t0);
+}
+
+static void bench_gorilla(const std::vector<Row>& rows) {
+    uint8_t buf[industrial::kPayloadSlotBytes];
+    size_t bytes = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    industrial::GorillaEncoder enc(buf, sizeof(buf));
+    for (const Row& r : rows) {
+        (void)enc.append(r.s);
+        if (enc.count() == industrial::kGorillaBlockSamples) {
+            bytes += enc.finish();
+            enc = industrial::GorillaEncoder(buf, sizeof(buf));
+        }
+    }
+    if (enc.count() > 0) bytes += enc.finish();
+    auto t1 = std::chrono::steady_clock::now();
+    g_sink = bytes;
+    report("gorilla (raw x32)", rows.size(), bytes, t1 - t0);
+}
+
+int main(int argc, char** argv) {
+    size_t samples = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    industrial::SimSensor sensor;
+    industrial::MovingAverageFloat<industrial::kMaxAvgWindow> t_avg, p_avg;
+    t_avg.set_window(8);
+    p_avg.set_window(8);
+    std::vector<Row> rows(samples);
+    auto ts = std::chrono::steady_clock::now();
+    for (Row& r : rows) {
+        sensor.read(r.s);
+        r.s.ts = ts; // 50 ms period, as in the demo
+        ts += std::chrono::milliseconds(50);
+        r.t_avg = t_avg.push(r.s.temperature_c);
+        r.p_avg = p_avg.push(r.s.pressure_kpa);
+    }
+
+    std::printf("bench_payload_encoding: %zu samples, 4 values each\n", samples);
+    bench_csv(rows);
+    bench_sparkplug("sparkplug x1", rows, 1);
+    char label[32];
+    std::snprintf(label, sizeof(label), "sparkplug x%u", industrial::kSparkplugBatchSamples);
+    bench_sparkplug(label, rows, industrial::kSparkplugBatchSamples);
+    bench_gorilla(rows);
+    return 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file bench_rt_jitter.cpp
+ * @brief Sampling jitter of a pipeline with and without real-time mode, while other threads load the CPUs.
+ *
+ * A source stage runs every period_us (default 1000 us) and records how far each interval between two
+ * samples is from the period; a sink stage on a second pipeline thread records sample-to-pickup
+ * latency. load_threads busy threads (default one per CPU) compete with both. The same run is made
+ * with default scheduling, then with real-time mode: mlockall, SCHED_FIFO 80/79 and, if cpu is
+ * given, both pipeline threads pinned to it. Without privileges the second run reports what was
+ * refused and shows the difference that is left.
+ * Usage: bench_rt_jitter [seconds] [period_us] [load_threads] [cpu]   (default 2 s, 1000 us, nproc, none)
+ */
+
+#include "industrial/LatencyHistogram.hpp"
+#include "industrial/Pipeline.hpp"
+#include "industrial/Realtime.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+using clock_type = std::chrono::steady_clock;
+using namespace industrial;
+
+static int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch()).count();
+}
+
+// Emits its timestamp every period until end
+struct Paced {
+    int64_t period_ns;
+    int64_t end_ns;
+    LatencyHistogram& jitter;
+    int64_t next{0};
+    int64_t last{0};
+    Step produce(int64_t& out, int64_t& wait_ns) {
+        const int64_t now = now_ns();
+        if (next == 0) next = now;
+        if (now >= end_ns) return Step::Done;
+        if (now < next) {
+            if (next - now < wait_ns) wait_ns = next - now;
+            return Step::Idle;
+        }
+        if (last != 0) {
+            const int64_t off = now - last - period_ns;
+            jitter.record(off < 0 ? -off : off);
+        }
+        last = now;
+        next += period_ns;
+        out = now;
+        return Step::Busy;
+    }
+};
+
+struct Pickup {
+    LatencyHistogram& lat;
+    void consume(const int64_t& t) { lat.record(now_ns() - t); }
+};
+
+static void run(bool rt, double seconds, int period_us, int load_threads, int cpu) {
+    static LatencyHistogram jitter, pickup;
+    jitter.clear();
+    pickup.clear();
+    std::atomic<bool> loaded{true};
+    std::thread load[64];
+    for (int i = 0; i < load_threads && i < 64; ++i)
+        load[i] = std::thread([&] {
+            volatile uint64_t x = 0;
+            while (loaded.load(std::memory_order_relaxed)) x = x + 1;
+        });
+
+    Link<int64_t, 256> q;
+    Paced src{period_us * 1000LL, now_ns() + static_cast<int64_t>(seconds * 1e9), jitter};
+    Pickup sink{pickup};
+    Pipeline pipe;
+    pipe.source("paced", src, q, 0);
+    pipe.sink("pickup", q, sink, 1);
+    int lock_err = 0;
+    if (rt) {
+        RtThread r0, r1;
+        r0.cpu = r1.cpu = cpu;
+        r0.priority = 80;
+        r1.priority = 79;
+        pipe.realtime(0, r0);
+        pipe.realtime(1, r1);
+        lock_err = rt_lock_memory();
+    }
+    pipe.start();
+    pipe.join();
+    loaded.store(false, std::memory_order_relaxed);
+    for (int i = 0; i < load_threads && i < 64; ++i) load[i].join();
+    if (rt) (void)::munlockall();
+
+    std::printf("%-8s %6llu samples  jitter p50 %7.1f us  p99 %8.1f us  max %8.1f us  pickup p99 %8.1f us\n",
+                rt ? "rt" : "default", (unsigned long long)jitter.count() + 1, jitter.percentile(50) / 1e3,
+                jitter.percentile(99) / 1e3, jitter.max() / 1e3, pickup.percentile(99) / 1e3);
+    if (rt) {
+        const RtStatus s = pipe.rt_status(0);
+        std::printf("         mlockall %s, SCHED_FIFO %s, pinned %s\n", lock_err == 0 ? "ok" : std::strerror(lock_err),
+                    s.fifo ? "ok" : std::strerror(s.fifo_err),
+                    cpu < 0 ? "off" : (s.pinned ? "ok" : std::strerror(s.pin_err)));
+    }
+}
+
+int main(int argc, char** argv) {
+    const double seconds = argc > 1 ? std::atof(argv[1]) : 2.0;
+    const int period_us = argc > 2 ? std::atoi(argv[2]) : 1000;
+    const int load_threads = argc > 3 ? std::atoi(argv[3]) : rt_cpu_count();
+    const int cpu = argc > 4 ? std::atoi(argv[4]) : -1;
+    std::printf("period %d us, %d load thread(s), %.1f s per run\n", period_us, load_threads, seconds);
+    run(false, seconds, period_us, load_threads, cpu);
+    run(true, seconds, period_us, load_threads, cpu);
+    return 0;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file bench_udp_uadp.cpp
+ * @brief UADP over UDP: messages/s and sender CPU per message, one sendto-equivalent per frame vs sendmmsg batches.
+ *
+ * The sender encodes one 4-field UADP NetworkMessage per sample into a pooled buffer, as the gateway
+ * does, and writes it to a UdpMulticastSink;
+ * a receiver thread drains the socket with recvmmsg() and counts what arrived (UDP may drop when
+ * the receiver falls behind, so received < sent is reported rather than hidden).
+ * CPU per message is the sender thread's CLOCK_THREAD_CPUTIME_ID time divided by messages.
+ * Usage: bench_udp_uadp [messages] [addr]   (default 200000, 127.0.0.1; a 239.x group uses multicast loopback)
+ */
+
+#include "industrial/PayloadPool.hpp"
+#include "industrial/Sinks.hpp"
+#include "industrial/Uadp.hpp"
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <poll.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+using industrial::Frame;
+using industrial::UadpEncoder;
+using industrial::UdpMulticastSink;
+
+static double thread_cpu_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int open_receiver(const char* addr, uint16_t& port) {
+    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    int big = 8 << 20;
+    (void)::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &big, sizeof(big));
+    sockaddr_in a{};
+    a.sin_family = AF_INET;
+    inet_pton(AF_INET, addr, &a.sin_addr);
+    const bool group = IN_MULTICAST(ntohl(a.sin_addr.s_addr));
+    if (group) a.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (::bind(fd, (sockaddr*)&a, sizeof(a)) != 0) return -1;
+    socklen_t len = sizeof(a);
+    ::getsockname(fd, (sockaddr*)&a, &len);
+    port = ntohs(a.sin_port);
+    if (group) {
+        ip_mreq m{};
+        inet_pton(AF_INET, addr, &m.imr_multiaddr);
+        if (::setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &m, sizeof(m)) != 0) return -1;
+    }
+    return fd;
+}
+
+static void run(const char* addr, uint32_t batch, size_t messages) {
+    uint16_t port = 0;
+    int rx = open_receiver(addr, port);
+    if (rx < 0) {
+        std::printf("cannot open receiver on %s\n", addr);
+        return;
+    }
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> received{0};
+    std::thread receiver([&] {
+        constexpr unsigned kVec = 64;
+        static uint8_t bufs[kVec][256];
+        mmsghdr msgs[kVec];
+        iovec iov[kVec];
+        for (;;) {
+            for (unsigned i = 0; i < kVec; ++i) {
+                iov[i] = {bufs[i], sizeof(bufs[i])};
+                msgs[i] = {};
+                msgs[i].msg_hdr.msg_iov = &iov[i];
+                msgs[i].msg_hdr.msg_iovlen = 1;
+            }
+            pollfd p{rx, POLLIN, 0};
+            if (::poll(&p, 1, 100) <= 0) {
+                if (done.load()) break;
+                continue;
+            }
+            int n = ::recvmmsg(rx, msgs, kVec, MSG_DONTWAIT, nullptr);
+            if (n > 0) received.fetch_add((uint64_t)n, std::memory_order_relaxed);
+        }
+    });
+
+    UdpMulticastSink sink;
+    if (!sink.open(addr, port, 1, true)) {
+        std::printf("cannot open sink to %s\n", addr);
+        done = true;
+        receiver.join();
+        ::close(rx);
+        return;
+    }
+    sink.set_batch(batch);
+    UadpEncoder enc;
+    static industrial::PayloadPool<2 * industrial::kUdpBatchDatagrams, industrial::kUdpMaxDatagram> pool;
+    const int64_t ts = UadpEncoder::to_datetime(std::chrono::system_clock::now());
+    const double cpu0 = thread_cpu_ns();
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < messages; ++i) {
+        const float f[4] = {25.0f + (float)(i % 100) * 0.01f, 25.0f, 1400.0f, 1400.0f};
+        const auto h = pool.acquire();
+        if (h == pool.kInvalid) break; // the sink holds at most one batch: cannot happen
+        size_t n = enc.encode(pool.data(h), pool.buffer_size(), f, 4, ts + (int64_t)i * 500000);
+        pool.set_len(h, (uint32_t)n);
+        (void)sink.write(Frame{"", pool.data(h), n, true, false, industrial::PayloadRef(pool, h)});
+        pool.release(h);
+    }
+    sink.idle();
+    auto t1 = std::chrono::steady_clock::now();
+    const double cpu = thread_cpu_ns() - cpu0;
+    done = true;
+    receiver.join();
+    ::close(rx);
+
+    const double secs = std::chrono::duration<double>(t1 - t0).count();
+    std::printf("batch %-3u %12.0f msg/s %8.1f cpu ns/msg  syscalls=%llu errors=%llu received=%llu/%zu\n", batch,
+                (double)messages / secs, cpu / (double)messages, (unsigned long long)sink.send_calls(),
+                (unsigned long long)sink.send_errors(), (unsigned long long)received.load(), messages);
+}
+
+int main(int argc, char** argv) {
+    size_t messages = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    const char* addr = argc > 2 ? argv[2] : "127.0.0.1";
+    std::printf("bench_udp_uadp: %zu UADP messages of %zu bytes to %s\n", messages, UadpEncoder::message_size(4), addr);
+    run(addr, 1, messages);
+    run(addr, 8, messages);
+    run(addr, industrial::kUdpBatchDatagrams, messages);
+    return 0;
+}
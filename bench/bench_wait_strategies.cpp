@@ -0,0 +1,109 @@
+/**
+ * @file bench_wait_strategies.cpp
+ * @brief Consumer wait strategies: pickup latency vs consumer CPU use at a sensor-like rate.
+ *
+ * A producer pushes its steady_clock timestamp into an SpscRing every period_us (default 200 us,
+ * 5 kHz) for the run time; the consumer pops with each strategy and records push-to-pop latency in a
+ * LatencyHistogram. A sample that finds the ring full is refused (try_push) and reported, never
+ * written over one the consumer may be reading. The consumer thread's CPU time over wall time is
+ * its cost: ~100 % for the spinning strategies, a few percent or less for the sleeping ones.
+ * "sleep" is the old fixed sleep_for(5 ms) poll for reference.
+ * Usage: bench_wait_strategies [seconds] [period_us]   (default 1 s per strategy, 200 us)
+ *
+ * Spinning strategies only make sense with a core of their own; on a machine with fewer cores than
+ * busy threads they compete with the producer and their latency gets worse, not better.
+ */
+
+#include "industrial/LatencyHistogram.hpp"
+#include "industrial/SpscRing.hpp"
+#include "industrial/WaitStrategy.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <thread>
+
+using clock_type = std::chrono::steady_clock;
+
+static int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch()).count();
+}
+
+static int64_t thread_cpu_ns() {
+    timespec ts{};
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+template <typename Wait>
+static void run(Wait& wait, double seconds, int period_us) {
+    static industrial::SpscRing<int64_t, 4096, Wait> ring;
+    static industrial::LatencyHistogram lat;
+    lat.clear();
+    ring.clear();
+    ring.set_signal(&wait);
+    std::atomic<bool> done{false};
+    int64_t cpu_ns = 0;
+    uint64_t popped = 0;
+    uint64_t refused = 0;
+
+    std::thread consumer([&] {
+        const int64_t cpu0 = thread_cpu_ns();
+        int64_t t;
+        for (;;) {
+            if (ring.try_pop(t)) {
+                wait.reset();
+                lat.record(now_ns() - t);
+                ++popped;
+                continue;
+            }
+            if (done.load(std::memory_order_acquire) && ring.empty()) break;
+            wait.idle([&] { return !ring.empty() || done.load(std::memory_order_relaxed); }, 10000000);
+        }
+        cpu_ns = thread_cpu_ns() - cpu0;
+    });
+
+    const auto start = clock_type::now();
+    const auto end = start + std::chrono::duration<double>(seconds);
+    auto next = start;
+    while (clock_type::now() < end) {
+        next += std::chrono::microseconds(period_us);
+        std::this_thread::sleep_until(next);
+        if (!ring.try_push(now_ns())) ++refused; // the consumer fell a whole ring behind
+    }
+    done.store(true, std::memory_order_release);
+    wait.ring(); // a parked consumer sees done
+    consumer.join();
+    const double wall_ns = std::chrono::duration<double, std::nano>(clock_type::now() - start).count();
+
+    std::printf("%-10s %8llu msgs  p50 %7.1f us  p99 %8.1f us  max %8.1f us  consumer cpu %5.1f %%  refused %llu\n",
+                Wait::name(), (unsigned long long)popped, lat.percentile(50) / 1e3, lat.percentile(99) / 1e3,
+                lat.max() / 1e3, 100.0 * (double)cpu_ns / wall_ns, (unsigned long long)refused);
+}
+
+int main(int argc, char** argv) {
+    const double seconds = argc > 1 ? std::atof(argv[1]) : 1.0;
+    const int period_us = argc > 2 ? std::atoi(argv[2]) : 200;
+    std::printf("producer period %d us, %.1f s per strategy, %u CPUs\n", period_us, seconds,
+                std::thread::hardware_concurrency());
+
+    static industrial::BusySpin spin;
+    static industrial::SpinYield yield;
+    static industrial::Backoff backoff;
+    static industrial::FutexPark park;
+    static industrial::EventfdWait event;
+    static industrial::SleepPoll sleep;
+    if (!event.open()) {
+        std::printf("eventfd unavailable\n");
+        return 1;
+    }
+    run(spin, seconds, period_us);
+    run(yield, seconds, period_us);
+    run(backoff, seconds, period_us);
+    run(park, seconds, period_us);
+    run(event, seconds, period_us);
+    run(sleep, seconds, period_us);
+    return 0;
+}
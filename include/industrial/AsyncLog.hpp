@@ -0,0 +1,191 @@
+/**
+ * @file industrial/AsyncLog.hpp
+ * @brief Asynchronous binary logger: the calling thread copies a format id and raw arguments, a
+ *        background thread formats and writes them in large batches.
+ *
+ * A call site is a static LogFormat (level + printf-style format); its address is the format id.
+ * log(fmt, args...) checks the level, stores the id, a sequence number and up to kLogMaxArgs raw
+ * arguments (integers, floating point, C strings) into the calling thread's own SpscRing and returns:
+ * no formatting, no locks, no syscalls. The writer thread started with start() merges the per-thread
+ * rings in sequence order, formats each record (one line, '\n' appended) into a kLogBatchBytes buffer
+ * and hands full buffers (or whatever is pending when it goes idle) to fwrite() in one call.
+ *
+ *   static const LogFormat kSample{LogLevel::Debug, "consumer: T=%g C (avg=%g)"};
+ *   log.log(kSample, t, avg);
+ *
+ * @note:
+ * - Never blocks the caller: a full ring, or more than kLogMaxThreads logging threads, drops the
+ *   record and counts it in dropped(). A thread keeps its ring for the logger it used last, so each
+ *   thread should log to one logger (one per process is the intended use).
+ * - C string arguments are stored by pointer: pass literals or strings that live until flush().
+ * - Conversions d i u o x X c e E f F g G a A s p with flags, width and precision; length modifiers
+ *   are accepted and ignored (arguments are stored as 64-bit values). '*' widths are not supported.
+ * - No heap, no exceptions. The record rings are large (see Config.hpp); keep the logger static.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <type_traits>
+
+#include "industrial/Config.hpp"
+#include "industrial/SpscRing.hpp"
+
+namespace industrial {
+
+enum class LogLevel : uint8_t { Error = 0, Warn, Info, Debug };
+
+// One log call site; its address identifies the format in queued records.
+struct LogFormat {
+    LogLevel level;
+    const char* fmt;
+};
+
+class AsyncLog {
+public:
+    enum class ArgKind : uint8_t { Int, Uint, Double, Str };
+
+    union ArgValue {
+        int64_t i;
+        uint64_t u;
+        double d;
+        const char* s;
+    };
+
+    // What the calling thread queues: format id, global order and the raw arguments.
+    struct Record {
+        const LogFormat* format;
+        uint64_t seq;
+        uint8_t nargs;
+        ArgKind kinds[kLogMaxArgs];
+        ArgValue args[kLogMaxArgs];
+    };
+
+    AsyncLog();
+    ~AsyncLog();
+    AsyncLog(const AsyncLog&) = delete;
+    AsyncLog& operator=(const AsyncLog&) = delete;
+
+    // Writer thread appending to out (e.g. stdout); false if already running.
+    bool start(std::FILE* out);
+    // Writes everything queued so far, then joins the writer thread.
+    void stop();
+    // Returns once every record queued before the call is written. Without a writer thread the
+    // calling thread formats them itself (only while no other thread logs).
+    void flush();
+
+    void set_level(LogLevel l) { level_.store(static_cast<uint8_t>(l), std::memory_order_relaxed); }
+    LogLevel level() const { return static_cast<LogLevel>(level_.load(std::memory_order_relaxed)); }
+    bool enabled(LogLevel l) const {
+        return static_cast<uint8_t>(l) <= level_.load(std::memory_order_relaxed);
+    }
+    // "error", "warn", "info" or "debug"; false (and no change) otherwise.
+    bool set_level(const char* name);
+
+    // Hot path: copy the call into this thread's ring. Never formats, never waits.
+    template <typename... Args>
+    void log(const LogFormat& f, const Args&... args) {
+        if (!enabled(f.level)) return;
+        Channel* ch = channel();
+        Record r;
+        capture(r, f, args...);
+        r.seq = seq_.fetch_add(1, std::memory_order_relaxed);
+        if (ch == nullptr || !ch->ring.try_push(r)) dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Fills r with the format id and raw arguments of a call (what log() queues, minus the sequence).
+    template <typename... Args>
+    static void capture(Record& r, const LogFormat& f, const Args&... args) {
+        static_assert(sizeof...(Args) <= kLogMaxArgs, "too many log arguments");
+        r.format = &f;
+        r.seq = 0;
+        r.nargs = static_cast<uint8_t>(sizeof...(Args));
+        uint32_t i = 0;
+        (void)i;
+        ((set_arg(r, i++, args)), ...);
+    }
+
+    // Formats one record as a line ('\n' included, truncated to fit); returns the bytes written.
+    static size_t format(const Record& r, char* out, size_t cap);
+
+    uint64_t logged() const { return seq_.load(std::memory_order_relaxed); }       // records queued or dropped
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }  // ring full or no ring
+    uint64_t written() const { return written_.load(std::memory_order_relaxed); }  // records formatted
+    uint64_t batches() const { return batches_.load(std::memory_order_relaxed); }  // fwrite() calls
+    uint64_t bytes() const { return bytes_.load(std::memory_order_relaxed); }      // bytes written
+
+private:
+    struct Channel {
+        SpscRing<Record, kLogRingRecords> ring;
+    };
+
+    // This thread's ring, claimed on its first call; nullptr once all kLogMaxThreads are taken.
+    Channel* channel() {
+        struct Slot {
+            uint64_t owner;
+            Channel* ch;
+        };
+        thread_local Slot slot{0, nullptr};
+        if (slot.owner != id_) {
+            const uint32_t i = claimed_.fetch_add(1, std::memory_order_acq_rel);
+            slot.owner = id_;
+            slot.ch = i < kLogMaxThreads ? &channels_[i] : nullptr;
+        }
+        return slot.ch;
+    }
+
+    template <typename T>
+    static void set_arg(Record& r, uint32_t i, const T& v) {
+        if constexpr (std::is_same_v<T, bool>) {
+            r.kinds[i] = ArgKind::Int;
+            r.args[i].i = v ? 1 : 0;
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            r.kinds[i] = ArgKind::Int;
+            r.args[i].i = static_cast<int64_t>(v);
+        } else if constexpr (std::is_integral_v<T>) {
+            r.kinds[i] = ArgKind::Uint;
+            r.args[i].u = static_cast<uint64_t>(v);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            r.kinds[i] = ArgKind::Double;
+            r.args[i].d = static_cast<double>(v);
+        } else if constexpr (std::is_enum_v<T>) {
+            r.kinds[i] = ArgKind::Int;
+            r.args[i].i = static_cast<int64_t>(v);
+        } else {
+            static_assert(std::is_convertible_v<T, const char*>, "log arguments: integers, floats or C strings");
+            r.kinds[i] = ArgKind::Str;
+            r.args[i].s = v;
+        }
+    }
+
+    size_t drain(); // merge the rings in sequence order and write; writer side only
+    void emit(const Record& r);
+    void write_out();
+    void writer_loop();
+
+    const uint64_t id_;
+    std::atomic<uint8_t> level_{static_cast<uint8_t>(LogLevel::Debug)};
+    std::atomic<uint64_t> seq_{0};
+    std::atomic<uint32_t> claimed_{0};
+    Channel channels_[kLogMaxThreads];
+
+    // writer-owned: one record of look-ahead per ring for the merge, and the output batch
+    Record head_[kLogMaxThreads]{};
+    bool have_[kLogMaxThreads]{};
+    char buf_[kLogBatchBytes];
+    size_t len_{0};
+    std::FILE* out_{nullptr};
+
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> bytes_{0};
+    std::atomic<uint64_t> passes_{0};
+    std::atomic<bool> running_{false};
+    std::thread writer_;
+};
+
+} // namespace industrial
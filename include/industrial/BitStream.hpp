@@ -0,0 +1,119 @@
+/**
+ * @file industrial/BitStream.hpp
+ * @brief MSB-first bit writer/reader over caller-provided byte buffers.
+ *
+ * @note:
+ * - No heap, no exceptions. The writer latches an overflow flag instead of failing loudly;
+ *   callers check ok() once at the end of a block rather than per write.
+ * - Both sides keep a 64-bit accumulator so the common case is a shift/or per field and a
+ *   byte store only when 8 bits are complete (writer) or a byte load per refill (reader).
+ * - Field widths are 1..64 bits. Not thread-safe.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace industrial {
+
+class BitWriter {
+public:
+    BitWriter(uint8_t* buf, size_t cap) : buf_{buf}, cap_{cap} {}
+
+    // Append the low n bits of v (1 <= n <= 64), most significant bit first.
+    void write(uint64_t v, unsigned n) {
+        if (n > 32u) {
+            write32(static_cast<uint32_t>(v >> 32), n - 32u);
+            n = 32u;
+        }
+        write32(static_cast<uint32_t>(v), n);
+    }
+
+    void write_bit(bool b) { write32(b ? 1u : 0u, 1u); }
+
+    // Pad the final partial byte with zeros. Further writes are not expected afterwards.
+    void flush() {
+        if (nbits_ > 0u) {
+            put_byte(static_cast<uint8_t>(acc_ << (8u - nbits_)));
+            acc_ = 0;
+            nbits_ = 0;
+        }
+    }
+
+    bool ok() const { return !overflow_; }
+    size_t bytes() const { return pos_; }             // complete bytes emitted so far
+    size_t bits() const { return pos_ * 8u + nbits_; } // bits written including pending
+
+private:
+    void write32(uint32_t v, unsigned n) {
+        if (n < 32u) v &= (1u << n) - 1u;
+        acc_ = (acc_ << n) | v;
+        nbits_ += n;
+        while (nbits_ >= 8u) {
+            nbits_ -= 8u;
+            put_byte(static_cast<uint8_t>(acc_ >> nbits_));
+        }
+    }
+
+    void put_byte(uint8_t b) {
+        if (pos_ < cap_) buf_[pos_++] = b;
+        else overflow_ = true;
+    }
+
+    uint8_t* buf_;
+    size_t cap_;
+    size_t pos_{0};
+    uint64_t acc_{0};   // pending bits live in the low nbits_ positions
+    unsigned nbits_{0}; // always < 8 between calls
+    bool overflow_{false};
+};
+
+class BitReader {
+public:
+    BitReader(const uint8_t* buf, size_t len) : buf_{buf}, len_{len} {}
+
+    // Read n bits (1 <= n <= 64), most significant bit first. Reads past the end yield zeros
+    // and latch the underrun flag.
+    uint64_t read(unsigned n) {
+        if (n > 32u) {
+            uint64_t hi = read32(n - 32u);
+            return (hi << 32) | read32(32u);
+        }
+        return read32(n);
+    }
+
+    bool read_bit() { return read32(1u) != 0u; }
+
+    // Count leading 1 bits up to max (consuming them and the terminating 0 if seen).
+    // Used for unary-prefixed control codes.
+    unsigned read_unary(unsigned max) {
+        unsigned n = 0;
+        while (n < max && read_bit()) ++n;
+        return n;
+    }
+
+    bool ok() const { return !underrun_; }
+
+private:
+    uint32_t read32(unsigned n) {
+        while (nbits_ < n) {
+            uint8_t b = 0;
+            if (pos_ < len_) b = buf_[pos_++];
+            else underrun_ = true;
+            acc_ = (acc_ << 8) | b;
+            nbits_ += 8u;
+        }
+        nbits_ -= n;
+        uint64_t v = acc_ >> nbits_;
+        return n == 32u ? static_cast<uint32_t>(v) : static_cast<uint32_t>(v & ((1u << n) - 1u));
+    }
+
+    const uint8_t* buf_;
+    size_t len_;
+    size_t pos_{0};
+    uint64_t acc_{0};
+    unsigned nbits_{0};
+    bool underrun_{false};
+};
+
+} // namespace industrial
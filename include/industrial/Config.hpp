@@ -6,5 +6,81 @@ namespace industrial {
 // Centralized capacities to avoid magic numbers and multiple template instantiations
 constexpr std::uint32_t kRingCapacity   = 256;
 constexpr std::uint32_t kMaxAvgWindow   = 256;
+constexpr std::uint32_t kGorillaBlockSamples = 32; // samples per compressed MQTT/storage block
+
+// Store-and-forward spool: hot-path queue depth and per-entry limits (payload fits a full Gorilla block)
+constexpr std::uint32_t kSpoolQueueCapacity = 64;
+constexpr std::uint32_t kSpoolMaxTopic      = 96;
+constexpr std::uint32_t kSpoolMaxPayload    = 640;
+constexpr std::uint32_t kSpoolSegmentBytes  = 1u << 20; // preallocated size of each segment file
+constexpr std::uint32_t kSpoolSegments      = 8;
+constexpr std::uint32_t kSpoolDrainBurst    = 16;       // max spooled records replayed per idle pass
+
+// Output fan-out: shared encoded-payload buffers and per-sink handle queues
+constexpr std::uint32_t kPayloadPoolSlots   = 512;
+constexpr std::uint32_t kPayloadSlotBytes   = kSpoolMaxPayload;
+constexpr std::uint32_t kSinkQueueCapacity  = 256;
+constexpr std::uint32_t kConflateMaxTopics  = 1024; // distinct latest-value topics per sink (Lane::Latest)
+constexpr std::uint32_t kPriorityQueueCapacity = 32; // alarms/events per sink (Lane::Priority)
+
+// Native MQTT client: transmit batch arena, iovecs per vectored write, QoS 1 window, blocking I/O cap
+constexpr std::uint32_t kMqttTxArenaBytes   = 64u * 1024u;
+constexpr std::uint32_t kMqttMaxIov         = 128;
+constexpr std::uint32_t kMqttMaxInflight    = 64;
+constexpr int           kMqttIoTimeoutMs    = 5000;
+constexpr std::uint32_t kMqttBacklogFrames  = 64;   // frames MqttSink holds while disconnected without a spool
+
+// Sharded publisher pool: connections per process and per-connection handle queue depth
+constexpr std::uint32_t kMqttPoolMaxConnections = 16;
+constexpr std::uint32_t kMqttShardQueueCapacity = 256;
+
+// Preformatted per-sensor/per-channel topics (e.g. 1024 sensors x 4 channels of ~40 chars)
+constexpr std::uint32_t kTopicArenaBytes     = 256u * 1024u;
+constexpr std::uint32_t kTopicArenaMaxTopics = 8192;
+// Fixed topics of the gateway itself (readings, /gorilla, /alarm, Sparkplug births and data), rendered once
+constexpr std::uint32_t kAppTopicBytes       = 2048;
+
+// Sparkplug B: samples per DDATA message (4 float metrics each; must fit kPayloadSlotBytes)
+constexpr std::uint32_t kSparkplugBatchSamples = 8;
+
+// UDP output (OPC UA UADP): datagrams per sendmmsg() batch, largest payload (Ethernet MTU - IP/UDP headers)
+constexpr std::uint32_t kUdpBatchDatagrams = 32;
+constexpr std::uint32_t kUdpMaxDatagram    = 1472;
+
+// Local subscription server (Unix domain socket): clients, filter trie size, largest record on the socket
+constexpr std::uint32_t kLocalSubMaxClients  = 32;
+constexpr std::uint32_t kTopicTrieMaxNodes   = 512;
+constexpr std::uint32_t kTopicTrieLabelBytes = 8192;
+constexpr std::uint32_t kLocalSubMaxRecord   = 4096;
+
+// InfluxDB line-protocol sink: batch buffer, default size/age flush thresholds, socket timeouts and retry delay
+constexpr std::uint32_t kInfluxBatchBytes   = 256u * 1024u;
+constexpr std::uint32_t kInfluxFlushBytes   = 64u * 1024u;
+constexpr int           kInfluxFlushMs      = 1000;
+constexpr int           kInfluxIoTimeoutMs  = 5000;
+constexpr int           kInfluxRetryMs      = 1000;
+
+// Modbus TCP server: concurrent clients, registers per table, snapshot channels, largest ADU (MBAP + PDU)
+constexpr std::uint32_t kModbusMaxClients = 256;
+constexpr std::uint32_t kModbusRegisters  = 256;
+constexpr std::uint32_t kModbusChannels   = 16;
+constexpr std::uint32_t kModbusMaxAdu     = 260;
+
+// Async logger: logging threads, records queued per thread, arguments per call, writer batch, longest line
+constexpr std::uint32_t kLogMaxThreads  = 8;
+constexpr std::uint32_t kLogRingRecords = 512;
+constexpr std::uint32_t kLogMaxArgs     = 8;
+constexpr std::uint32_t kLogBatchBytes  = 64u * 1024u;
+constexpr std::uint32_t kLogMaxLine     = 512;
+
+// Stage pipeline: stages, threads, items per stage turn, longest idle wait, retry delay on a full output
+constexpr std::uint32_t kPipelineMaxStages  = 16;
+constexpr std::uint32_t kPipelineMaxThreads = 8;
+constexpr std::uint32_t kPipelineBatch      = 32;
+constexpr std::int64_t  kPipelineMaxIdleNs  = 100000000; // 100 ms
+constexpr std::int64_t  kPipelineBlockedNs  = 100000;    // 100 us
+
+// Real-time mode: stack each real-time thread touches at start, so it never page-faults on it later
+constexpr std::uint32_t kRtStackPrefaultBytes = 256u * 1024u;
 
 } // namespace industrial
@@ -0,0 +1,120 @@
+/**
+ * @file industrial/ConflatingQueue.hpp
+ * @brief Single-producer/single-consumer latest-value queue: at most one pending entry per topic.
+ *
+ * @tparam Handle     Payload handle type (e.g. PayloadPool::Handle; must fit in 32 bits).
+ * @tparam MAX_TOPICS Distinct topics the queue can hold (memory is bounded by this, not by the rate).
+ *
+ * push() publishes the newest handle for a topic. If that topic already has a handle waiting, the
+ * old one is displaced (conflated) and handed back to the caller to release; the topic keeps its
+ * place in line. Topics wait in a FIFO of slot indices, each at most once, so pop() drains them
+ * round-robin in order of first arrival: a chatty topic cannot starve a quiet one, and whatever is
+ * popped is the freshest value of its topic at that moment.
+ *
+ * @note:
+ * - Topics are identified by pointer and length (long-lived topic strings, as with SinkFanOut); the
+ *   topic table is producer-private and fills up on first use, push() returns Full after that.
+ * - Lock-free: each topic slot holds its pending handle in one atomic word, exchanged by the producer
+ *   and cleared by the consumer; the index FIFO is an SpscRing sized so it can never overflow.
+ * - No heap, no exceptions. Exactly one producer thread and one consumer thread.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "industrial/SpscRing.hpp"
+
+namespace industrial {
+
+template <typename Handle, uint32_t MAX_TOPICS>
+class ConflatingQueue {
+public:
+    static_assert(MAX_TOPICS >= 2 && MAX_TOPICS <= 0xFFFFu, "MAX_TOPICS out of range");
+    static_assert(sizeof(Handle) <= sizeof(uint32_t), "Handle must fit in 32 bits");
+
+    enum class Push : uint8_t { Queued, Conflated, Full };
+
+    struct Entry {
+        Handle handle;
+        std::string_view topic;
+        bool binary;
+    };
+
+    ConflatingQueue() {
+        for (auto& s : index_) s = kNoSlot;
+    }
+    ConflatingQueue(const ConflatingQueue&) = delete;
+    ConflatingQueue& operator=(const ConflatingQueue&) = delete;
+
+    // Producer. On Conflated, displaced receives the older handle, which the caller now owns.
+    Push push(std::string_view topic, Handle h, bool binary, Handle& displaced) {
+        const uint32_t slot = find_or_add(topic);
+        if (slot == kNoSlot) return Push::Full;
+        const uint64_t word = kPending | (binary ? kBinary : 0u) | static_cast<uint32_t>(h);
+        const uint64_t old = slots_[slot].pending.exchange(word, std::memory_order_acq_rel);
+        if (old != 0) {
+            displaced = static_cast<Handle>(static_cast<uint32_t>(old));
+            conflated_.fetch_add(1, std::memory_order_relaxed);
+            return Push::Conflated;
+        }
+        (void)ready_.try_push(static_cast<uint16_t>(slot)); // a slot is queued at most once: never full
+        return Push::Queued;
+    }
+
+    // Consumer. The freshest handle of the next topic in line.
+    bool pop(Entry& out) {
+        uint16_t slot;
+        if (!ready_.try_pop(slot)) return false;
+        Slot& s = slots_[slot];
+        const uint64_t word = s.pending.exchange(0, std::memory_order_acq_rel);
+        out.handle = static_cast<Handle>(static_cast<uint32_t>(word));
+        out.topic = std::string_view(s.topic, s.topic_len);
+        out.binary = (word & kBinary) != 0;
+        return true;
+    }
+
+    uint32_t pending() const { return ready_.size(); }
+    uint32_t topics() const { return topics_.load(std::memory_order_relaxed); }
+    uint64_t conflated() const { return conflated_.load(std::memory_order_relaxed); }
+    static constexpr uint32_t capacity() { return MAX_TOPICS; }
+
+private:
+    static constexpr uint32_t kNoSlot = 0xFFFFFFFFu;
+    static constexpr uint32_t kIndexSize = 2 * MAX_TOPICS; // open addressing, load factor <= 0.5
+    static constexpr uint64_t kPending = 1ull << 63;
+    static constexpr uint64_t kBinary = 1ull << 32;
+
+    struct Slot {
+        std::atomic<uint64_t> pending{0}; // 0: nothing waiting; else kPending | binary | handle
+        const char* topic{nullptr};       // written once by the producer before the slot is first queued
+        uint32_t topic_len{0};
+    };
+
+    uint32_t find_or_add(std::string_view topic) {
+        uint32_t i = static_cast<uint32_t>((reinterpret_cast<uintptr_t>(topic.data()) >> 3) * 2654435761u) % kIndexSize;
+        for (;;) {
+            const uint32_t slot = index_[i];
+            if (slot == kNoSlot) break;
+            if (slots_[slot].topic == topic.data() && slots_[slot].topic_len == topic.size()) return slot;
+            i = (i + 1) % kIndexSize;
+        }
+        const uint32_t n = topics_.load(std::memory_order_relaxed);
+        if (n == MAX_TOPICS) return kNoSlot;
+        slots_[n].topic = topic.data();
+        slots_[n].topic_len = static_cast<uint32_t>(topic.size());
+        index_[i] = n;
+        topics_.store(n + 1, std::memory_order_relaxed);
+        return n;
+    }
+
+    Slot slots_[MAX_TOPICS];
+    uint32_t index_[kIndexSize]; // producer-only: hash of topic pointer -> slot
+    SpscRing<uint16_t, MAX_TOPICS> ready_;
+    std::atomic<uint32_t> topics_{0};
+    std::atomic<uint64_t> conflated_{0};
+};
+
+} // namespace industrial
@@ -0,0 +1,90 @@
+/**
+ * @file industrial/Deadband.hpp
+ * @brief Report-by-exception filter: pass a sample only when a channel moved beyond its deadband
+ *        or the maximum silence interval expired.
+ *
+ * @tparam CHANNELS Number of float channels evaluated together (one message carries all of them).
+ *
+ * Per channel, a change counts when |v - last_reported| exceeds the absolute deadband or the
+ * percentage deadband of |last_reported| (either limit may be 0 = not used; if both are 0 any
+ * difference counts). The first sample always passes; with a max silence set, a sample also passes
+ * once that much time went by since the last reported one (heartbeat), so consumers can tell a
+ * steady value from a dead producer.
+ *
+ * @note:
+ * - Reported values are only updated when a sample passes, so slow drifts accumulate until they
+ *   cross the deadband instead of being lost step by step.
+ * - No heap, no exceptions; not thread-safe. Counters are plain and meant to be read after the
+ *   owning thread stopped (or tolerated as approximate).
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "industrial/SensorSample.hpp"
+
+namespace industrial {
+
+template <uint32_t CHANNELS>
+class DeadbandFilter {
+public:
+    static_assert(CHANNELS >= 1, "CHANNELS must be >= 1");
+
+    DeadbandFilter() = default;
+
+    // abs in channel units, pct in percent of the last reported value; negatives clamp to 0.
+    void set_channel(uint32_t ch, float abs, float pct) {
+        if (ch >= CHANNELS) return;
+        abs_[ch] = abs > 0.0f ? abs : 0.0f;
+        pct_[ch] = pct > 0.0f ? pct / 100.0f : 0.0f;
+    }
+
+    // Zero disables the heartbeat.
+    void set_max_silence(std::chrono::milliseconds d) { max_silence_ = d; }
+
+    // Returns true if the sample should be published (and records it as reported).
+    bool update(const float (&v)[CHANNELS], TimePoint now) {
+        bool pass = !primed_;
+        for (uint32_t i = 0; i < CHANNELS && !pass; ++i) pass = exceeds(i, v[i]);
+        if (!pass && max_silence_.count() > 0 && now - last_ts_ >= max_silence_) {
+            pass = true;
+            ++heartbeats_;
+        }
+        if (!pass) {
+            ++suppressed_;
+            return false;
+        }
+        for (uint32_t i = 0; i < CHANNELS; ++i) last_[i] = v[i];
+        last_ts_ = now;
+        primed_ = true;
+        ++passed_;
+        return true;
+    }
+
+    void reset() { primed_ = false; }
+
+    uint64_t passed() const { return passed_; }         // includes heartbeats
+    uint64_t suppressed() const { return suppressed_; }
+    uint64_t heartbeats() const { return heartbeats_; }
+
+private:
+    bool exceeds(uint32_t i, float x) const {
+        const float d = x > last_[i] ? x - last_[i] : last_[i] - x;
+        const float ref = last_[i] < 0.0f ? -last_[i] : last_[i];
+        if (abs_[i] == 0.0f && pct_[i] == 0.0f) return d > 0.0f;
+        return (abs_[i] > 0.0f && d > abs_[i]) || (pct_[i] > 0.0f && d > pct_[i] * ref);
+    }
+
+    float abs_[CHANNELS]{};
+    float pct_[CHANNELS]{}; // stored as a fraction
+    float last_[CHANNELS]{};
+    TimePoint last_ts_{};
+    std::chrono::milliseconds max_silence_{0};
+    bool primed_{false};
+    uint64_t passed_{0};
+    uint64_t suppressed_{0};
+    uint64_t heartbeats_{0};
+};
+
+} // namespace industrial
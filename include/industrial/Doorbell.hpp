@@ -0,0 +1,99 @@
+/**
+ * @file industrial/Doorbell.hpp
+ * @brief eventfd wake-up for a queue consumer that blocks in poll/epoll, signalled only while it sleeps.
+ *
+ * The consumer arm()s the doorbell when it finds its queue empty, checks the queue once more and,
+ * if it is still empty, blocks on fd() (alone via wait(), or in its own epoll set next to sockets and
+ * timerfds). The producer calls ring() after publishing an item: while the consumer is awake that is
+ * one atomic load and nothing else; only the first ring() after arm() writes the eventfd. So a busy
+ * consumer costs the producer no syscalls, and an idle one costs no CPU at all.
+ *
+ * Lost wake-ups are ruled out by the Dekker pattern: arm() stores and then loads the queue, ring()
+ * publishes the item and then loads the flag, each pair separated by a seq_cst fence, so at least one
+ * side sees the other.
+ *
+ * @note:
+ * - One producer thread and one consumer thread; SpscRing<T, N, Doorbell> rings it from push().
+ * - Linux eventfd; no heap, no exceptions. open() returns false if the eventfd cannot be created.
+ */
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace industrial {
+
+class Doorbell {
+public:
+    Doorbell() = default;
+    ~Doorbell() { close(); }
+    Doorbell(const Doorbell&) = delete;
+    Doorbell& operator=(const Doorbell&) = delete;
+
+    bool open() {
+        if (fd_ >= 0) return true;
+        fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        return fd_ >= 0;
+    }
+    void close() {
+        if (fd_ >= 0) ::close(fd_);
+        fd_ = -1;
+    }
+    bool is_open() const { return fd_ >= 0; }
+    int fd() const { return fd_; } // readable while signalled; register with EPOLLIN
+
+    // Producer, after making an item visible.
+    void ring() {
+        std::atomic_thread_fence(std::memory_order_seq_cst); // item store before the flag load
+        if (!armed_.load(std::memory_order_relaxed)) return;  // consumer awake: suppressed
+        if (!armed_.exchange(false, std::memory_order_relaxed)) return;
+        const uint64_t one = 1;
+        while (::write(fd_, &one, sizeof(one)) < 0 && errno == EINTR) {
+        }
+        signals_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Consumer, before sleeping: after arm() re-check the queue, then block on fd() only if it is empty.
+    void arm() {
+        armed_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst); // flag store before the queue load
+    }
+
+    // Consumer, after waking or after finding work instead of sleeping. Clears a signal that was sent
+    // (a signal racing this call can leave one spurious wake-up behind, which is harmless).
+    void disarm() {
+        if (armed_.exchange(false, std::memory_order_relaxed)) return; // nobody rang
+        drain();
+    }
+
+    // Consumer: arm() first. Blocks on fd() alone for up to timeout_ms (-1: forever); true if signalled.
+    bool wait(int timeout_ms) {
+        pollfd p{fd_, POLLIN, 0};
+        int rc;
+        while ((rc = ::poll(&p, 1, timeout_ms)) < 0 && errno == EINTR) {
+        }
+        armed_.store(false, std::memory_order_relaxed);
+        if (rc > 0) drain(); // also clears a leftover from an earlier race
+        return rc > 0;
+    }
+
+    uint64_t signals() const { return signals_.load(std::memory_order_relaxed); } // eventfd writes
+
+private:
+    void drain() {
+        uint64_t n;
+        while (::read(fd_, &n, sizeof(n)) < 0 && errno == EINTR) {
+        }
+    }
+
+    int fd_{-1};
+    std::atomic<bool> armed_{false};
+    std::atomic<uint64_t> signals_{0};
+};
+
+} // namespace industrial
@@ -0,0 +1,115 @@
+/**
+ * @file industrial/GorillaCodec.hpp
+ * @brief Gorilla-style block codec for SensorSample streams (delta-of-delta timestamps, XOR floats).
+ *
+ * Block layout (all multi-byte header fields little-endian):
+ *   [u8 version][u16 sample count][bitstream...]
+ * Bitstream, MSB-first:
+ *   sample 0 : ts as 64 raw bits (steady_clock ns), temperature and pressure as 32 raw bits each
+ *   sample i : ts delta-of-delta code, temperature XOR code, pressure XOR code
+ *
+ * Timestamp delta-of-delta (ns), the first delta is coded against 0:
+ *   '0'                  dod == 0
+ *   '10'   + 12 bits     dod in [-2^11, 2^11)
+ *   '110'  + 20 bits     dod in [-2^19, 2^19)
+ *   '1110' + 32 bits     dod in [-2^31, 2^31)
+ *   '1111' + 64 bits     anything else
+ * Float XOR with previous value of the same channel:
+ *   '0'                  identical bits
+ *   '10'  + m bits       meaningful bits fit inside the previous leading/trailing-zero window
+ *   '11'  + 5 bits leading zeros + 5 bits (length - 1) + length bits
+ *
+ * @note:
+ * - Lossless: timestamps keep full nanosecond resolution, floats round-trip bit-exactly.
+ * - Output goes into a caller-provided buffer; no heap, no exceptions. Use max_block_bytes()
+ *   to size it. The same block bytes are meant for MQTT payloads and on-disk records alike.
+ * - Not thread-safe; one encoder/decoder per stream.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "industrial/BitStream.hpp"
+#include "industrial/SensorSample.hpp"
+
+namespace industrial {
+
+constexpr uint8_t kGorillaVersion = 1;
+constexpr size_t kGorillaHeaderBytes = 3;
+
+// Worst case: 68-bit timestamp code plus two 44-bit float codes per sample.
+constexpr size_t max_block_bytes(size_t samples) {
+    return kGorillaHeaderBytes + (samples * (68u + 44u + 44u) + 7u) / 8u;
+}
+
+class GorillaEncoder {
+public:
+    GorillaEncoder(uint8_t* buf, size_t cap);
+
+    // Append one sample; returns false once the buffer or the u16 count is exhausted.
+    bool append(const SensorSample& s);
+
+    // Pad the bitstream, patch the header; returns the block size in bytes or 0 on overflow.
+    size_t finish();
+
+    uint16_t count() const { return count_; }
+
+    // Start a new block in the same buffer.
+    void reset() { *this = GorillaEncoder(buf_, cap_); }
+
+private:
+    struct FloatState {
+        uint32_t prev{0};
+        unsigned lead{0xFFu}; // 0xFF: no window yet
+        unsigned trail{0};
+    };
+
+    void put_ts(int64_t ts);
+    void put_float(FloatState& st, float v);
+
+    uint8_t* buf_;
+    size_t cap_;
+    BitWriter bw_;
+    uint16_t count_{0};
+    int64_t prev_ts_{0};
+    int64_t prev_delta_{0};
+    FloatState temp_{};
+    FloatState press_{};
+};
+
+class GorillaDecoder {
+public:
+    GorillaDecoder(const uint8_t* buf, size_t len);
+
+    // False if the header is missing or of an unknown version.
+    bool valid() const { return valid_; }
+    uint16_t count() const { return count_; }
+
+    // Decode the next sample; false when the block is exhausted or truncated.
+    bool next(SensorSample& out);
+
+private:
+    struct FloatState {
+        uint32_t prev{0};
+        unsigned lead{0};
+        unsigned len{0};
+    };
+
+    float get_float(FloatState& st);
+
+    BitReader br_;
+    bool valid_{false};
+    uint16_t count_{0};
+    uint16_t index_{0};
+    int64_t prev_ts_{0};
+    int64_t prev_delta_{0};
+    FloatState temp_{};
+    FloatState press_{};
+};
+
+// Convenience wrappers for whole blocks. Return bytes written / samples decoded (0 on error).
+size_t gorilla_encode(const SensorSample* samples, size_t n, uint8_t* out, size_t cap);
+size_t gorilla_decode(const uint8_t* in, size_t len, SensorSample* out, size_t max);
+
+} // namespace industrial
@@ -0,0 +1,107 @@
+/**
+ * @file industrial/InfluxSink.hpp
+ * @brief Batches InfluxDB line-protocol payloads and writes them over one persistent TCP or HTTP connection.
+ *
+ * Frames are complete line-protocol lines (see industrial/LineProtocol.hpp). write() appends them
+ * to one kInfluxBatchBytes buffer that is reused for the life of the sink; the batch goes out when
+ * it reaches the size threshold, or from idle() once its oldest line is older than the age threshold.
+ *
+ * Transports, chosen by URL:
+ *   tcp://host:port                       raw line protocol over a stream (Telegraf socket_listener,
+ *                                         QuestDB ILP and similar); no acknowledgement
+ *   http://host:port/path?query           one keep-alive "POST path?query" per batch, e.g.
+ *                                         /write?db=plant (1.x) or /api/v2/write?bucket=b&org=o&precision=ns;
+ *                                         a 2xx status accepts the batch
+ *
+ * Failure handling: a failed send closes the connection and keeps the batch; the next attempt waits
+ * kInfluxRetryMs. An HTTP 4xx means the server rejected the data, so the batch is dropped rather
+ * than retried forever. When the buffer is full and still cannot be sent, the oldest batch is
+ * dropped to make room. Everything dropped is counted in dropped_lines().
+ *
+ * @note:
+ * - No exceptions; no heap after open(). Sends block the sink thread for at most the I/O timeout.
+ * - Not thread-safe; driven by one SinkFanOut worker.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "industrial/Config.hpp"
+#include "industrial/Sinks.hpp"
+
+namespace industrial {
+
+class InfluxSink {
+public:
+    using clock = std::chrono::steady_clock;
+
+    InfluxSink() = default;
+    ~InfluxSink();
+    InfluxSink(const InfluxSink&) = delete;
+    InfluxSink& operator=(const InfluxSink&) = delete;
+
+    // Parse the URL and connect; false for a bad URL. A server that is down is retried on flush.
+    bool open(const std::string& url);
+    void close(); // flush what is buffered (dropped if that fails), then disconnect
+    bool is_open() const { return configured_; }
+    bool connected() const { return fd_ >= 0; }
+
+    // Flush once bytes are buffered or the oldest line is max_age old (bytes capped at the buffer size).
+    void set_flush(size_t bytes, std::chrono::milliseconds max_age);
+    void set_io_timeout(int ms) { io_timeout_ms_ = ms; }
+
+    bool write(const Frame& f);
+    void idle();
+    bool flush();
+    static const char* name() { return "influx"; }
+
+    size_t buffered_bytes() const { return used_; }
+    uint64_t lines() const { return lines_; }          // lines delivered
+    uint64_t batches() const { return batches_; }
+    uint64_t bytes_sent() const { return bytes_sent_; }
+    uint64_t dropped_lines() const { return dropped_lines_; }
+    uint64_t send_failures() const { return send_failures_; }
+    uint64_t connects() const { return connects_; }
+    int last_status() const { return last_status_; } // HTTP status of the last batch, 0 for tcp
+
+private:
+    enum class Outcome { Sent, Retry, Rejected };
+
+    bool connect_now();
+    void disconnect();
+    Outcome send_batch();
+    bool send_all(const void* hdr, size_t hdr_len, const void* body, size_t body_len);
+    int read_http_status(); // -1 on I/O error
+    void drop_batch();
+
+    std::string host_;
+    std::string target_; // HTTP request target, empty for tcp
+    uint16_t port_{0};
+    bool http_{false};
+    bool configured_{false};
+    int fd_{-1};
+    int io_timeout_ms_{kInfluxIoTimeoutMs};
+    size_t flush_bytes_{kInfluxFlushBytes};
+    clock::duration max_age_{std::chrono::milliseconds(kInfluxFlushMs)};
+    clock::time_point oldest_{};
+    clock::time_point retry_at_{};
+
+    char buf_[kInfluxBatchBytes];
+    size_t used_{0};
+    uint32_t pending_lines_{0};
+    char rx_[2048];
+    size_t rx_len_{0};
+
+    uint64_t lines_{0};
+    uint64_t batches_{0};
+    uint64_t bytes_sent_{0};
+    uint64_t dropped_lines_{0};
+    uint64_t send_failures_{0};
+    uint64_t connects_{0};
+    int last_status_{0};
+};
+
+} // namespace industrial
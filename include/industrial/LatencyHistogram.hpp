@@ -0,0 +1,102 @@
+/**
+ * @file industrial/LatencyHistogram.hpp
+ * @brief Fixed-size log-linear histogram of durations in nanoseconds, recorded and read without locks.
+ *
+ * Values are bucketed by their power of two and, within it, into kSubBuckets linear steps, so any
+ * reported value is within 1/kSubBuckets (12.5 %) above the recorded one across the whole
+ * 1 ns .. 2^63 ns range. percentile() walks the buckets and returns the upper edge of the bucket
+ * holding the requested rank; max() is exact.
+ *
+ * @note:
+ * - One writer thread; any thread may read. Counters are relaxed atomics, so a reader racing the
+ *   writer may see a sample in count() before it shows up in a bucket (harmless for monitoring).
+ * - No heap, no exceptions; 4 KiB of buckets.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace industrial {
+
+class LatencyHistogram {
+public:
+    static constexpr uint32_t kSubBits = 3;
+    static constexpr uint32_t kSubBuckets = 1u << kSubBits;
+    static constexpr uint32_t kBuckets = (64 - kSubBits + 1) * kSubBuckets;
+
+    LatencyHistogram() = default;
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(int64_t ns) {
+        const uint64_t v = ns > 0 ? static_cast<uint64_t>(ns) : 0u;
+        buckets_[index(v)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(v, std::memory_order_relaxed);
+        if (v > max_.load(std::memory_order_relaxed)) max_.store(v, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+    double mean() const {
+        const uint64_t n = count();
+        return n == 0 ? 0.0 : static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(n);
+    }
+
+    // p in [0, 100]; 0 when empty. Never reports more than max().
+    uint64_t percentile(double p) const {
+        uint64_t total = 0;
+        for (uint32_t i = 0; i < kBuckets; ++i) total += buckets_[i].load(std::memory_order_relaxed);
+        if (total == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(total) + 0.5);
+        if (rank < 1) rank = 1;
+        if (rank > total) rank = total;
+        uint64_t seen = 0;
+        for (uint32_t i = 0; i < kBuckets; ++i) {
+            seen += buckets_[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                const uint64_t edge = upper_edge(i);
+                const uint64_t m = max();
+                return edge < m ? edge : m;
+            }
+        }
+        return max();
+    }
+
+    // Not safe against a concurrent record(); call while the writer is quiet.
+    void clear() {
+        for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    // Samples in bucket i (i < kBuckets), for exporters.
+    uint64_t bucket(uint32_t i) const { return buckets_[i].load(std::memory_order_relaxed); }
+
+    // Bucket layout, exposed for exporters: values in [lower_edge(i), upper_edge(i)] land in bucket i.
+    static uint32_t index(uint64_t v) {
+        if (v < kSubBuckets) return static_cast<uint32_t>(v);
+        const uint32_t msb = 63u - static_cast<uint32_t>(__builtin_clzll(v));
+        const uint32_t shift = msb - kSubBits;
+        return (shift + 1) * kSubBuckets + static_cast<uint32_t>((v >> shift) & (kSubBuckets - 1));
+    }
+    static uint64_t lower_edge(uint32_t i) {
+        if (i < kSubBuckets) return i;
+        const uint32_t shift = i / kSubBuckets - 1;
+        return (static_cast<uint64_t>(kSubBuckets + i % kSubBuckets)) << shift;
+    }
+    static uint64_t upper_edge(uint32_t i) {
+        if (i < kSubBuckets) return i;
+        return lower_edge(i) + ((uint64_t{1} << (i / kSubBuckets - 1)) - 1);
+    }
+
+private:
+    std::atomic<uint64_t> buckets_[kBuckets] = {};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+} // namespace industrial
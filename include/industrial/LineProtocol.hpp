@@ -0,0 +1,104 @@
+/**
+ * @file industrial/LineProtocol.hpp
+ * @brief InfluxDB line protocol formatting: "<measurement>[,tags] f1=v1,f2=v2 <unix ns>\n".
+ *
+ * Floats are written with a fixed number of decimals by integer arithmetic instead of printf, which
+ * is the dominant cost when formatting many samples; the output matches "%.Nf" except that exact
+ * halfway cases round away from zero and negative zero prints as "0". The measurement and tag set
+ * are escaped once at startup (influx_escape) and passed in preformatted.
+ *
+ * @note:
+ * - No heap, no exceptions; functions return the bytes written, 0 if the buffer is too small or a
+ *   value cannot be represented (NaN, infinity, |v| >= 1e15) - line protocol has no NaN.
+ * - Timestamps are integer nanoseconds since the Unix epoch.
+ */
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace industrial {
+
+struct InfluxField {
+    std::string_view key; // escaped field key
+    float value;
+};
+
+// Escape a measurement name (tag == false: ',' and ' ') or a tag key/value (also '=').
+inline void influx_escape(std::string_view in, bool tag, std::string& out) {
+    for (char ch : in) {
+        if (ch == ',' || ch == ' ' || (tag && ch == '=')) out.push_back('\\');
+        out.push_back(ch);
+    }
+}
+
+namespace detail {
+
+// Decimal digits of v (v > 0 or a single '0') written backwards ending at end; returns the start.
+inline char* put_uint_rev(char* end, uint64_t v) {
+    do {
+        *--end = static_cast<char>('0' + v % 10);
+        v /= 10;
+    } while (v != 0);
+    return end;
+}
+
+} // namespace detail
+
+// "%.<decimals>f" for decimals in [0, 6]; returns bytes written or 0.
+inline size_t format_fixed(char* out, size_t cap, double v, uint32_t decimals) {
+    static constexpr uint64_t kPow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+    if (decimals > 6 || !std::isfinite(v) || std::fabs(v) >= 1e15) return 0;
+    const bool neg = std::signbit(v);
+    const uint64_t scaled = static_cast<uint64_t>(std::llround(std::fabs(v) * static_cast<double>(kPow10[decimals])));
+    char tmp[32];
+    char* end = tmp + sizeof(tmp);
+    char* p = end;
+    if (decimals > 0) {
+        uint64_t frac = scaled % kPow10[decimals];
+        for (uint32_t i = 0; i < decimals; ++i, frac /= 10) *--p = static_cast<char>('0' + frac % 10);
+        *--p = '.';
+    }
+    p = detail::put_uint_rev(p, scaled / kPow10[decimals]);
+    if (neg && scaled != 0) *--p = '-';
+    const size_t n = static_cast<size_t>(end - p);
+    if (n > cap) return 0;
+    std::memcpy(out, p, n);
+    return n;
+}
+
+// One line: prefix (measurement[,tags]), fields with `decimals` digits, timestamp, '\n'.
+inline size_t influx_line(char* out, size_t cap, std::string_view prefix, const InfluxField* fields, size_t n,
+                          int64_t ts_ns, uint32_t decimals = 3) {
+    if (n == 0 || ts_ns < 0 || prefix.size() + 1 > cap) return 0;
+    size_t pos = 0;
+    std::memcpy(out, prefix.data(), prefix.size());
+    pos += prefix.size();
+    out[pos++] = ' ';
+    for (size_t i = 0; i < n; ++i) {
+        if (pos + fields[i].key.size() + 2 > cap) return 0;
+        if (i > 0) out[pos++] = ',';
+        std::memcpy(out + pos, fields[i].key.data(), fields[i].key.size());
+        pos += fields[i].key.size();
+        out[pos++] = '=';
+        const size_t w = format_fixed(out + pos, cap - pos, fields[i].value, decimals);
+        if (w == 0) return 0;
+        pos += w;
+    }
+    char tmp[24];
+    char* end = tmp + sizeof(tmp);
+    char* p = detail::put_uint_rev(end, static_cast<uint64_t>(ts_ns));
+    const size_t tlen = static_cast<size_t>(end - p);
+    if (pos + 1 + tlen + 1 > cap) return 0;
+    out[pos++] = ' ';
+    std::memcpy(out + pos, p, tlen);
+    pos += tlen;
+    out[pos++] = '\n';
+    return pos;
+}
+
+} // namespace industrial
@@ -0,0 +1,130 @@
+/**
+ * @file industrial/LocalSubServer.hpp
+ * @brief Local subscription server on a Unix domain socket, plus the matching client.
+ *
+ * Co-located processes (visualizer, local historian) connect to a SOCK_SEQPACKET socket and
+ * subscribe with MQTT-style topic filters; there is no broker and no TCP on the way. The server is
+ * an ordinary sink (see industrial/Sinks.hpp), so SinkFanOut drives it from its own thread.
+ *
+ * Wire protocol: one record per SEQPACKET message, so the kernel keeps the boundaries.
+ *   client -> server   'S' <filter>                     subscribe
+ *                      'U' <filter>                     unsubscribe
+ *   server -> client   'A' <status> <filter>            ack (status 0 ok, 1 rejected)
+ *                      'D' <flags> <u16 LE topic len> <topic> <payload>   data (flags bit 0: binary)
+ *
+ * Matching: filters are compiled into a TopicTrie when they arrive; write() matches the frame's
+ * topic once and gets a bit mask of clients. Fan-out topics are long-lived strings, so the result
+ * is also cached per topic pointer until the next subscription change.
+ * Delivery: every matching client gets one sendmsg() whose iovecs point at the same 4-byte header,
+ * the topic and the pooled payload buffer; nothing is copied per client.
+ *
+ * @note:
+ * - No exceptions; open() returns false, write() false only when the server is closed.
+ * - Sends never block: a client whose socket buffer is full misses that frame (counted in
+ *   dropped()); a client that went away is disconnected and its filters removed.
+ * - New connections and subscription requests are serviced from idle() and every kServiceEvery
+ *   frames under sustained load.
+ * - Not thread-safe: one thread drives the server (SinkFanOut's worker), one drives a client.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "industrial/Config.hpp"
+#include "industrial/Sinks.hpp"
+#include "industrial/TopicTrie.hpp"
+
+namespace industrial {
+
+class LocalSubServer {
+public:
+    static constexpr uint32_t kServiceEvery = 32;
+
+    LocalSubServer();
+    ~LocalSubServer();
+    LocalSubServer(const LocalSubServer&) = delete;
+    LocalSubServer& operator=(const LocalSubServer&) = delete;
+
+    // Binds path (a stale socket file left by a previous run is replaced).
+    bool open(const std::string& path);
+    void close();
+    bool is_open() const { return listen_fd_ >= 0; }
+
+    bool write(const Frame& f);
+    void idle() { service(); }
+    static const char* name() { return "local"; }
+
+    // Accept pending connections and handle subscription requests.
+    void service();
+
+    uint32_t clients() const { return clients_; }
+    uint64_t delivered() const { return delivered_; }
+    uint64_t dropped() const { return dropped_; }
+
+private:
+    using Trie = TopicTrie<>;
+    static constexpr uint32_t kCacheSlots = 16;
+
+    struct CacheEntry {
+        const char* topic{nullptr};
+        size_t len{0};
+        uint64_t gen{0};
+        Trie::Mask mask{0};
+    };
+
+    Trie::Mask lookup(std::string_view topic);
+    void handle(uint32_t client, const char* msg, size_t n);
+    void drop_client(uint32_t client);
+
+    int listen_fd_{-1};
+    std::string path_;
+    int fds_[kLocalSubMaxClients];
+    uint32_t clients_{0};
+    Trie trie_;
+    CacheEntry cache_[kCacheSlots];
+    uint64_t gen_{1}; // bumped by every subscription change
+    uint32_t since_service_{0};
+    uint64_t delivered_{0};
+    uint64_t dropped_{0};
+};
+
+class LocalSubClient {
+public:
+    enum class Kind : uint8_t { None, Data, Ack, Nack };
+
+    struct Message {
+        Kind kind{Kind::None};
+        std::string_view topic; // Data: topic; Ack/Nack: the filter
+        const uint8_t* data{nullptr};
+        size_t len{0};
+        bool binary{false};
+    };
+
+    LocalSubClient() = default;
+    ~LocalSubClient();
+    LocalSubClient(const LocalSubClient&) = delete;
+    LocalSubClient& operator=(const LocalSubClient&) = delete;
+
+    bool connect(const std::string& path);
+    void close();
+    bool is_open() const { return fd_ >= 0; }
+
+    // Send the request and wait up to timeout_ms for its ack; data arriving meanwhile is discarded.
+    bool subscribe(std::string_view filter, int timeout_ms = 1000) { return request('S', filter, timeout_ms); }
+    bool unsubscribe(std::string_view filter, int timeout_ms = 1000) { return request('U', filter, timeout_ms); }
+
+    // Next record, waiting up to timeout_ms; Kind::None on timeout or error. Views stay valid until
+    // the next call.
+    Message recv(int timeout_ms);
+
+private:
+    bool request(char op, std::string_view filter, int timeout_ms);
+
+    int fd_{-1};
+    uint8_t buf_[kLocalSubMaxRecord];
+};
+
+} // namespace industrial
@@ -0,0 +1,124 @@
+/**
+ * @file industrial/ModbusServer.hpp
+ * @brief Embedded Modbus TCP server exposing the latest channel values as scaled 16-bit registers.
+ *
+ * The consumer calls update() with the newest value of every channel; it lands in a SeqLock, so the
+ * filter loop never waits for a poll and a poll never sees half an update. The server answers
+ * Read Holding Registers (FC 3) and Read Input Registers (FC 4) for any number of clients from one
+ * epoll loop, on its own thread (start()) or driven by the caller (poll()).
+ *
+ * Register map: each table (holding, input) has kModbusRegisters addresses. map() binds an address
+ * to a channel with a scale: the register holds round(value * scale) as a signed 16-bit integer,
+ * clamped to [-32767, 32767]; NaN reads as 0x8000. map_counter() binds an address to the low 16 bits
+ * of the update count (a freshness indicator for HMIs). Unmapped addresses inside the table read 0.
+ *
+ * Exceptions: unknown function code -> 01, a range past the table -> 02, quantity outside 1..125 or
+ * a malformed PDU -> 03. Frames with a non-zero protocol id or an impossible length close the
+ * connection. The unit id is echoed and otherwise ignored.
+ *
+ * @note:
+ * - No exceptions; open() returns false on socket errors, map() false for a bad address/channel.
+ * - map()/map_counter() before start(); update() from one thread (SeqLock writer); poll() from one
+ *   thread (the server thread after start()).
+ * - Pipelined requests are answered in order with one send() per batch. Sends never block: a client
+ *   that does not read its responses is disconnected (counted in dropped()).
+ * - A full client table refuses new connections by closing them.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "industrial/Config.hpp"
+#include "industrial/SeqLock.hpp"
+
+namespace industrial {
+
+class ModbusServer {
+public:
+    enum class Table : uint8_t { Holding, Input };
+
+    static constexpr uint16_t kMaxReadQuantity = 125;
+    static constexpr uint8_t kFcReadHolding = 3;
+    static constexpr uint8_t kFcReadInput = 4;
+    static constexpr uint8_t kExIllegalFunction = 1;
+    static constexpr uint8_t kExIllegalAddress = 2;
+    static constexpr uint8_t kExIllegalValue = 3;
+
+    ModbusServer();
+    ~ModbusServer();
+    ModbusServer(const ModbusServer&) = delete;
+    ModbusServer& operator=(const ModbusServer&) = delete;
+
+    // Listen on addr:port (port 0: ephemeral, see port()). addr is a numeric IPv4 address.
+    bool open(uint16_t port, const char* addr = "0.0.0.0");
+    void close();
+    bool is_open() const { return listen_fd_ >= 0; }
+    uint16_t port() const { return port_; }
+
+    bool map(Table t, uint16_t address, uint32_t channel, float scale);
+    bool map_counter(Table t, uint16_t address);
+
+    // Publish the newest channel values (n <= kModbusChannels; missing channels read as 0).
+    void update(const float* values, uint32_t n);
+
+    // Serve requests until stop(); or drive the loop yourself with poll().
+    bool start();
+    void stop();
+    // Wait up to timeout_ms for socket events and handle them; returns false when not open.
+    bool poll(int timeout_ms);
+
+    uint32_t clients() const { return clients_.load(std::memory_order_relaxed); }
+    uint64_t requests() const { return requests_.load(std::memory_order_relaxed); }
+    uint64_t exceptions() const { return exceptions_.load(std::memory_order_relaxed); }
+    uint64_t connects() const { return connects_.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    uint64_t updates() const { return image_.seq(); }
+
+private:
+    struct Image {
+        float values[kModbusChannels];
+        uint32_t updates;
+    };
+
+    enum class Source : uint8_t { None, Channel, Counter };
+
+    struct Reg {
+        Source source{Source::None};
+        uint8_t channel{0};
+        float scale{1.0f};
+    };
+
+    struct Conn {
+        int fd{-1};
+        uint32_t len{0};
+        uint8_t rx[2 * kModbusMaxAdu];
+    };
+
+    void accept_all();
+    void serve(uint32_t slot);
+    // Handles one complete ADU; returns the response length written to out, or 0 to close the connection.
+    size_t respond(const uint8_t* adu, size_t len, const Image& img, uint8_t* out);
+    void drop_client(uint32_t slot);
+
+    int listen_fd_{-1};
+    int epoll_fd_{-1};
+    int wake_fd_{-1};
+    uint16_t port_{0};
+    uint32_t update_count_{0};
+
+    SeqLock<Image> image_;
+    Reg regs_[2][kModbusRegisters];
+    Conn conns_[kModbusMaxClients];
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint32_t> clients_{0};
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> exceptions_{0};
+    std::atomic<uint64_t> connects_{0};
+    std::atomic<uint64_t> dropped_{0};
+};
+
+} // namespace industrial
@@ -0,0 +1,123 @@
+/**
+ * @file industrial/MqttClient.hpp
+ * @brief Minimal in-tree MQTT 3.1.1 publish-only client over a nonblocking TCP socket.
+ *
+ * Supports CONNECT/CONNACK, PUBLISH at QoS 0 and 1 (PUBACK), PINGREQ/PINGRESP keep-alive and
+ * DISCONNECT. Everything else a broker might send is skipped.
+ *
+ * Vectored writes: queue_publish() frames a PUBLISH into the transmit arena (fixed header,
+ * topic and packet id) and, unless asked to copy, references the payload in place. flush()
+ * then hands every queued frame to the kernel with one vectored sendmsg() per call, resuming
+ * partial writes where they stopped. A sync publish is simply queue + flush.
+ *
+ * QoS 1: packet ids cycle through 1..65535; at most max_inflight PUBLISHes may await their
+ * PUBACK. queue_publish() reports WindowFull instead of blocking when the window is exhausted.
+ * No retransmission: the session is clean, so unacknowledged messages are lost on disconnect.
+ *
+ * @note:
+ * - No exceptions, no heap after construction; every call returns a Result.
+ * - Not thread-safe; one thread drives the client.
+ * - Referenced (non-copied) payloads must stay valid until flush() returns Ok.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <sys/uio.h>
+
+#include "industrial/Config.hpp"
+
+namespace industrial {
+
+class MqttClient {
+public:
+    enum class Result : uint8_t {
+        Ok = 0,
+        NotConnected,
+        ResolveFailed,  // host lookup failed
+        ConnectFailed,  // TCP connect refused/unreachable
+        Refused,        // broker answered CONNACK with a non-zero return code
+        Timeout,
+        WindowFull,     // QoS 1 in-flight window exhausted
+        TooLarge,       // topic/payload exceed protocol or arena limits
+        IoError,        // socket error or peer closed; the session is gone
+        ProtocolError,  // malformed or unexpected packet from the broker
+    };
+
+    MqttClient() = default;
+    ~MqttClient();
+    MqttClient(const MqttClient&) = delete;
+    MqttClient& operator=(const MqttClient&) = delete;
+
+    // Split "tcp://host:port" / "mqtt://host:port" / "host[:port]" (default port 1883).
+    static bool parse_uri(const std::string& uri, std::string& host, uint16_t& port);
+
+    Result connect(const std::string& host, uint16_t port, const std::string& client_id,
+                   uint16_t keep_alive_s, int timeout_ms);
+    void disconnect(); // best-effort DISCONNECT, then close
+
+    // Frame one PUBLISH into the transmit batch. A full batch is flushed first (up to
+    // kMqttIoTimeoutMs). copy=true copies the payload into the arena so the caller may reuse it.
+    Result queue_publish(std::string_view topic, const void* payload, size_t len, int qos, bool retain, bool copy);
+
+    // Write all queued frames, waiting for socket writability up to timeout_ms.
+    Result flush(int timeout_ms);
+
+    // Process incoming packets for up to timeout_ms (0: only what is already readable) and send a
+    // PINGREQ when the keep-alive interval is half used.
+    Result poll(int timeout_ms);
+
+    // Poll until every QoS 1 PUBLISH has been acknowledged.
+    Result wait_acked(int timeout_ms);
+
+    bool connected() const { return fd_ >= 0; }
+    uint32_t queued() const { return queued_frames_; }
+    // Frames the client no longer references, written or dropped with a lost session; monotonic.
+    // A frame queued when done_frames() + queued() was n is finished once done_frames() exceeds n.
+    uint64_t done_frames() const { return done_frames_; }
+    uint32_t inflight() const { return inflight_; }
+    uint64_t write_calls() const { return write_calls_; } // vectored sendmsg() calls
+    void set_max_inflight(uint32_t n) { max_inflight_ = n == 0 ? 1 : (n > kMqttMaxInflight ? kMqttMaxInflight : n); }
+
+    static const char* result_name(Result r);
+
+private:
+    Result fail(Result r); // close the socket and report r
+    Result write_pending(int timeout_ms);
+    Result read_available();
+    Result handle_packet(uint8_t type, const uint8_t* body, uint32_t len);
+    bool push_iov(const void* p, size_t n);
+    uint8_t* arena_alloc(size_t n);
+    int64_t now_ms() const;
+
+    int fd_{-1};
+    uint16_t keep_alive_s_{60};
+    int64_t last_tx_ms_{0};
+    int64_t ping_sent_ms_{0}; // 0: no PINGREQ outstanding
+
+    // transmit batch
+    uint8_t tx_[kMqttTxArenaBytes];
+    size_t tx_used_{0};
+    struct iovec iov_[kMqttMaxIov];
+    uint32_t iov_count_{0};
+    uint32_t iov_pos_{0}; // first iovec not fully written
+    uint32_t queued_frames_{0};
+    uint64_t done_frames_{0};
+    uint64_t write_calls_{0};
+
+    // receive buffer (acks and pings are tiny; larger packets are skipped in place)
+    uint8_t rx_[512];
+    uint32_t rx_len_{0};
+    uint32_t skip_{0}; // bytes of an oversized packet still to discard
+
+    // QoS 1 window
+    uint16_t next_id_{1};
+    uint32_t max_inflight_{kMqttMaxInflight};
+    uint32_t inflight_{0};
+    uint16_t inflight_ids_[kMqttMaxInflight];
+};
+
+} // namespace industrial
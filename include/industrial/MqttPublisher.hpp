@@ -1,36 +1,179 @@
 /**
  * @file industrial/MqttPublisher.hpp
- * @brief Tiny C++ facade over the Eclipse Paho MQTT C (synchronous) API.
+ * @brief Tiny C++ facade over the in-tree MQTT 3.1.1 client (industrial/MqttClient.hpp).
  *
  * @note:
  * - No exceptions and no RTTI; simple bool/int status returns.
- * - This header is safe to include even if the C library is missing;
- *   the implementation is only compiled when the library is detected.
+ * - Publish modes:
+ *   - Sync (default): every publish is written immediately; QoS 1 waits for its PUBACK (~5 s cap).
+ *   - Pipelined: written immediately; QoS 1 acknowledgements are collected later within the
+ *     client's in-flight window, so publishes do not wait a round trip each.
+ *   - Batched: publishes are framed into one buffer and written with a single vectored write once
+ *     batch_frames are queued or on flush()/service().
+ * - Optional background reconnect: start_reconnect() spawns a supervisor thread that re-establishes
+ *   the session with exponential backoff and jitter. The connection state is a single atomic, so
+ *   publish() fails fast (no syscalls) while disconnected instead of blocking on a TCP timeout.
+ * - Publish-path instrumentation: every publish() is counted as a success (plus its payload
+ *   bytes) or as a failure under its MqttClient::Result reason code, and the time spent in each
+ *   call that reached the client goes into a LatencyHistogram. In Sync mode with QoS 1 that covers
+ *   the PUBACK round trip; in Pipelined/Batched mode it covers queueing and any write it triggered.
+ * - Zero-copy publishing from pooled buffers: publish() with a PayloadRef (or a pool and handle)
+ *   references the payload in place in every mode, Batched included, and holds a reference on the
+ *   buffer until its frame has been written to the socket or dropped with the session. Without a
+ *   ref, Batched mode copies the payload because the caller may reuse it on return. The client does
+ *   not retransmit (clean session), so "written" is the last moment the bytes are needed.
+ * - publish()/flush()/service()/disconnect() belong to one thread; observers are safe from any thread.
  */
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <thread>
+
+#include "industrial/LatencyHistogram.hpp"
+#include "industrial/MqttClient.hpp"
+#include "industrial/PayloadRef.hpp"
 
 namespace industrial {
 
 class MqttPublisher {
 public:
+    enum class State : uint8_t {
+        Disconnected = 0, // no session; supervisor (if running) will retry
+        Connecting = 1,   // supervisor is inside a connect attempt
+        Connected = 2,
+        Backoff = 3,      // waiting before the next attempt
+    };
+
+    enum class Mode : uint8_t { Sync = 0, Pipelined = 1, Batched = 2 };
+
+    struct ReconnectPolicy {
+        uint32_t initial_ms = 250;  // first retry delay
+        uint32_t max_ms = 30000;    // delay cap
+        double multiplier = 2.0;    // growth per failed attempt
+        double jitter = 0.2;        // +/- fraction applied to each delay
+    };
+
     MqttPublisher();
     ~MqttPublisher();
+    MqttPublisher(const MqttPublisher&) = delete;
+    MqttPublisher& operator=(const MqttPublisher&) = delete;
 
     // Connect to broker, e.g., brokerUri="tcp://localhost:1883"
-    // keepAliveSec typical 60.
+    // keepAliveSec typical 60. Parameters are remembered for reconnects.
     bool connect(const std::string& brokerUri, const std::string& clientId, int keepAliveSec);
+    // Non-blocking variant: remembers the parameters and starts the reconnect supervisor, which makes
+    // the first attempt at once in the background (publish() fails fast until it succeeds). False
+    // only for an unusable URI or a supervisor that is already running.
+    bool connect_async(const std::string& brokerUri, const std::string& clientId, int keepAliveSec,
+                       const ReconnectPolicy& policy);
+    bool connect_async(const std::string& brokerUri, const std::string& clientId, int keepAliveSec) {
+        return connect_async(brokerUri, clientId, keepAliveSec, ReconnectPolicy{});
+    }
 
-    // Publish payload to topic. QoS: 0 or 1. retain: false by default.
-    bool publish(const std::string& topic, const void* payload, size_t len, int qos, bool retain);
+    // Publish payload to topic. QoS: 0 or 1. retain: false by default. The topic is framed
+    // straight from the view (no copy, no allocation), e.g. a TopicArena handle.
+    // A failure that drops the session hands it to the supervisor.
+    bool publish(std::string_view topic, const void* payload, size_t len, int qos, bool retain) {
+        return publish(topic, payload, len, qos, retain, PayloadRef{});
+    }
+    // Same, with payload inside the buffer named by ref: it is never copied, and ref is retained
+    // until the frame has been written or dropped (the caller keeps and releases its own reference).
+    bool publish(std::string_view topic, const void* payload, size_t len, int qos, bool retain, const PayloadRef& ref);
+    template <typename Pool>
+    bool publish(std::string_view topic, Pool& pool, typename Pool::Handle h, int qos, bool retain) {
+        return publish(topic, pool.data(h), pool.len(h), qos, retain, PayloadRef(pool, h));
+    }
+
+    // Select the publish mode (see file comment); batch_frames applies to Batched.
+    void set_mode(Mode mode, uint32_t batch_frames = 32);
+    Mode mode() const { return mode_; }
+
+    // Write any batched frames now.
+    bool flush();
+    // Housekeeping from the publishing thread when idle: flush batches, collect acks, keep-alive.
+    bool service();
 
     void disconnect();
     bool is_connected() const;
 
+    // Background reconnect supervisor using the parameters of the last connect() call.
+    bool start_reconnect(const ReconnectPolicy& policy);
+    bool start_reconnect() { return start_reconnect(ReconnectPolicy{}); }
+    void stop_reconnect();
+
+    // Lock-free observers, safe from any thread.
+    State state() const { return state_.load(std::memory_order_acquire); }
+    uint64_t reconnects() const { return reconnects_.load(std::memory_order_relaxed); }
+    uint64_t connect_failures() const { return connect_failures_.load(std::memory_order_relaxed); }
+    // Time from detecting a lost session to the successful reconnect, most recent and worst (ns).
+    int64_t last_recovery_ns() const { return last_recovery_ns_.load(std::memory_order_relaxed); }
+    int64_t max_recovery_ns() const { return max_recovery_ns_.load(std::memory_order_relaxed); }
+    // Pooled payload buffers currently held until their frame is written.
+    uint32_t held_payloads() const { return held_count_.load(std::memory_order_relaxed); }
+
+    // Publish-path statistics, safe from any thread (e.g. a stats reporter).
+    uint64_t published() const { return published_.load(std::memory_order_relaxed); }
+    uint64_t bytes_published() const { return bytes_published_.load(std::memory_order_relaxed); }
+    uint64_t publish_failures() const;
+    // Failed publishes by reason; NotConnected counts fail-fast calls while the session is down.
+    uint64_t publish_failures(MqttClient::Result why) const {
+        return failures_[static_cast<uint8_t>(why) % kReasons].load(std::memory_order_relaxed);
+    }
+    MqttClient::Result last_error() const { return last_error_.load(std::memory_order_relaxed); }
+    const LatencyHistogram& publish_latency() const { return publish_latency_; }
+
 private:
-    void* client_ = 0; // opaque MQTTClient*
-    bool connected_ = false;
+    bool backend_connect();
+    void backend_close();
+    template <typename Fn>
+    bool with_client(Fn&& fn); // run fn(MqttClient&) only while Connected; marks loss on socket failure
+
+    MqttClient::Result publish_once(MqttClient& c, std::string_view topic, const void* payload, size_t len, int qos,
+                                    bool retain, bool copy);
+    void release_done(uint64_t done_frames); // drop the refs of frames the client has finished with
+    void mark_lost();
+    void supervise(ReconnectPolicy policy);
+
+    MqttClient* client_ = nullptr; // owned; created on first connect
+    std::string uri_;
+    std::string client_id_;
+    int keep_alive_ = 60;
+    Mode mode_ = Mode::Sync;
+    uint32_t batch_frames_ = 32;
+
+    std::atomic<State> state_{State::Disconnected};
+    std::atomic<uint32_t> busy_{0};          // publishing-thread calls currently using client_
+    std::atomic<int64_t> lost_at_ns_{0};     // steady_clock ns when the session was lost
+    std::atomic<uint64_t> reconnects_{0};
+    std::atomic<uint64_t> connect_failures_{0};
+    std::atomic<int64_t> last_recovery_ns_{0};
+    std::atomic<int64_t> max_recovery_ns_{0};
+
+    static constexpr uint32_t kReasons = static_cast<uint32_t>(MqttClient::Result::ProtocolError) + 1;
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> bytes_published_{0};
+    std::atomic<uint64_t> failures_[kReasons] = {};
+    std::atomic<MqttClient::Result> last_error_{MqttClient::Result::Ok};
+    LatencyHistogram publish_latency_;
+
+    // Refs held for queued by-reference frames, oldest first. Each such frame takes at least two
+    // iovecs (header, payload), so the client never has more than kMqttMaxIov / 2 of them queued.
+    struct Held {
+        uint64_t frame; // done_frames() + queued() - 1 when it was queued
+        PayloadRef ref;
+    };
+    static constexpr uint32_t kMaxHeld = kMqttMaxIov / 2;
+    Held held_[kMaxHeld];
+    uint32_t held_head_ = 0;
+    uint32_t held_len_ = 0;
+    std::atomic<uint32_t> held_count_{0};
+
+    std::atomic<bool> supervising_{false};
+    std::thread supervisor_;
 };
 
 } // namespace industrial
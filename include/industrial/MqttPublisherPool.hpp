@@ -0,0 +1,190 @@
+/**
+ * @file industrial/MqttPublisherPool.hpp
+ * @brief Shards publishing across N MQTT connections, each owned by its own thread.
+ *
+ * @tparam Pool PayloadPool instantiation holding the encoded bytes.
+ *
+ * A single MqttPublisher is one TCP connection driven by one thread, which caps the publish rate of
+ * the whole process. The pool opens N sessions ("<client_id>-0" .. "-N-1") and routes every message
+ * by a caller-supplied key (sensor id, or key_of(topic)) to shard key_hash(key) % N. The mapping
+ * depends only on the key and N, so a sensor always uses the same connection and per-topic ordering
+ * is kept; different shards run in parallel.
+ *
+ * @note:
+ * - submit() never copies payload bytes: the pool handle travels through the shard's SpscRing and
+ *   the shard thread publishes straight from the buffer (holding it while a batch is pending) and
+ *   releases it. A full shard queue refuses (counted as dropped).
+ * - Exactly one thread may call submit(). Topics must outlive the pool (long-lived strings).
+ * - Each shard has its own reconnect supervisor; a dead connection only stalls its own keys.
+ * - Per-shard counters and queue depth are lock-free reads.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "industrial/Config.hpp"
+#include "industrial/MqttPublisher.hpp"
+#include "industrial/SpscRing.hpp"
+
+namespace industrial {
+
+template <typename Pool>
+class MqttPublisherPool {
+public:
+    using Handle = typename Pool::Handle;
+
+    struct Stats {
+        uint64_t published{0};
+        uint64_t bytes{0};
+        uint64_t failed{0};  // publish() returned false
+        uint64_t dropped{0}; // shard queue full at submit()
+        uint32_t depth{0};
+        bool connected{false};
+    };
+
+    explicit MqttPublisherPool(Pool& pool) : pool_{pool} {}
+    ~MqttPublisherPool() { stop(); disconnect(); }
+    MqttPublisherPool(const MqttPublisherPool&) = delete;
+    MqttPublisherPool& operator=(const MqttPublisherPool&) = delete;
+
+    // Open n (clamped to [1, kMqttPoolMaxConnections]) sessions; returns how many connected now.
+    // Failed shards are left to start_reconnect().
+    uint32_t connect(const std::string& uri, const std::string& client_id, int keep_alive_s, uint32_t n) {
+        n_ = n < 1 ? 1 : (n > kMqttPoolMaxConnections ? kMqttPoolMaxConnections : n);
+        uint32_t up = 0;
+        for (uint32_t i = 0; i < n_; ++i) {
+            up += shards_[i].mqtt.connect(uri, client_id + "-" + std::to_string(i), keep_alive_s) ? 1u : 0u;
+        }
+        return up;
+    }
+
+    void set_mode(MqttPublisher::Mode mode, uint32_t batch_frames = 32) {
+        for (uint32_t i = 0; i < n_; ++i) shards_[i].mqtt.set_mode(mode, batch_frames);
+    }
+
+    void start_reconnect(const MqttPublisher::ReconnectPolicy& policy = MqttPublisher::ReconnectPolicy{}) {
+        for (uint32_t i = 0; i < n_; ++i) shards_[i].mqtt.start_reconnect(policy);
+    }
+
+    void start() {
+        if (running_.exchange(true)) return;
+        for (uint32_t i = 0; i < n_; ++i) {
+            Shard& s = shards_[i];
+            s.thread = std::thread([this, &s] { run(s); });
+        }
+    }
+
+    // Workers drain their queues, then exit.
+    void stop() {
+        if (!running_.exchange(false)) return;
+        for (uint32_t i = 0; i < n_; ++i) {
+            if (shards_[i].thread.joinable()) shards_[i].thread.join();
+        }
+    }
+
+    void disconnect() {
+        for (uint32_t i = 0; i < n_; ++i) shards_[i].mqtt.disconnect();
+    }
+
+    uint32_t connections() const { return n_; }
+
+    // Stable key -> shard mapping (murmur3 finalizer so sequential sensor ids spread evenly).
+    static uint32_t key_hash(uint32_t k) {
+        k ^= k >> 16;
+        k *= 0x85ebca6bu;
+        k ^= k >> 13;
+        k *= 0xc2b2ae35u;
+        k ^= k >> 16;
+        return k;
+    }
+    uint32_t shard_of(uint32_t key) const { return key_hash(key) % n_; }
+
+    // FNV-1a, for callers that shard by topic rather than by sensor id.
+    static uint32_t key_of(std::string_view topic) {
+        uint32_t h = 2166136261u;
+        for (char c : topic) {
+            h ^= static_cast<uint8_t>(c);
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    // Takes over the caller's reference on h. False if the shard queue was full (h released).
+    bool submit(uint32_t key, Handle h, std::string_view topic, int qos = 0, bool retain = false) {
+        Shard& s = shards_[shard_of(key)];
+        const Job j{h, static_cast<uint32_t>(topic.size()), topic.data(), static_cast<uint8_t>(qos), retain};
+        if (!s.queue.try_push(j)) {
+            s.dropped.fetch_add(1, std::memory_order_relaxed);
+            pool_.release(h);
+            return false;
+        }
+        return true;
+    }
+
+    Stats stats(uint32_t i) const {
+        Stats st{};
+        if (i >= n_) return st;
+        const Shard& s = shards_[i];
+        st.published = s.published.load(std::memory_order_relaxed);
+        st.bytes = s.bytes.load(std::memory_order_relaxed);
+        st.failed = s.failed.load(std::memory_order_relaxed);
+        st.dropped = s.dropped.load(std::memory_order_relaxed);
+        st.depth = s.queue.size();
+        st.connected = s.mqtt.is_connected();
+        return st;
+    }
+
+    MqttPublisher& publisher(uint32_t i) { return shards_[i].mqtt; }
+
+private:
+    struct Job {
+        Handle handle;
+        uint32_t topic_len;
+        const char* topic;
+        uint8_t qos;
+        bool retain;
+    };
+
+    struct Shard {
+        MqttPublisher mqtt;
+        SpscRing<Job, kMqttShardQueueCapacity> queue;
+        std::thread thread;
+        std::atomic<uint64_t> published{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> failed{0};
+        std::atomic<uint64_t> dropped{0};
+    };
+
+    void run(Shard& s) {
+        Job j;
+        for (;;) {
+            if (s.queue.try_pop(j)) {
+                const uint32_t len = pool_.len(j.handle);
+                if (s.mqtt.publish(std::string_view(j.topic, j.topic_len), pool_, j.handle, j.qos, j.retain)) {
+                    s.published.fetch_add(1, std::memory_order_relaxed);
+                    s.bytes.fetch_add(len, std::memory_order_relaxed);
+                } else {
+                    s.failed.fetch_add(1, std::memory_order_relaxed);
+                }
+                pool_.release(j.handle);
+                continue;
+            }
+            (void)s.mqtt.service(); // batches, acks, keep-alive
+            if (!running_.load(std::memory_order_acquire)) break; // queue drained
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    Pool& pool_;
+    uint32_t n_{1};
+    Shard shards_[kMqttPoolMaxConnections];
+    std::atomic<bool> running_{false};
+};
+
+} // namespace industrial
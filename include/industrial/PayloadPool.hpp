@@ -0,0 +1,99 @@
+/**
+ * @file industrial/PayloadPool.hpp
+ * @brief Fixed-capacity pool of reference-counted payload buffers addressed by small integer handles.
+ *
+ * @tparam COUNT Number of buffers (< 2^32 - 1).
+ * @tparam SIZE  Bytes per buffer.
+ *
+ * @note:
+ * - An encoder acquires a buffer (refcount 1), writes into data(), sets its length and hands the
+ *   handle on; each consumer of the handle retains/releases it, and the last release returns the
+ *   buffer to the pool. Payload bytes are written once and never copied between stages.
+ * - acquire() and release() are lock-free and may run on different threads (Treiber free list
+ *   with a generation tag in the upper 32 bits of the head against ABA).
+ * - No heap, no exceptions; acquire() returns kInvalid when the pool is exhausted.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace industrial {
+
+template <uint32_t COUNT, uint32_t SIZE>
+class PayloadPool {
+public:
+    static_assert(COUNT >= 1 && COUNT < 0xFFFFFFFFu, "COUNT out of range");
+
+    using Handle = uint32_t;
+    static constexpr Handle kInvalid = 0xFFFFFFFFu;
+
+    PayloadPool() {
+        for (uint32_t i = 0; i < COUNT; ++i) {
+            slots_[i].next.store(i + 1 < COUNT ? i + 1 : kInvalid, std::memory_order_relaxed);
+        }
+        head_.store(0, std::memory_order_relaxed);
+    }
+    PayloadPool(const PayloadPool&) = delete;
+    PayloadPool& operator=(const PayloadPool&) = delete;
+
+    static constexpr uint32_t capacity() { return COUNT; }
+    static constexpr uint32_t buffer_size() { return SIZE; }
+
+    Handle acquire() {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        for (;;) {
+            const uint32_t idx = static_cast<uint32_t>(head);
+            if (idx == kInvalid) {
+                exhausted_.fetch_add(1, std::memory_order_relaxed);
+                return kInvalid;
+            }
+            const uint32_t next = slots_[idx].next.load(std::memory_order_relaxed);
+            const uint64_t desired = ((head >> 32) + 1u) << 32 | next;
+            if (head_.compare_exchange_weak(head, desired, std::memory_order_acquire, std::memory_order_acquire)) {
+                slots_[idx].refs.store(1, std::memory_order_relaxed);
+                slots_[idx].len = 0;
+                in_use_.fetch_add(1, std::memory_order_relaxed);
+                return idx;
+            }
+        }
+    }
+
+    void retain(Handle h, uint32_t n = 1) { slots_[h].refs.fetch_add(n, std::memory_order_relaxed); }
+
+    // Drop one reference; the last one returns the buffer to the free list.
+    void release(Handle h) {
+        if (slots_[h].refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+        in_use_.fetch_sub(1, std::memory_order_relaxed);
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            slots_[h].next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+            const uint64_t desired = ((head >> 32) + 1u) << 32 | h;
+            if (head_.compare_exchange_weak(head, desired, std::memory_order_release, std::memory_order_relaxed)) return;
+        }
+    }
+
+    uint8_t* data(Handle h) { return slots_[h].data; }
+    const uint8_t* data(Handle h) const { return slots_[h].data; }
+    void set_len(Handle h, uint32_t n) { slots_[h].len = n <= SIZE ? n : SIZE; }
+    uint32_t len(Handle h) const { return slots_[h].len; }
+
+    uint32_t in_use() const { return in_use_.load(std::memory_order_relaxed); }
+    uint64_t exhausted() const { return exhausted_.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> refs{0};
+        std::atomic<uint32_t> next{kInvalid};
+        uint32_t len{0};
+        uint8_t data[SIZE];
+    };
+
+    Slot slots_[COUNT];
+    std::atomic<uint64_t> head_{0};  // [generation:32 | index:32]
+    std::atomic<uint32_t> in_use_{0};
+    std::atomic<uint64_t> exhausted_{0};
+};
+
+} // namespace industrial
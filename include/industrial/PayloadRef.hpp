@@ -0,0 +1,52 @@
+/**
+ * @file industrial/PayloadRef.hpp
+ * @brief Type-erased reference to one PayloadPool buffer, so a consumer can hold it past a call.
+ *
+ * A PayloadRef names a buffer (pool + handle) without knowing the pool's template arguments. Layers
+ * that only see bytes (a Frame, MqttPublisher) can retain() the buffer to keep the payload in place
+ * instead of copying it, and release() it once they are done; the pool's refcount decides when the
+ * buffer is free again.
+ *
+ * @note:
+ * - A default-constructed ref is empty: retain()/release() do nothing and the bytes are only
+ *   borrowed for the duration of the call.
+ * - Two words and a function pointer; no heap, no virtual dispatch.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace industrial {
+
+class PayloadRef {
+public:
+    PayloadRef() = default;
+
+    template <typename Pool>
+    PayloadRef(Pool& pool, typename Pool::Handle h) : owner_{&pool}, handle_{h}, adjust_{&adjust<Pool>} {}
+
+    explicit operator bool() const { return adjust_ != nullptr; }
+    void retain() const {
+        if (adjust_ != nullptr) adjust_(owner_, handle_, true);
+    }
+    void release() const {
+        if (adjust_ != nullptr) adjust_(owner_, handle_, false);
+    }
+
+private:
+    template <typename Pool>
+    static void adjust(void* owner, uint32_t h, bool up) {
+        Pool& pool = *static_cast<Pool*>(owner);
+        if (up) {
+            pool.retain(h);
+        } else {
+            pool.release(h);
+        }
+    }
+
+    void* owner_{nullptr};
+    uint32_t handle_{0};
+    void (*adjust_)(void*, uint32_t, bool){nullptr};
+};
+
+} // namespace industrial
@@ -0,0 +1,122 @@
+/**
+ * @file industrial/PeriodicSchedule.hpp
+ * @brief Release times of a periodic task plus its timing quality: wake-up lateness, run time,
+ *        period jitter, overruns, deadline misses, and what happens after a miss.
+ *
+ * Iteration k is released at start + k * period and should finish before the next release (its
+ * deadline). The task asks until_due(now) how long it may still sleep, and brackets each iteration
+ * with begin(now) and end(now):
+ *
+ *   begin  lateness = now - release into lateness(); |now - previous begin - period| into jitter()
+ *   end    run time = end - begin into run_time(); run time > period counts an overrun, end > deadline
+ *          a deadline miss (late wake-up plus work)
+ *
+ * When begin() finds that one or more later releases have already passed, the policy decides:
+ *   CatchUp  every release still runs, back to back until the task is on time again (no sample lost,
+ *            but their spacing is compressed)
+ *   Skip     the passed releases are dropped and counted in skipped(); the iteration runs as the newest
+ *            of them (and is held to that one's deadline) and the next one is released on the original
+ *            grid, so a skip alone is not also a deadline miss
+ *
+ * @note:
+ * - Times are steady-clock nanoseconds passed in by the caller, so it can be driven by any clock.
+ * - One thread drives it; the counters and histograms may be read from any thread (relaxed, like
+ *   LatencyHistogram). write_csv() exports a summary and every non-empty histogram bucket.
+ * - No heap, no exceptions.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+#include "industrial/LatencyHistogram.hpp"
+
+namespace industrial {
+
+class PeriodicSchedule {
+public:
+    enum class MissPolicy : uint8_t { CatchUp, Skip };
+
+    explicit PeriodicSchedule(int64_t period_ns, MissPolicy policy = MissPolicy::CatchUp)
+        : period_{period_ns > 0 ? period_ns : 1}, policy_{policy} {}
+    PeriodicSchedule(const PeriodicSchedule&) = delete;
+    PeriodicSchedule& operator=(const PeriodicSchedule&) = delete;
+
+    // First release at now (call once, before the first until_due()).
+    void start(int64_t now) {
+        release_ = now;
+        started_ = true;
+    }
+    bool started() const { return started_; }
+
+    // Nanoseconds until the next release; <= 0 once it is due.
+    int64_t until_due(int64_t now) const { return release_ - now; }
+
+    // The due iteration starts now: lateness, jitter, and the miss policy.
+    void begin(int64_t now) {
+        const int64_t late = now - release_;
+        lateness_.record(late);
+        if (begun_) {
+            const int64_t off = now - last_begin_ - period_;
+            jitter_.record(off < 0 ? -off : off);
+        }
+        last_begin_ = now;
+        begun_ = true;
+        begin_ = now;
+        if (policy_ == MissPolicy::Skip && late >= period_) {
+            const int64_t passed = late / period_;
+            skipped_.fetch_add(static_cast<uint64_t>(passed), std::memory_order_relaxed);
+            release_ += passed * period_;
+        }
+        release_ += period_;
+        deadline_ = release_; // of the release this iteration stands for, after any skip
+    }
+
+    // The iteration finished now.
+    void end(int64_t now) {
+        const int64_t run = now - begin_;
+        run_.record(run);
+        if (run > period_) overruns_.fetch_add(1, std::memory_order_relaxed);
+        if (now > deadline_) misses_.fetch_add(1, std::memory_order_relaxed);
+        iterations_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int64_t period_ns() const { return period_; }
+    MissPolicy policy() const { return policy_; }
+    const char* policy_name() const { return policy_ == MissPolicy::Skip ? "skip" : "catchup"; }
+    // "catchup" or "skip"; false (and no change) otherwise. Before start().
+    bool set_policy(const char* name);
+
+    uint64_t iterations() const { return iterations_.load(std::memory_order_relaxed); }
+    uint64_t overruns() const { return overruns_.load(std::memory_order_relaxed); } // run time > period
+    uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }     // finished after deadline
+    uint64_t skipped() const { return skipped_.load(std::memory_order_relaxed); }   // releases dropped (Skip)
+
+    const LatencyHistogram& lateness() const { return lateness_; } // release -> begin
+    const LatencyHistogram& run_time() const { return run_; }      // begin -> end
+    const LatencyHistogram& jitter() const { return jitter_; }     // |begin-to-begin interval - period|
+
+    // Summary ("name,value" rows), a blank line, then "series,lower_ns,upper_ns,count" for every
+    // non-empty bucket of lateness, run_time and jitter. False if writing failed.
+    bool write_csv(std::FILE* out) const;
+
+private:
+    const int64_t period_;
+    MissPolicy policy_;
+    bool started_{false};
+    int64_t release_{0};
+    int64_t deadline_{0};
+    int64_t begin_{0};
+    int64_t last_begin_{0};
+    bool begun_{false};
+    LatencyHistogram lateness_;
+    LatencyHistogram run_;
+    LatencyHistogram jitter_;
+    std::atomic<uint64_t> iterations_{0};
+    std::atomic<uint64_t> overruns_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> skipped_{0};
+};
+
+} // namespace industrial
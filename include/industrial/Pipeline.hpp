@@ -0,0 +1,502 @@
+/**
+ * @file industrial/Pipeline.hpp
+ * @brief Stage-graph runtime: stages connected by bounded SpscRing links, each run by an assigned thread.
+ *
+ * The topology is declared once, before start():
+ *
+ *   Link<SensorSample, 256> raw(LinkBase::Overflow::DropOldest);
+ *   Link<Reading, 256> readings;
+ *   Pipeline pipe;
+ *   pipe.source("sensor", sensor_stage, raw, 0);                 // thread 0
+ *   pipe.transform("average", raw, average_stage, readings, 1);  // thread 1
+ *   pipe.sink("publish", readings, publish_stage, 1);            // thread 1 as well
+ *   pipe.start();
+ *
+ * Stages are plain classes with a duck-typed interface (no virtual calls, like the sinks):
+ *   source     Step produce(Out& out, int64_t& wait_ns)  Busy: out was filled; Idle: nothing yet (lower
+ *              wait_ns to when there will be, e.g. the next sampling instant); Done: exhausted
+ *   transform  bool process(const In& in, Out& out)      false filters the item out (decimation, deadband)
+ *   sink       void consume(const In& in)
+ *   optional   void finish()                             once, after the last item (flush partial batches)
+ *
+ * Each thread runs its stages in turn, up to kPipelineBatch items per turn, and idles on its own
+ * AnyWait (futex park by default) when none of them has work; a link rings its consumer's thread on
+ * every push, so an idle thread wakes as soon as an item arrives. A finished stage closes its output
+ * and the next stage finishes once that input is closed and drained, so the pipeline empties itself
+ * from the sources down; stop() ends the sources early the same way.
+ *
+ * Links are bounded. Overflow::Block (default) makes the producing stage wait while the link is full,
+ * so back pressure travels upstream; Overflow::DropOldest never makes the producer wait, for sources
+ * that must keep real time. The producer never touches the consumer's side of the ring: past N items
+ * it files a drop request and the consumer discards that many of the oldest items before its next
+ * take. The ring has N spare slots for this; only if the consumer falls a further N items behind is
+ * the newest item refused. Every dropped item is counted exactly once, by whoever dropped it.
+ *
+ * Pipeline threads can run real-time (Realtime.hpp): realtime(thread, RtThread{cpu, priority}) before
+ * start() makes that thread pin itself, switch to SCHED_FIFO and prefault its stack as it starts, and
+ * start() prefaults every link first. rt_status(thread) reports what each step achieved.
+ *
+ * @note:
+ * - Observable while running: per stage items in/out, drops, waits for a full output, input
+ *   depth and high-water mark; per thread CPU time once it has finished.
+ * - Each link has exactly one producing and one consuming stage; declaring a second one fails.
+ * - No heap, no exceptions: stages and links belong to the caller and must outlive the threads.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "industrial/Config.hpp"
+#include "industrial/Realtime.hpp"
+#include "industrial/SpscRing.hpp"
+#include "industrial/WaitStrategy.hpp"
+
+namespace industrial {
+
+// What a stage did in one turn.
+enum class Step : uint8_t { Busy, Idle, Done };
+
+class Pipeline;
+
+// Type-independent half of a link: close flag, counters, and the consuming thread's wake-up.
+class LinkBase {
+public:
+    enum class Overflow : uint8_t { Block, DropOldest };
+
+    LinkBase(const LinkBase&) = delete;
+    LinkBase& operator=(const LinkBase&) = delete;
+
+    Overflow overflow() const { return overflow_; }
+    uint32_t capacity() const { return capacity_; }
+    uint32_t depth() const { return depth_(this); }
+    uint32_t high_water() const { return high_water_.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+    // SpscRing signal: forwards each push to the consuming thread's wait strategy.
+    void ring() {
+        if (wake_ != nullptr) wake_->ring();
+    }
+
+protected:
+    LinkBase(Overflow o, uint32_t capacity, uint32_t (*depth)(const LinkBase*), void* storage, std::size_t bytes)
+        : overflow_{o}, capacity_{capacity}, depth_{depth}, storage_{storage}, bytes_{bytes} {}
+
+    void note_depth(uint32_t d) {
+        if (d > high_water_.load(std::memory_order_relaxed)) high_water_.store(d, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> dropped_{0};
+
+private:
+    friend class Pipeline;
+
+    // Producer, after its last item: the consumer finishes once it has drained the rest.
+    void close() {
+        closed_.store(true, std::memory_order_release);
+        ring();
+    }
+
+    const Overflow overflow_;
+    const uint32_t capacity_;
+    uint32_t (*const depth_)(const LinkBase*);
+    void* const storage_;     // the whole Link, for prefaulting
+    const std::size_t bytes_;
+    std::atomic<uint32_t> high_water_{0};
+    std::atomic<bool> closed_{false};
+    AnyWait* wake_{nullptr};
+    bool has_producer_{false};
+    bool has_consumer_{false};
+};
+
+// Bounded queue of T between two stages.
+template <typename T, uint32_t N>
+class Link : public LinkBase {
+public:
+    explicit Link(Overflow o = Overflow::Block) : LinkBase(o, N, &depth_of, this, sizeof(Link)) {
+        ring_.set_signal(this);
+    }
+
+    bool full() const { return ring_.size() >= N; }
+
+    // Producing stage only; a Block link only while !full(). Past N items (DropOldest) the consumer is
+    // asked to drop the oldest one; with the spare slots exhausted too, v itself is refused.
+    void put(const T& v) {
+        if (!ring_.try_push(v)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        const uint32_t size = ring_.size();
+        if (size > N) drop_requests_.fetch_add(1, std::memory_order_release);
+        note_depth(size < N ? size : N);
+    }
+    // Consuming stage only: discards the oldest items the producer asked for, then takes the next one.
+    bool take(T& v) {
+        const uint64_t requested = drop_requests_.load(std::memory_order_acquire);
+        uint64_t done = drops_done_.load(std::memory_order_relaxed);
+        while (done < requested && ring_.try_pop(v)) {
+            ++done;
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+        drops_done_.store(requested, std::memory_order_relaxed); // requests beyond what was queued lapse
+        return ring_.try_pop(v);
+    }
+
+private:
+    // Items the consumer will still take (pending drops excluded)
+    static uint32_t depth_of(const LinkBase* l) {
+        const Link& k = *static_cast<const Link*>(l);
+        const uint64_t pending = k.drop_requests_.load(std::memory_order_relaxed) -
+                                 k.drops_done_.load(std::memory_order_relaxed);
+        const uint32_t size = k.ring_.size();
+        return pending < size ? static_cast<uint32_t>(size - pending) : 0;
+    }
+
+    SpscRing<T, 2 * N, LinkBase> ring_;      // N items plus N spare slots for DropOldest
+    std::atomic<uint64_t> drop_requests_{0}; // producer-only writer
+    std::atomic<uint64_t> drops_done_{0};    // consumer-only writer
+};
+
+class Pipeline {
+public:
+    struct StageStats {
+        const char* name;
+        uint32_t thread;
+        uint64_t in;          // items taken from the input
+        uint64_t out;         // items put on the output
+        uint64_t dropped;     // items dropped from the output (Overflow::DropOldest)
+        uint64_t blocked;     // times it found its output full and had to wait (Overflow::Block)
+        uint32_t depth;       // items waiting on the input (0 for sources)
+        uint32_t capacity;    // input capacity (0 for sources)
+        uint32_t high_water;  // deepest the input has been
+        bool done;
+    };
+
+    Pipeline() = default;
+    ~Pipeline() {
+        stop();
+        join();
+    }
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    // Topology, before start(). False if the stage table is full, thread >= kPipelineMaxThreads, the
+    // pipeline runs already, or a link already has its producer (output) / consumer (input).
+    template <typename S, typename Out, uint32_t N>
+    bool source(const char* name, S& stage, Link<Out, N>& out, uint32_t thread) {
+        Node* n = add(name, &stage, nullptr, &out, thread);
+        if (n == nullptr) return false;
+        n->step = &step_source<S, Out, N>;
+        n->finish = finisher<S>();
+        return true;
+    }
+    template <typename In, uint32_t NI, typename S, typename Out, uint32_t NO>
+    bool transform(const char* name, Link<In, NI>& in, S& stage, Link<Out, NO>& out, uint32_t thread) {
+        Node* n = add(name, &stage, &in, &out, thread);
+        if (n == nullptr) return false;
+        n->step = &step_transform<In, NI, S, Out, NO>;
+        n->finish = finisher<S>();
+        return true;
+    }
+    template <typename In, uint32_t N, typename S>
+    bool sink(const char* name, Link<In, N>& in, S& stage, uint32_t thread) {
+        Node* n = add(name, &stage, &in, nullptr, thread);
+        if (n == nullptr) return false;
+        n->step = &step_sink<In, N, S>;
+        n->finish = finisher<S>();
+        return true;
+    }
+
+    // Idle strategy of one thread (default park); select before start().
+    AnyWait& wait(uint32_t thread) { return waits_[thread < kPipelineMaxThreads ? thread : 0]; }
+
+    // Real-time settings of one thread, applied by the thread itself when it starts. False if the
+    // pipeline runs already or thread >= kPipelineMaxThreads.
+    bool realtime(uint32_t thread, const RtThread& rt) {
+        if (started_ || thread >= kPipelineMaxThreads) return false;
+        rt_[thread] = rt;
+        return true;
+    }
+    // What realtime() achieved on a thread; requested is false until the thread has applied it.
+    RtStatus rt_status(uint32_t thread) const {
+        if (thread >= kPipelineMaxThreads || !rt_applied_[thread].load(std::memory_order_acquire)) return RtStatus{};
+        return rt_status_[thread];
+    }
+
+    // Starts one thread per thread index in use. False if already started, empty, or a link lacks a
+    // producer or a consumer.
+    bool start() {
+        if (started_ || count_ == 0) return false;
+        for (uint32_t i = 0; i < count_; ++i) {
+            const Node& n = nodes_[i];
+            if ((n.in != nullptr && !n.in->has_producer_) || (n.out != nullptr && !n.out->has_consumer_))
+                return false;
+        }
+        for (uint32_t i = 0; i < count_; ++i)
+            if (nodes_[i].in != nullptr) nodes_[i].in->wake_ = &waits_[nodes_[i].thread];
+        bool rt = false;
+        for (uint32_t t = 0; t < kPipelineMaxThreads; ++t)
+            rt = rt || (used_[t] && (rt_[t].cpu >= 0 || rt_[t].priority > 0));
+        for (uint32_t i = 0; rt && i < count_; ++i) // no first-touch faults on ring pages once running
+            if (nodes_[i].out != nullptr) rt_prefault(nodes_[i].out->storage_, nodes_[i].out->bytes_);
+        started_ = true;
+        t0_ = std::chrono::steady_clock::now();
+        for (uint32_t t = 0; t < kPipelineMaxThreads; ++t) {
+            if (!used_[t]) continue;
+            ++threads_used_;
+            threads_[t] = std::thread([this, t] { run(t); });
+        }
+        return true;
+    }
+
+    // Ends the sources now; everything already queued still flows through and is finished.
+    void stop() {
+        stop_.store(true, std::memory_order_release);
+        for (uint32_t t = 0; t < kPipelineMaxThreads; ++t)
+            if (used_[t]) waits_[t].ring();
+    }
+
+    // True once every stage has finished; waits up to timeout for that.
+    template <typename Rep, typename Period>
+    bool wait_for(std::chrono::duration<Rep, Period> timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!done() && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return done();
+    }
+    bool done() const { return started_ && threads_done_.load(std::memory_order_acquire) == threads_used_; }
+
+    void join() {
+        for (auto& th : threads_)
+            if (th.joinable()) th.join();
+    }
+
+    uint32_t size() const { return count_; }
+    StageStats stats(uint32_t i) const {
+        const Node& n = nodes_[i];
+        StageStats s{};
+        s.name = n.name;
+        s.thread = n.thread;
+        s.in = n.in_items.load(std::memory_order_relaxed);
+        s.out = n.out_items.load(std::memory_order_relaxed);
+        s.dropped = n.out != nullptr ? n.out->dropped() : 0;
+        s.blocked = n.blocked.load(std::memory_order_relaxed);
+        if (n.in != nullptr) {
+            s.depth = n.in->depth();
+            s.capacity = n.in->capacity();
+            s.high_water = n.in->high_water();
+        }
+        s.done = n.finished.load(std::memory_order_acquire);
+        return s;
+    }
+    // Since start(), until the last thread finished.
+    int64_t elapsed_ns() const {
+        if (!started_) return 0;
+        if (done()) return end_ns_.load(std::memory_order_relaxed);
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0_).count();
+    }
+    // CPU time a thread used; valid once it has finished.
+    int64_t thread_cpu_ns(uint32_t thread) const {
+        return thread < kPipelineMaxThreads ? cpu_ns_[thread].load(std::memory_order_relaxed) : 0;
+    }
+
+private:
+    struct Node {
+        const char* name{nullptr};
+        void* stage{nullptr};
+        LinkBase* in{nullptr};
+        LinkBase* out{nullptr};
+        Step (*step)(Node&, int64_t&){nullptr};
+        void (*finish)(void*){nullptr};
+        const std::atomic<bool>* stop{nullptr};
+        uint32_t thread{0};
+        bool done{false};     // owned by the stage's thread
+        bool blocking{false}; // waiting for room on the output; owned by the stage's thread
+        std::atomic<bool> finished{false};
+        std::atomic<uint64_t> in_items{0};
+        std::atomic<uint64_t> out_items{0};
+        std::atomic<uint64_t> blocked{0};
+    };
+
+    template <typename S, typename = void>
+    struct HasFinish : std::false_type {};
+    template <typename S>
+    struct HasFinish<S, std::void_t<decltype(std::declval<S&>().finish())>> : std::true_type {};
+
+    template <typename S>
+    static void finish_stage(void* s) {
+        static_cast<S*>(s)->finish();
+    }
+    template <typename S>
+    static void (*finisher())(void*) {
+        if constexpr (HasFinish<S>::value) {
+            return &finish_stage<S>;
+        } else {
+            return nullptr;
+        }
+    }
+
+    Node* add(const char* name, void* stage, LinkBase* in, LinkBase* out, uint32_t thread) {
+        if (started_ || count_ == kPipelineMaxStages || thread >= kPipelineMaxThreads) return nullptr;
+        if ((in != nullptr && in->has_consumer_) || (out != nullptr && out->has_producer_)) return nullptr;
+        Node& n = nodes_[count_++];
+        n.name = name;
+        n.stage = stage;
+        n.in = in;
+        n.out = out;
+        n.stop = &stop_;
+        n.thread = thread;
+        if (in != nullptr) in->has_consumer_ = true;
+        if (out != nullptr) out->has_producer_ = true;
+        used_[thread] = true;
+        return &n;
+    }
+
+    // Room for one more item on a Block output; otherwise retry after kPipelineBlockedNs.
+    static bool room(Node& n, const LinkBase& out, bool full, int64_t& wait_ns) {
+        if (!full || out.overflow() == LinkBase::Overflow::DropOldest) {
+            n.blocking = false;
+            return true;
+        }
+        if (!n.blocking) n.blocked.fetch_add(1, std::memory_order_relaxed);
+        n.blocking = true;
+        if (wait_ns > kPipelineBlockedNs) wait_ns = kPipelineBlockedNs;
+        return false;
+    }
+
+    template <typename S, typename Out, uint32_t N>
+    static Step step_source(Node& n, int64_t& wait_ns) {
+        S& stage = *static_cast<S*>(n.stage);
+        auto& out = *static_cast<Link<Out, N>*>(n.out);
+        for (uint32_t k = 0; k < kPipelineBatch; ++k) {
+            if (n.stop->load(std::memory_order_acquire)) return Step::Done;
+            if (!room(n, out, out.full(), wait_ns)) return k > 0 ? Step::Busy : Step::Idle;
+            Out item;
+            const Step s = stage.produce(item, wait_ns);
+            if (s == Step::Done) return Step::Done;
+            if (s == Step::Idle) return k > 0 ? Step::Busy : Step::Idle;
+            out.put(item);
+            n.out_items.fetch_add(1, std::memory_order_relaxed);
+        }
+        return Step::Busy;
+    }
+
+    // Next input item; Done once the input is closed and empty (closed is read before the last try).
+    template <typename In, uint32_t N>
+    static Step next(Link<In, N>& in, In& item) {
+        if (in.take(item)) return Step::Busy;
+        if (!in.closed()) return Step::Idle;
+        return in.take(item) ? Step::Busy : Step::Done;
+    }
+
+    template <typename In, uint32_t NI, typename S, typename Out, uint32_t NO>
+    static Step step_transform(Node& n, int64_t& wait_ns) {
+        S& stage = *static_cast<S*>(n.stage);
+        auto& in = *static_cast<Link<In, NI>*>(n.in);
+        auto& out = *static_cast<Link<Out, NO>*>(n.out);
+        for (uint32_t k = 0; k < kPipelineBatch; ++k) {
+            if (!room(n, out, out.full(), wait_ns)) return k > 0 ? Step::Busy : Step::Idle;
+            In item;
+            const Step s = next(in, item);
+            if (s == Step::Done) return Step::Done;
+            if (s == Step::Idle) return k > 0 ? Step::Busy : Step::Idle;
+            n.in_items.fetch_add(1, std::memory_order_relaxed);
+            Out result;
+            if (stage.process(static_cast<const In&>(item), result)) {
+                out.put(result);
+                n.out_items.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        return Step::Busy;
+    }
+
+    template <typename In, uint32_t N, typename S>
+    static Step step_sink(Node& n, int64_t&) {
+        S& stage = *static_cast<S*>(n.stage);
+        auto& in = *static_cast<Link<In, N>*>(n.in);
+        for (uint32_t k = 0; k < kPipelineBatch; ++k) {
+            In item;
+            const Step s = next(in, item);
+            if (s == Step::Done) return Step::Done;
+            if (s == Step::Idle) return k > 0 ? Step::Busy : Step::Idle;
+            n.in_items.fetch_add(1, std::memory_order_relaxed);
+            stage.consume(static_cast<const In&>(item));
+        }
+        return Step::Busy;
+    }
+
+    // Something to do for a stage of this thread (re-checked by parking waits after they announce the sleep)
+    bool ready(uint32_t t) const {
+        for (uint32_t i = 0; i < count_; ++i) {
+            const Node& n = nodes_[i];
+            if (n.thread != t || n.done) continue;
+            if (n.in == nullptr ? stop_.load(std::memory_order_relaxed) : (n.in->depth() > 0 || n.in->closed()))
+                return true;
+        }
+        return false;
+    }
+
+    void run(uint32_t t) {
+        rt_status_[t] = rt_apply(rt_[t]);
+        rt_applied_[t].store(true, std::memory_order_release);
+        AnyWait& w = waits_[t];
+        for (;;) {
+            bool live = false;
+            bool busy = false;
+            int64_t wait_ns = kPipelineMaxIdleNs;
+            for (uint32_t i = 0; i < count_; ++i) {
+                Node& n = nodes_[i];
+                if (n.thread != t || n.done) continue;
+                const Step s = n.step(n, wait_ns);
+                if (s == Step::Done) {
+                    if (n.finish != nullptr) n.finish(n.stage);
+                    if (n.out != nullptr) n.out->close();
+                    n.done = true;
+                    n.finished.store(true, std::memory_order_release);
+                    busy = true; // a stage after it on this thread may be able to finish now
+                    continue;
+                }
+                live = true;
+                busy = busy || s == Step::Busy;
+            }
+            if (!live) break;
+            if (busy) {
+                w.reset();
+                continue;
+            }
+            w.idle([&] { return ready(t); }, wait_ns);
+        }
+        timespec cpu{};
+        ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu);
+        cpu_ns_[t].store((int64_t)cpu.tv_sec * 1000000000 + cpu.tv_nsec, std::memory_order_relaxed);
+        const int64_t end =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0_).count();
+        if (end > end_ns_.load(std::memory_order_relaxed)) end_ns_.store(end, std::memory_order_relaxed);
+        threads_done_.fetch_add(1, std::memory_order_release);
+    }
+
+    Node nodes_[kPipelineMaxStages];
+    uint32_t count_{0};
+    bool used_[kPipelineMaxThreads]{};
+    AnyWait waits_[kPipelineMaxThreads];
+    std::thread threads_[kPipelineMaxThreads];
+    std::atomic<int64_t> cpu_ns_[kPipelineMaxThreads]{};
+    RtThread rt_[kPipelineMaxThreads];
+    RtStatus rt_status_[kPipelineMaxThreads];
+    std::atomic<bool> rt_applied_[kPipelineMaxThreads]{};
+    uint32_t threads_used_{0};
+    std::atomic<uint32_t> threads_done_{0};
+    std::atomic<bool> stop_{false};
+    bool started_{false};
+    std::chrono::steady_clock::time_point t0_{};
+    std::atomic<int64_t> end_ns_{0}; // last thread's finish, since t0_
+};
+
+} // namespace industrial
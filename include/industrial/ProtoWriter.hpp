@@ -0,0 +1,136 @@
+/**
+ * @file industrial/ProtoWriter.hpp
+ * @brief Minimal protocol-buffers wire-format writer into a caller-provided buffer.
+ *
+ * Writes varint, fixed32/fixed64 and length-delimited fields in proto2/proto3 wire format without
+ * a schema compiler or runtime. Nested messages are written in place: begin() reserves one length
+ * byte and end() patches it, shifting the body only in the rare case it exceeds 127 bytes.
+ *
+ * @note:
+ * - No heap, no exceptions. Running out of space sets ok() to false; later writes are ignored.
+ * - Fields are emitted in call order; callers are responsible for schema correctness.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace industrial {
+
+class ProtoWriter {
+public:
+    enum WireType : uint32_t { kVarint = 0, kFixed64 = 1, kLengthDelimited = 2, kFixed32 = 5 };
+
+    ProtoWriter(uint8_t* buf, size_t cap) : buf_{buf}, cap_{cap} {}
+
+    void varint(uint32_t field, uint64_t v) {
+        tag(field, kVarint);
+        raw_varint(v);
+    }
+    void boolean(uint32_t field, bool v) { varint(field, v ? 1u : 0u); }
+    void fixed32(uint32_t field, uint32_t v) {
+        tag(field, kFixed32);
+        raw_le(v, 4);
+    }
+    void fixed64(uint32_t field, uint64_t v) {
+        tag(field, kFixed64);
+        raw_le(v, 8);
+    }
+    void float32(uint32_t field, float v) {
+        uint32_t u;
+        std::memcpy(&u, &v, sizeof(u));
+        fixed32(field, u);
+    }
+    void double64(uint32_t field, double v) {
+        uint64_t u;
+        std::memcpy(&u, &v, sizeof(u));
+        fixed64(field, u);
+    }
+    void bytes(uint32_t field, const void* p, size_t n) {
+        tag(field, kLengthDelimited);
+        raw_varint(n);
+        raw(p, n);
+    }
+    void string(uint32_t field, std::string_view s) { bytes(field, s.data(), s.size()); }
+
+    // Nested message: size_t m = begin(field); ...fields...; end(m);
+    size_t begin(uint32_t field) {
+        tag(field, kLengthDelimited);
+        const size_t mark = pos_;
+        raw_byte(0);
+        return mark;
+    }
+    void end(size_t mark) {
+        if (!ok_) return;
+        const size_t len = pos_ - mark - 1;
+        const size_t n = varint_size(len);
+        if (n > 1) {
+            if (pos_ + n - 1 > cap_) {
+                ok_ = false;
+                return;
+            }
+            std::memmove(buf_ + mark + n, buf_ + mark + 1, len);
+            pos_ += n - 1;
+        }
+        size_t p = mark;
+        uint64_t v = len;
+        while (v >= 0x80u) {
+            buf_[p++] = static_cast<uint8_t>(v | 0x80u);
+            v >>= 7;
+        }
+        buf_[p] = static_cast<uint8_t>(v);
+    }
+
+    bool ok() const { return ok_; }
+    size_t size() const { return pos_; }
+
+    static constexpr size_t varint_size(uint64_t v) {
+        size_t n = 1;
+        while (v >= 0x80u) {
+            v >>= 7;
+            ++n;
+        }
+        return n;
+    }
+
+private:
+    void tag(uint32_t field, WireType wt) { raw_varint((uint64_t(field) << 3) | wt); }
+    void raw_varint(uint64_t v) {
+        while (v >= 0x80u) {
+            raw_byte(static_cast<uint8_t>(v | 0x80u));
+            v >>= 7;
+        }
+        raw_byte(static_cast<uint8_t>(v));
+    }
+    void raw_le(uint64_t v, size_t n) {
+        if (!ok_ || pos_ + n > cap_) {
+            ok_ = false;
+            return;
+        }
+        for (size_t i = 0; i < n; ++i) buf_[pos_++] = static_cast<uint8_t>(v >> (8 * i));
+    }
+    void raw_byte(uint8_t b) {
+        if (!ok_ || pos_ >= cap_) {
+            ok_ = false;
+            return;
+        }
+        buf_[pos_++] = b;
+    }
+    void raw(const void* p, size_t n) {
+        if (!ok_ || pos_ + n > cap_) {
+            ok_ = false;
+            return;
+        }
+        std::memcpy(buf_ + pos_, p, n);
+        pos_ += n;
+    }
+
+    uint8_t* buf_;
+    size_t cap_;
+    size_t pos_{0};
+    bool ok_{true};
+};
+
+} // namespace industrial
@@ -0,0 +1,128 @@
+/**
+ * @file industrial/Realtime.hpp
+ * @brief Optional real-time setup for acquisition threads: CPU pinning, SCHED_FIFO, prefaulting, mlockall.
+ *
+ * Sampling jitter on a loaded gateway comes from three places: the scheduler migrating the thread or
+ * letting ordinary work run first, and page faults on the first touch of a stack or ring page. Each
+ * call below removes one of them and reports whether it worked, so a process without privileges
+ * (no CAP_SYS_NICE / CAP_IPC_LOCK, RLIMIT_RTPRIO or RLIMIT_MEMLOCK too low) keeps running as before:
+ *
+ *   rt_lock_memory()              mlockall(MCL_CURRENT | MCL_FUTURE): nothing of the process is paged out
+ *   rt_prefault(p, bytes)         write-touch every page of a buffer (rings), before other threads use it
+ *   rt_apply(RtThread{cpu, prio}) on the thread itself: pin to cpu, SCHED_FIFO at prio, prefault its stack
+ *
+ * Pipeline::realtime(thread, rt) applies the per-thread part when its thread starts.
+ *
+ * @note:
+ * - SCHED_FIFO threads run until they block: only use it with waits that sleep (event, park, backoff,
+ *   sleep), never with spin/yield on a CPU that other threads need.
+ * - Results carry the errno of the failed call (0 on success); nothing throws, nothing allocates.
+ */
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "industrial/Config.hpp"
+
+namespace industrial {
+
+// Per-thread request; the defaults change nothing.
+struct RtThread {
+    int cpu{-1};                                    // pin to this CPU; -1: leave the affinity alone
+    int priority{0};                                // SCHED_FIFO priority (1..99); 0: keep SCHED_OTHER
+    std::size_t stack_bytes{kRtStackPrefaultBytes}; // stack to prefault when anything else is requested
+};
+
+// What rt_apply() achieved; the *_err fields hold the errno of a failed step, 0 otherwise.
+struct RtStatus {
+    bool requested{false};
+    bool pinned{false};
+    bool fifo{false};
+    bool stack{false};
+    int cpu{-1};
+    int priority{0};
+    int pin_err{0};
+    int fifo_err{0};
+};
+
+// Locks current and future pages in RAM; returns 0 or the errno of mlockall.
+inline int rt_lock_memory() { return ::mlockall(MCL_CURRENT | MCL_FUTURE) == 0 ? 0 : errno; }
+
+// Makes every page of [p, p + bytes) resident by rewriting one byte per page with its own value.
+// Only while no other thread uses the buffer.
+inline void rt_prefault(void* p, std::size_t bytes) {
+    volatile unsigned char* b = static_cast<volatile unsigned char*>(p);
+    const long page = ::sysconf(_SC_PAGESIZE);
+    const std::size_t step = page > 0 ? static_cast<std::size_t>(page) : 4096;
+    for (std::size_t i = 0; i < bytes; i += step) b[i] = b[i];
+    if (bytes > 0) b[bytes - 1] = b[bytes - 1];
+}
+
+// Grows the calling thread's stack by bytes and touches it, so later calls do not fault on it.
+__attribute__((noinline)) inline void rt_prefault_stack(std::size_t bytes) {
+    constexpr std::size_t kChunk = 16 * 1024;
+    volatile unsigned char buf[kChunk];
+    for (std::size_t i = 0; i < kChunk; i += 1024) buf[i] = 0;
+    asm volatile("" : : "r"(buf) : "memory"); // the stores count; keeps -Wunused-but-set-variable quiet
+    if (bytes > kChunk) rt_prefault_stack(bytes - kChunk);
+}
+
+// Number of CPUs this process may run on.
+inline int rt_cpu_count() {
+    cpu_set_t set;
+    if (::sched_getaffinity(0, sizeof(set), &set) != 0) return 1;
+    const int n = CPU_COUNT(&set);
+    return n > 0 ? n : 1;
+}
+
+// Applies rt to the calling thread. Each step is independent: a failed one is recorded and skipped.
+inline RtStatus rt_apply(const RtThread& rt) {
+    RtStatus s;
+    s.cpu = rt.cpu;
+    s.priority = rt.priority;
+    s.requested = rt.cpu >= 0 || rt.priority > 0;
+    if (!s.requested) return s;
+    if (rt.cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(rt.cpu, &set);
+        s.pin_err = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+        s.pinned = s.pin_err == 0;
+    }
+    if (rt.priority > 0) {
+        sched_param sp{};
+        sp.sched_priority = rt.priority;
+        s.fifo_err = ::pthread_setschedparam(::pthread_self(), SCHED_FIFO, &sp);
+        s.fifo = s.fifo_err == 0;
+    }
+    if (rt.stack_bytes > 0) {
+        rt_prefault_stack(rt.stack_bytes);
+        s.stack = true;
+    }
+    return s;
+}
+
+// Parses "0,2,3" into cpus[]; returns how many were read (stops at max or the first bad entry).
+inline uint32_t rt_parse_cpus(const char* list, int* cpus, uint32_t max) {
+    uint32_t n = 0;
+    const char* p = list;
+    while (p != nullptr && n < max) {
+        char* end = nullptr;
+        const long v = std::strtol(p, &end, 10);
+        if (end == p || v < 0 || v >= CPU_SETSIZE) break;
+        cpus[n++] = static_cast<int>(v);
+        if (*end != ',') break;
+        p = end + 1;
+    }
+    return n;
+}
+
+} // namespace industrial
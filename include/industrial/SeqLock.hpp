@@ -0,0 +1,75 @@
+/**
+ * @file industrial/SeqLock.hpp
+ * @brief Single-writer sequence lock: readers get a consistent copy of the latest value without blocking the writer.
+ *
+ * The writer bumps the sequence to odd, stores the value, and bumps it to even again. A reader copies
+ * the value between two sequence loads and retries if the sequence was odd or changed meanwhile.
+ * The writer never waits; readers only retry while a store overlaps their copy.
+ *
+ * @note:
+ * - Template: SeqLock<T>; T must be trivially copyable. It is kept as relaxed 64-bit atomic words,
+ *   so a racing copy is never a data race, only a torn copy that the sequence check discards.
+ * - Exactly one writer thread; any number of readers.
+ * - seq() counts completed stores (sequence / 2): readers can tell whether anything new arrived.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace industrial {
+
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires trivially copyable T");
+
+public:
+    SeqLock() {
+        for (auto& w : words_) w.store(0, std::memory_order_relaxed);
+    }
+    explicit SeqLock(const T& v) : SeqLock() { store(v); }
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    // Writer only.
+    void store(const T& v) {
+        uint64_t tmp[kWords] = {};
+        std::memcpy(tmp, &v, sizeof(T));
+        const uint64_t s = seq_.load(std::memory_order_relaxed);
+        seq_.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release); // odd sequence visible before any word
+        for (uint32_t i = 0; i < kWords; ++i) words_[i].store(tmp[i], std::memory_order_relaxed);
+        seq_.store(s + 2, std::memory_order_release); // words visible before the even sequence
+    }
+
+    // Any thread; spins only while a store is in progress.
+    T load() const {
+        T out;
+        while (!try_load(out)) {}
+        return out;
+    }
+
+    // One attempt: false if a store overlapped the copy.
+    bool try_load(T& out) const {
+        uint64_t tmp[kWords];
+        const uint64_t s0 = seq_.load(std::memory_order_acquire);
+        if (s0 & 1u) return false;
+        for (uint32_t i = 0; i < kWords; ++i) tmp[i] = words_[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire); // word loads complete before the re-check
+        if (seq_.load(std::memory_order_relaxed) != s0) return false;
+        std::memcpy(&out, tmp, sizeof(T));
+        return true;
+    }
+
+    uint64_t seq() const { return seq_.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr uint32_t kWords = static_cast<uint32_t>((sizeof(T) + 7) / 8);
+
+    alignas(64) std::atomic<uint64_t> seq_{0};
+    std::atomic<uint64_t> words_[kWords];
+};
+
+} // namespace industrial
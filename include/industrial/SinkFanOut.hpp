@@ -0,0 +1,254 @@
+/**
+ * @file industrial/SinkFanOut.hpp
+ * @brief Fans encoded payload handles out to several sinks, each running on its own thread.
+ *
+ * @tparam Pool  PayloadPool instantiation holding the encoded bytes.
+ * @tparam Sinks Sink types (see industrial/Sinks.hpp); bound at compile time, no virtual calls.
+ *
+ * @note:
+ * - submit() never copies payload bytes: it takes one pool reference per enabled sink and pushes
+ *   the handle into that sink's SpscRing. The sink thread writes and releases; the last release
+ *   recycles the buffer. A slow sink only ever delays itself.
+ * - A full sink queue refuses the handle (try_push) and counts it as dropped for that sink.
+ * - Each submit() picks a lane:
+ *   - Bulk (default): the FIFO queue described above.
+ *   - Latest: latest-value messages. Each sink keeps at most one pending handle per topic
+ *     (ConflatingQueue), a newer one replaces it (counted as conflated), and topics are drained
+ *     round-robin. Under backpressure the sink sends the freshest value of every topic instead of a
+ *     backlog; memory stays bounded by kConflateMaxTopics.
+ *   - Priority: alarms and events. A small ring (kPriorityQueueCapacity) that the worker drains
+ *     before every Bulk/Latest write, so an alarm waits for at most the write in progress, never
+ *     for a telemetry backlog. Frames from it carry priority=true (e.g. MQTT QoS/retain per lane)
+ *     and their submit-to-written latency is recorded per sink (priority_latency()).
+ *   The worker alternates between Bulk and Latest, so neither of those starves the other.
+ * - Exactly one thread may call submit(). Sinks are enabled individually before start();
+ *   stop() lets every worker drain its queue first.
+ * - Per-sink counters and queue depth are lock-free reads.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+#include "industrial/Config.hpp"
+#include "industrial/ConflatingQueue.hpp"
+#include "industrial/LatencyHistogram.hpp"
+#include "industrial/Sinks.hpp"
+#include "industrial/SpscRing.hpp"
+
+namespace industrial {
+
+template <typename Pool, typename... Sinks>
+class SinkFanOut {
+public:
+    using Handle = typename Pool::Handle;
+
+    enum class Lane : uint8_t { Bulk, Latest, Priority };
+
+    struct Stats {
+        uint64_t frames{0};  // written successfully
+        uint64_t bytes{0};
+        uint64_t failed{0};  // write() returned false
+        uint64_t dropped{0};   // queue (or conflating topic table) full at submit()
+        uint64_t conflated{0}; // replaced by a newer value of the same topic before being written
+        uint64_t priority{0};  // written from the priority lane (included in frames)
+        uint32_t depth{0};     // currently queued, all lanes (topics with a pending value count once)
+    };
+
+    SinkFanOut(Pool& pool, Sinks&... sinks) : pool_{pool}, workers_{sinks...} {}
+    ~SinkFanOut() { stop(); }
+    SinkFanOut(const SinkFanOut&) = delete;
+    SinkFanOut& operator=(const SinkFanOut&) = delete;
+
+    static constexpr size_t size() { return sizeof...(Sinks); }
+
+    void enable(size_t i, bool on) {
+        for_each_worker([&](auto& w, size_t idx) { if (idx == i) w.enabled = on; });
+    }
+
+    void start() {
+        if (running_.exchange(true)) return;
+        start_workers(std::index_sequence_for<Sinks...>{});
+    }
+
+    void stop() {
+        if (!running_.exchange(false)) return;
+        for_each_worker([](auto& w, size_t) { if (w.thread.joinable()) w.thread.join(); });
+    }
+
+    // Hand the caller's reference on h to every enabled sink, through the given lane.
+    void submit(Handle h, std::string_view topic, bool binary, Lane lane = Lane::Bulk) {
+        const int64_t t = lane == Lane::Priority ? now_ns() : 0;
+        const Ref r{h, static_cast<uint32_t>(topic.size()), topic.data(), binary, t};
+        uint32_t n = 0;
+        for_each_worker([&](auto& w, size_t) { n += w.enabled ? 1u : 0u; });
+        pool_.retain(h, n);
+        for_each_worker([&](auto& w, size_t) {
+            if (!w.enabled) return;
+            if (lane == Lane::Latest) {
+                Handle old = h;
+                switch (w.latest.push(topic, h, binary, old)) {
+                case Latest::Push::Queued:
+                    return;
+                case Latest::Push::Conflated:
+                    pool_.release(old);
+                    return;
+                case Latest::Push::Full:
+                    break;
+                }
+            } else if ((lane == Lane::Priority ? w.urgent.try_push(r) : w.queue.try_push(r))) {
+                return;
+            }
+            w.dropped.fetch_add(1, std::memory_order_relaxed);
+            pool_.release(h);
+        });
+        pool_.release(h);
+    }
+
+    Stats stats(size_t i) const {
+        Stats s{};
+        for_each_worker([&](const auto& w, size_t idx) {
+            if (idx != i) return;
+            s.frames = w.frames.load(std::memory_order_relaxed);
+            s.bytes = w.bytes.load(std::memory_order_relaxed);
+            s.failed = w.failed.load(std::memory_order_relaxed);
+            s.dropped = w.dropped.load(std::memory_order_relaxed);
+            s.conflated = w.latest.conflated();
+            s.priority = w.priority.load(std::memory_order_relaxed);
+            s.depth = w.queue.size() + w.latest.pending() + w.urgent.size();
+        });
+        return s;
+    }
+
+    // Submit-to-written latency of priority frames for sink i (ns); readable while running.
+    const LatencyHistogram& priority_latency(size_t i) const {
+        const LatencyHistogram* h = &std::get<0>(workers_).urgent_latency;
+        for_each_worker([&](const auto& w, size_t idx) { if (idx == i) h = &w.urgent_latency; });
+        return *h;
+    }
+
+    const char* name(size_t i) const {
+        const char* n = "";
+        for_each_worker([&](const auto& w, size_t idx) { if (idx == i) n = w.sink_name(); });
+        return n;
+    }
+
+    bool enabled(size_t i) const {
+        bool on = false;
+        for_each_worker([&](const auto& w, size_t idx) { if (idx == i) on = w.enabled; });
+        return on;
+    }
+
+private:
+    using Latest = ConflatingQueue<Handle, kConflateMaxTopics>;
+
+    struct Ref {
+        Handle handle;
+        uint32_t topic_len;
+        const char* topic; // must outlive the fan-out (long-lived topic strings)
+        bool binary;
+        int64_t submitted_ns; // priority lane only
+    };
+
+    static int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    template <typename Sink>
+    struct Worker {
+        explicit Worker(Sink& s) : sink{s} {}
+        const char* sink_name() const { return Sink::name(); }
+
+        Sink& sink;
+        bool enabled{false};
+        SpscRing<Ref, kSinkQueueCapacity> queue;
+        Latest latest;
+        SpscRing<Ref, kPriorityQueueCapacity> urgent;
+        LatencyHistogram urgent_latency;
+        std::thread thread;
+        std::atomic<uint64_t> frames{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> failed{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<uint64_t> priority{0};
+    };
+
+    template <typename Fn>
+    void for_each_worker(Fn&& fn) {
+        std::apply([&](auto&... w) { size_t i = 0; (fn(w, i++), ...); }, workers_);
+    }
+    template <typename Fn>
+    void for_each_worker(Fn&& fn) const {
+        std::apply([&](const auto&... w) { size_t i = 0; (fn(w, i++), ...); }, workers_);
+    }
+
+    template <size_t... I>
+    void start_workers(std::index_sequence<I...>) {
+        ((std::get<I>(workers_).enabled
+              ? (void)(std::get<I>(workers_).thread = std::thread([this] { run(std::get<I>(workers_)); }))
+              : (void)0),
+         ...);
+    }
+
+    template <typename W>
+    void deliver(W& w, Handle h, std::string_view topic, bool binary, bool priority = false) {
+        const Frame f{topic, pool_.data(h), pool_.len(h), binary, priority, PayloadRef(pool_, h)};
+        if (w.sink.write(f)) {
+            w.frames.fetch_add(1, std::memory_order_relaxed);
+            w.bytes.fetch_add(f.len, std::memory_order_relaxed);
+        } else {
+            w.failed.fetch_add(1, std::memory_order_relaxed);
+        }
+        pool_.release(h);
+    }
+
+    // Writes everything in the priority ring; true if there was anything.
+    template <typename W>
+    bool drain_urgent(W& w) {
+        Ref r;
+        bool any = false;
+        while (w.urgent.try_pop(r)) {
+            deliver(w, r.handle, std::string_view(r.topic, r.topic_len), r.binary, true);
+            w.urgent_latency.record(now_ns() - r.submitted_ns);
+            w.priority.fetch_add(1, std::memory_order_relaxed);
+            any = true;
+        }
+        return any;
+    }
+
+    template <typename W>
+    void run(W& w) {
+        Ref r;
+        typename Latest::Entry e;
+        for (;;) {
+            bool busy = drain_urgent(w);
+            if (w.queue.try_pop(r)) {
+                deliver(w, r.handle, std::string_view(r.topic, r.topic_len), r.binary);
+                busy = true;
+            }
+            busy |= drain_urgent(w); // recheck between the two lanes, too
+            if (w.latest.pop(e)) {
+                deliver(w, e.handle, e.topic, e.binary);
+                busy = true;
+            }
+            if (busy) continue;
+            if (!running_.load(std::memory_order_acquire)) break; // all lanes drained
+            w.sink.idle();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        w.sink.idle();
+    }
+
+    Pool& pool_;
+    std::tuple<Worker<Sinks>...> workers_;
+    std::atomic<bool> running_{false};
+};
+
+} // namespace industrial
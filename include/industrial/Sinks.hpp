@@ -0,0 +1,188 @@
+/**
+ * @file industrial/Sinks.hpp
+ * @brief Output sinks for encoded payloads: MQTT, UDP multicast, file, stdout and null.
+ *
+ * Sinks are plain classes sharing a duck-typed interface (the build uses -fno-rtti, so no virtual
+ * dispatch or dynamic_cast is involved; SinkFanOut binds them at compile time):
+ *   bool write(const Frame& f);   // deliver one payload; false counts as a failure
+ *   void idle();                  // called when the sink's queue is empty (flushing, retries)
+ *   static const char* name();
+ *
+ * @note:
+ * - A Frame only borrows its bytes; they belong to a PayloadPool buffer that the fan-out
+ *   releases after write() returns. A sink that needs them longer (MqttSink in Batched mode)
+ *   retains the buffer through Frame::ref instead of copying.
+ * - Each sink instance is driven by exactly one thread and is not thread-safe itself.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "industrial/Config.hpp"
+#include "industrial/PayloadRef.hpp"
+#include "industrial/TokenBucket.hpp"
+
+namespace industrial {
+
+class MqttPublisher;
+class Spool;
+
+struct Frame {
+    std::string_view topic;
+    const uint8_t* data{nullptr};
+    size_t len{0};
+    bool binary{false};   // text payloads are line-oriented; binary ones need framing
+    bool priority{false}; // from the fan-out's priority lane (alarms/events)
+    PayloadRef ref{};     // the buffer holding data, for sinks that keep it past write(); may be empty
+};
+
+// Discards everything; measures pipeline cost without I/O.
+class NullSink {
+public:
+    bool write(const Frame& f) {
+        bytes_ += f.len;
+        return true;
+    }
+    void idle() {}
+    static const char* name() { return "null"; }
+    uint64_t bytes() const { return bytes_; }
+
+private:
+    uint64_t bytes_{0};
+};
+
+// "<topic> <payload>" per line; binary payloads are summarized by size.
+class StdoutSink {
+public:
+    bool write(const Frame& f);
+    void idle();
+    static const char* name() { return "stdout"; }
+};
+
+// Appends payloads to a file through a large stdio buffer. Text payloads are written as lines;
+// binary payloads (e.g. Gorilla blocks) as [u32 little-endian length][bytes] records.
+class FileSink {
+public:
+    FileSink() = default;
+    ~FileSink();
+    FileSink(const FileSink&) = delete;
+    FileSink& operator=(const FileSink&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool is_open() const { return f_ != nullptr; }
+
+    bool write(const Frame& f);
+    void idle();
+    static const char* name() { return "file"; }
+
+private:
+    std::FILE* f_{nullptr};
+    bool dirty_{false};
+};
+
+// Publishes through MqttPublisher. Payloads that cannot be published go to the optional spool,
+// which idle() replays at drain_rate messages/s once the session is up. Without a spool, frames
+// written while there is no session (e.g. before the first background connect completes) are held
+// by reference, up to kMqttBacklogFrames with the oldest dropped first, and published in order
+// ahead of anything newer once the session is up.
+// Telemetry and priority frames (alarms) publish with their own QoS/retain; a priority frame is
+// also flushed at once in the pipelined/batched modes instead of waiting for a full batch.
+class MqttSink {
+public:
+    struct LaneOptions {
+        int qos{0};
+        bool retain{false};
+    };
+
+    MqttSink(MqttPublisher& mqtt, Spool* spool, double drain_rate, uint32_t drain_burst)
+        : mqtt_{mqtt}, spool_{spool}, drain_{drain_rate, drain_rate}, drain_burst_{drain_burst} {}
+    ~MqttSink();
+    MqttSink(const MqttSink&) = delete;
+    MqttSink& operator=(const MqttSink&) = delete;
+
+    void set_lanes(LaneOptions telemetry, LaneOptions priority) {
+        telemetry_ = telemetry;
+        priority_ = priority;
+    }
+
+    bool write(const Frame& f);
+    void idle();
+    static const char* name() { return "mqtt"; }
+
+    // Backlog of frames held while disconnected: currently held, published later, dropped (oldest).
+    uint32_t backlog() const { return backlog_len_; }
+    uint64_t backlog_replayed() const { return backlog_replayed_; }
+    uint64_t backlog_dropped() const { return backlog_dropped_; }
+
+private:
+    bool publish(const Frame& f);
+    bool hold(const Frame& f);
+    bool replay_backlog(); // true once the backlog is empty
+
+    MqttPublisher& mqtt_;
+    Spool* spool_;
+    TokenBucket drain_;
+    uint32_t drain_burst_;
+    LaneOptions telemetry_{};
+    LaneOptions priority_{1, false};
+
+    Frame backlog_[kMqttBacklogFrames];
+    uint32_t backlog_head_{0};
+    uint32_t backlog_len_{0};
+    uint64_t backlog_replayed_{0};
+    uint64_t backlog_dropped_{0};
+};
+
+// Sends each payload as one UDP datagram (e.g. OPC UA UADP NetworkMessages) to a multicast group
+// or unicast address. Pooled frames are not copied: the sink retains up to kUdpBatchDatagrams of
+// their buffers and hands them to the kernel with one sendmmsg() per batch, or earlier from idle()
+// when the queue runs dry, then releases them. A frame without a pool buffer (empty ref) is only
+// borrowed, so it goes out at once together with whatever is queued. Delivery is best-effort: a
+// failed send drops the batch and is counted, it is never retried.
+class UdpMulticastSink {
+public:
+    UdpMulticastSink() = default;
+    ~UdpMulticastSink();
+    UdpMulticastSink(const UdpMulticastSink&) = delete;
+    UdpMulticastSink& operator=(const UdpMulticastSink&) = delete;
+
+    // IPv4 destination; ttl and loopback apply to multicast groups only (IP_MULTICAST_TTL/LOOP).
+    // iface optionally selects the outgoing interface address for multicast.
+    bool open(const std::string& addr, uint16_t port, int ttl = 1, bool loopback = true, const char* iface = nullptr);
+    void close();
+    bool is_open() const { return fd_ >= 0; }
+
+    // Datagrams per sendmmsg(), clamped to [1, kUdpBatchDatagrams]; 1 degenerates to one syscall per frame.
+    void set_batch(uint32_t n) { batch_ = n < 1 ? 1 : (n > kUdpBatchDatagrams ? kUdpBatchDatagrams : n); }
+
+    bool write(const Frame& f);
+    void idle() { (void)flush(); }
+    bool flush();
+    static const char* name() { return "udp"; }
+
+    uint64_t datagrams() const { return datagrams_; }
+    uint64_t send_calls() const { return send_calls_; }
+    uint64_t send_errors() const { return send_errors_; }
+
+private:
+    int fd_{-1};
+    sockaddr_in dst_{};
+    uint32_t batch_{kUdpBatchDatagrams};
+    uint32_t queued_{0};
+    iovec iov_[kUdpBatchDatagrams]{};      // queued payloads, pointing into their pool buffers
+    PayloadRef refs_[kUdpBatchDatagrams]{}; // retained until the batch is sent
+    uint64_t datagrams_{0};
+    uint64_t send_calls_{0};
+    uint64_t send_errors_{0};
+};
+
+} // namespace industrial
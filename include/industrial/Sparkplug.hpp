@@ -0,0 +1,132 @@
+/**
+ * @file industrial/Sparkplug.hpp
+ * @brief Allocation-free Eclipse Sparkplug B payload encoder (NBIRTH, DBIRTH, NDATA, DDATA).
+ *
+ * Payloads follow the Sparkplug B protobuf schema (sparkplug_b.proto) and are written with
+ * ProtoWriter straight into a caller-provided buffer, so the protobuf runtime (exceptions, RTTI,
+ * heap) is not needed.
+ *
+ * Aliases: birth messages announce every metric with name, alias and datatype; data messages then
+ * carry only alias, timestamp and value, which is what keeps them small. Many metric values (e.g. a
+ * batch of samples, each with its own timestamp) may go into one data message.
+ *
+ * Sequencing (SparkplugSession): NBIRTH carries seq 0 and the bdSeq metric; every following message
+ * of the node takes the next seq (0..255, wrapping). After a reconnect, rebirth() bumps bdSeq and
+ * the births are sent again.
+ *
+ * @note:
+ * - No heap, no exceptions; encoders return 0 when the buffer is too small.
+ * - NDEATH is normally registered as the MQTT will; the in-tree client has no will support, so
+ *   consumers see the session end through the broker's keep-alive instead.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "industrial/ProtoWriter.hpp"
+
+namespace industrial {
+
+namespace sparkplug {
+
+// Subset of the Sparkplug B DataType enumeration used here
+enum class DataType : uint32_t {
+    Int32 = 3,
+    Int64 = 4,
+    UInt32 = 7,
+    UInt64 = 8,
+    Float = 9,
+    Double = 10,
+    Boolean = 11,
+    String = 12,
+};
+
+struct Value {
+    DataType type{DataType::Float};
+    union {
+        float f;
+        double d;
+        int64_t i;
+        uint64_t u;
+        bool b;
+    };
+    std::string_view s{}; // DataType::String
+
+    Value() : u{0} {}
+    static Value of_float(float v) { Value x; x.type = DataType::Float; x.f = v; return x; }
+    static Value of_double(double v) { Value x; x.type = DataType::Double; x.d = v; return x; }
+    static Value of_uint64(uint64_t v) { Value x; x.type = DataType::UInt64; x.u = v; return x; }
+    static Value of_int64(int64_t v) { Value x; x.type = DataType::Int64; x.i = v; return x; }
+    static Value of_bool(bool v) { Value x; x.type = DataType::Boolean; x.b = v; return x; }
+    static Value of_string(std::string_view v) { Value x; x.type = DataType::String; x.s = v; return x; }
+};
+
+// Metric announced in a birth message
+struct MetricDef {
+    std::string_view name;
+    uint64_t alias;
+    DataType type;
+};
+
+// Topic namespace: spBv1.0/<group>/<TYPE>/<edge node>[/<device>]
+constexpr std::string_view kNamespace = "spBv1.0";
+
+} // namespace sparkplug
+
+class SparkplugSession {
+public:
+    uint64_t bd_seq() const { return bd_seq_; }
+    uint8_t peek_seq() const { return seq_; }
+    // seq for the next message (NBIRTH must get 0: call rebirth() first)
+    uint8_t next_seq() { return seq_++; }
+    // New birth cycle: bdSeq advances (except for the very first birth) and seq restarts at 0.
+    void rebirth() {
+        if (born_) ++bd_seq_;
+        born_ = true;
+        seq_ = 0;
+    }
+
+private:
+    uint64_t bd_seq_{0};
+    uint8_t seq_{0};
+    bool born_{false};
+};
+
+class SparkplugEncoder {
+public:
+    SparkplugEncoder(uint8_t* buf, size_t cap) : w_{buf, cap} {}
+
+    // Payload.timestamp (ms since the Unix epoch)
+    void begin(uint64_t timestamp_ms);
+    // Birth form: name, alias, timestamp, datatype and value
+    void birth_metric(const sparkplug::MetricDef& def, uint64_t timestamp_ms, const sparkplug::Value& v);
+    // Data form: alias, timestamp and value only
+    void metric(uint64_t alias, uint64_t timestamp_ms, const sparkplug::Value& v);
+    void metric_float(uint64_t alias, uint64_t timestamp_ms, float v);
+    // Payload.seq; returns the payload size, or 0 if it did not fit.
+    size_t finish(uint64_t seq);
+
+    bool ok() const { return w_.ok(); }
+
+private:
+    void value(const sparkplug::Value& v);
+
+    ProtoWriter w_;
+};
+
+// NBIRTH: bdSeq plus every node metric with its current value; starts a new birth cycle (seq 0).
+size_t sparkplug_nbirth(uint8_t* buf, size_t cap, SparkplugSession& session, uint64_t timestamp_ms,
+                        const sparkplug::MetricDef* defs, const sparkplug::Value* values, size_t n);
+
+// DBIRTH for one device: every device metric with its current value.
+size_t sparkplug_dbirth(uint8_t* buf, size_t cap, SparkplugSession& session, uint64_t timestamp_ms,
+                        const sparkplug::MetricDef* defs, const sparkplug::Value* values, size_t n);
+
+// Upper bound for one data-form float metric with an alias below 2^14 and a ms timestamp below 2^49.
+constexpr size_t kSparkplugFloatMetricMax = 1 + 1 + (1 + 2) + (1 + 7) + (1 + 4);
+// Upper bound for the payload envelope (timestamp + seq).
+constexpr size_t kSparkplugEnvelopeMax = (1 + 7) + (1 + 2);
+
+} // namespace industrial
@@ -0,0 +1,140 @@
+/**
+ * @file industrial/Spool.hpp
+ * @brief Disk-backed store-and-forward spool for payloads that could not be published.
+ *
+ * Storage: a fixed set of preallocated segment files (<dir>/spool-NNN.seg) mapped with mmap.
+ * Each segment starts with a 64-byte header followed by 8-byte aligned records:
+ *   [u32 commit][u32 payload len][u16 topic len][u16 reserved][topic bytes][payload bytes][pad]
+ * The commit word is stored last (release) and carries the segment's generation tag, so a record
+ * torn by a crash, or left over from a previous use of the segment, never reads as committed.
+ * Recovery on open() rescans each segment up to its last committed record.
+ *
+ * Threads:
+ * - Writer side: enqueue() copies into an SpscRing (never blocks, never touches the disk) and a
+ *   background thread started with start() appends to the mapped segments.
+ * - Reader side: peek()/consume() (or drain()) run on the publishing thread, hand out pointers
+ *   straight into the mapping and persist the read offset, giving at-least-once delivery
+ *   across restarts.
+ *
+ * @note:
+ * - Exactly one enqueue() thread and one reader thread. No exceptions; bool/count returns.
+ * - When the enqueue ring or all segments are full, new payloads are refused and counted (oldest data
+ *   is kept).
+ * - POSIX only (open/posix_fallocate/mmap/msync).
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "industrial/Config.hpp"
+#include "industrial/SpscRing.hpp"
+
+namespace industrial {
+
+class Spool {
+public:
+    // View of one spooled record; pointers stay valid until consume().
+    struct Record {
+        const char* topic{nullptr};
+        uint32_t topic_len{0};
+        const uint8_t* payload{nullptr};
+        uint32_t len{0};
+    };
+
+    Spool() = default;
+    ~Spool();
+    Spool(const Spool&) = delete;
+    Spool& operator=(const Spool&) = delete;
+
+    // Create or reopen segments under dir and recover their contents.
+    bool open(const std::string& dir, uint32_t segment_bytes, uint32_t segment_count);
+    void close();
+    bool is_open() const { return seg_count_ > 0; }
+
+    // Background writer thread feeding the segments from the enqueue ring.
+    void start();
+    void stop();
+
+    // Hot path: copy into the in-memory ring; false (counted in dropped()) if topic/payload exceed the
+    // entry limits or the ring is full, so the caller can keep the payload itself.
+    bool enqueue(std::string_view topic, const void* payload, size_t len);
+
+    // Synchronous append on the calling (writer) thread; false when the spool is full.
+    bool append(const char* topic, size_t topic_len, const void* payload, size_t len);
+
+    // Reader side.
+    bool peek(Record& out);
+    void consume();
+
+    // Hand up to max records to fn(const Record&) -> bool; a false return stops the drain and
+    // keeps that record for the next attempt. Returns the number of records consumed.
+    template <typename Fn>
+    size_t drain(size_t max, Fn&& fn) {
+        size_t n = 0;
+        Record r;
+        while (n < max && peek(r)) {
+            if (!fn(r)) break;
+            consume();
+            ++n;
+        }
+        return n;
+    }
+
+    // Force dirty pages of the active segment towards the disk (MS_ASYNC).
+    void sync();
+
+    uint64_t appended() const { return appended_.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    uint64_t drained() const { return drained_.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        uint16_t topic_len;
+        uint16_t len;
+        char topic[kSpoolMaxTopic];
+        uint8_t payload[kSpoolMaxPayload];
+    };
+
+    struct Segment {
+        int fd{-1};
+        uint8_t* base{nullptr};
+    };
+
+    static constexpr uint32_t kMaxSegments = 64;
+
+    bool map_segment(uint32_t idx, const std::string& path);
+    void recover();
+    int acquire_free_segment();
+    void seal_current();
+    bool select_read_segment();
+    void writer_loop();
+
+    Segment segs_[kMaxSegments]{};
+    uint32_t seg_count_{0};
+    uint32_t seg_bytes_{0};
+
+    // writer-owned
+    int cur_{-1};
+    uint32_t wpos_{0};
+    uint64_t max_seq_{0};
+
+    // reader-owned
+    int rseg_{-1};
+    uint32_t rpos_{0};
+    uint32_t rlen_{0}; // size of the record last returned by peek(), 0 if none
+
+    std::atomic<uint64_t> appended_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> drained_{0};
+
+    SpscRing<Entry, kSpoolQueueCapacity> queue_;
+    std::atomic<bool> running_{false};
+    std::thread writer_;
+};
+
+} // namespace industrial
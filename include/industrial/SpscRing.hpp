@@ -3,15 +3,20 @@
  * @brief Fixed-capacity single-producer/single-consumer ring buffer with no dynamic allocation.
  *
  * @note:
- * - Template: SpscRing<T, N>
+ * - Template: SpscRing<T, N, Signal = NoSignal>
  * - Storage: internal array (no heap), constant-time operations
  * - Element type: T required to be trivially copyable when <type_traits> is available
  *   (define INDUSTRIAL_DISABLE_TRIVIALITY_GUARD to bypass on limited toolchains).
  * 
- * - API: push(const T&), try_pop(T&), size(), empty(), full(), clear(); all non-blocking.
+ * - API: push(const T&), try_push(const T&), try_pop(T&), size(), empty(), full(), clear(); all non-blocking.
  * - Behavior: push always succeeds; when full, oldest item is overwritten (drop-oldest).
+ *   try_push refuses instead (drop-newest), for items that must not vanish silently, e.g. handles
+ *   whose owner has to release them.
  * - Concurrency: lock-free SPSC; exactly one producer thread and one consumer thread. Uses 
  *   std::memory_order to synchronize producer/consumer head/tail updates without the need for locks
+ * - Optional wake-up: with a Signal type (e.g. Doorbell) attached through set_signal(), every
+ *   push/try_push calls signal->ring() after publishing the item, so a consumer can block instead of
+ *   polling. The default NoSignal compiles to nothing.
  */
 #pragma once
 
@@ -22,7 +27,13 @@
 namespace industrial
 {
 
-    template <typename T, uint32_t N>
+    // Default SpscRing signal: no wake-up, no cost
+    struct NoSignal
+    {
+        void ring() {}
+    };
+
+    template <typename T, uint32_t N, typename Signal = NoSignal>
     class SpscRing
     {
     public:
@@ -35,6 +46,9 @@ namespace industrial
 
         uint32_t capacity() const { return N; }
 
+        // Attach the consumer's wake-up (nullptr detaches); set before the producer starts.
+        void set_signal(Signal *s) { signal_ = s; }
+
         void push(const T &v)
         {
             // Producer sees consumer's progress (pairs with consumer's release on tail)
@@ -51,6 +65,21 @@ namespace industrial
             buf_[head % N] = v;
             // Publish produced item (pairs with consumer's acquire on head)
             head_.store(head + 1, std::memory_order_release); // release: make buf write visible before head advance
+            notify();
+        }
+
+        bool try_push(const T &v)
+        {
+            const uint32_t head = head_.load(std::memory_order_relaxed);
+            const uint32_t tail = tail_.load(std::memory_order_acquire); // acquire: observe freed slots
+            if ((head - tail) == N)
+            {
+                return false; // full; caller keeps ownership of v
+            }
+            buf_[head % N] = v;
+            head_.store(head + 1, std::memory_order_release);
+            notify();
+            return true;
         }
 
         bool try_pop(T &out)
@@ -85,9 +114,19 @@ namespace industrial
         }
 
     private:
+        void notify()
+        {
+            if constexpr (!std::is_same_v<Signal, NoSignal>)
+            {
+                if (signal_ != nullptr)
+                    signal_->ring();
+            }
+        }
+
     T buf_[N]{};                    // no-heap storage
         std::atomic<uint32_t> head_{0}; // producer-only writer
         std::atomic<uint32_t> tail_{0}; // consumer-only writer
+        Signal *signal_{nullptr};
     };
 
 } // namespace industrial
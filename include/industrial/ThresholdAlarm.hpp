@@ -0,0 +1,91 @@
+/**
+ * @file industrial/ThresholdAlarm.hpp
+ * @brief High/low limit alarms with hysteresis over a fixed set of float channels.
+ *
+ * @tparam CHANNELS Number of channels evaluated together.
+ *
+ * Per channel, an alarm raises when the value goes above its high limit (or below its low limit)
+ * and clears only once it is back inside by more than the hysteresis band, so a value hovering at
+ * a limit does not chatter. update() reports transitions only: each raise and each clear is one
+ * event, the steady state in between produces none.
+ *
+ * @note:
+ * - Limits are optional per channel and per side (set_high/set_low); NaN never changes the state.
+ * - No heap, no exceptions; not thread-safe.
+ */
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace industrial {
+
+template <uint32_t CHANNELS>
+class ThresholdAlarm {
+public:
+    static_assert(CHANNELS >= 1, "CHANNELS must be >= 1");
+
+    enum class Kind : uint8_t { High, Low };
+
+    struct Event {
+        uint32_t channel;
+        Kind kind;
+        bool active; // true: raised, false: cleared
+        float value;
+    };
+
+    void set_high(uint32_t ch, float limit, float hysteresis = 0.0f) {
+        if (ch >= CHANNELS) return;
+        high_[ch] = {true, limit, hysteresis > 0.0f ? hysteresis : 0.0f, false};
+    }
+    void set_low(uint32_t ch, float limit, float hysteresis = 0.0f) {
+        if (ch >= CHANNELS) return;
+        low_[ch] = {true, limit, hysteresis > 0.0f ? hysteresis : 0.0f, false};
+    }
+
+    bool configured() const {
+        for (uint32_t i = 0; i < CHANNELS; ++i)
+            if (high_[i].on || low_[i].on) return true;
+        return false;
+    }
+
+    // Evaluates all channels; writes up to 2 * CHANNELS transitions to out and returns how many.
+    uint32_t update(const float (&v)[CHANNELS], Event (&out)[2 * CHANNELS]) {
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < CHANNELS; ++i) {
+            if (std::isnan(v[i])) continue;
+            Limit& h = high_[i];
+            if (h.on && (h.active ? v[i] < h.limit - h.hyst : v[i] > h.limit)) {
+                h.active = !h.active;
+                out[n++] = {i, Kind::High, h.active, v[i]};
+            }
+            Limit& l = low_[i];
+            if (l.on && (l.active ? v[i] > l.limit + l.hyst : v[i] < l.limit)) {
+                l.active = !l.active;
+                out[n++] = {i, Kind::Low, l.active, v[i]};
+            }
+        }
+        for (uint32_t k = 0; k < n; ++k) raised_ += out[k].active ? 1u : 0u;
+        return n;
+    }
+
+    bool active(uint32_t ch, Kind k) const {
+        if (ch >= CHANNELS) return false;
+        return k == Kind::High ? high_[ch].active : low_[ch].active;
+    }
+    uint64_t raised() const { return raised_; }
+
+private:
+    struct Limit {
+        bool on{false};
+        float limit{0.0f};
+        float hyst{0.0f};
+        bool active{false};
+    };
+
+    Limit high_[CHANNELS];
+    Limit low_[CHANNELS];
+    uint64_t raised_{0};
+};
+
+} // namespace industrial
@@ -0,0 +1,45 @@
+/**
+ * @file industrial/TokenBucket.hpp
+ * @brief Minimal token-bucket rate limiter driven by steady_clock time points.
+ *
+ * @note:
+ * - Refills continuously at rate tokens/second up to burst; try_take() never blocks.
+ * - A rate <= 0 disables limiting (every take succeeds).
+ * - Not thread-safe; intended to be owned by the thread doing the rate-limited work.
+ */
+#pragma once
+
+#include <chrono>
+
+namespace industrial {
+
+class TokenBucket {
+public:
+    using clock = std::chrono::steady_clock;
+
+    TokenBucket() = default;
+    TokenBucket(double rate_per_s, double burst)
+        : rate_{rate_per_s}, burst_{burst < 1.0 ? 1.0 : burst}, tokens_{burst_} {}
+
+    bool try_take(clock::time_point now, double n = 1.0) {
+        if (rate_ <= 0.0) return true;
+        if (last_ != clock::time_point{}) {
+            tokens_ += rate_ * std::chrono::duration<double>(now - last_).count();
+            if (tokens_ > burst_) tokens_ = burst_;
+        }
+        last_ = now;
+        if (tokens_ < n) return false;
+        tokens_ -= n;
+        return true;
+    }
+
+    double rate() const { return rate_; }
+
+private:
+    double rate_{0.0};
+    double burst_{1.0};
+    double tokens_{1.0};
+    clock::time_point last_{};
+};
+
+} // namespace industrial
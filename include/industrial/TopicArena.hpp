@@ -0,0 +1,118 @@
+/**
+ * @file industrial/TopicArena.hpp
+ * @brief Per-sensor, per-channel MQTT topics rendered once into one contiguous character arena.
+ *
+ * @tparam BYTES      Arena capacity in characters.
+ * @tparam MAX_TOPICS Maximum number of topics (sensors x channels).
+ *
+ * build() renders "<prefix>/sensor<id>/<channel>" for every sensor id in [first_id, first_id + sensors)
+ * and every channel name, back to back, and records where each one starts. topic(sensor, channel)
+ * is then an index computation returning a std::string_view into the arena, which MqttPublisher,
+ * SinkFanOut and the spool accept directly: publishing needs no string building and no heap,
+ * however many topics exist. add() appends a fixed topic that is not per sensor (an application's
+ * "<topic>/alarm", Sparkplug's NBIRTH/DBIRTH/DDATA) to the same arena.
+ *
+ * @note:
+ * - No heap, no exceptions; build() returns false (and leaves the arena empty) when the topics do
+ *   not fit BYTES or MAX_TOPICS.
+ * - Views stay valid until the next build()/clear(); build once at startup, then read from any thread.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <string_view>
+
+#include "industrial/Config.hpp"
+
+namespace industrial {
+
+template <uint32_t BYTES = kTopicArenaBytes, uint32_t MAX_TOPICS = kTopicArenaMaxTopics>
+class TopicArena {
+public:
+    static_assert(BYTES >= 1 && MAX_TOPICS >= 1, "empty arena");
+
+    TopicArena() = default;
+    TopicArena(const TopicArena&) = delete;
+    TopicArena& operator=(const TopicArena&) = delete;
+
+    bool build(std::string_view prefix, uint32_t first_id, uint32_t sensors,
+               const std::string_view* channels, uint32_t n_channels) {
+        clear();
+        if (n_channels == 0 || sensors == 0 || (uint64_t)sensors * n_channels > MAX_TOPICS) return false;
+        for (uint32_t s = 0; s < sensors; ++s) {
+            char id[24];
+            const int id_len = std::snprintf(id, sizeof(id), "/sensor%u/", first_id + s);
+            for (uint32_t c = 0; c < n_channels; ++c) {
+                if (!append(prefix) || !append(std::string_view(id, (size_t)id_len)) || !append(channels[c])) {
+                    clear();
+                    return false;
+                }
+                offsets_[++count_] = used_;
+            }
+        }
+        first_id_ = first_id;
+        sensors_ = sensors;
+        channels_ = n_channels;
+        return true;
+    }
+
+    // Appends one more topic, the concatenation of parts, after those already in the arena; build()
+    // and clear() discard it as well. Empty view (and no change) when it does not fit.
+    std::string_view add(std::initializer_list<std::string_view> parts) {
+        if (count_ >= MAX_TOPICS) return {};
+        const uint32_t start = used_;
+        for (std::string_view p : parts) {
+            if (!append(p)) {
+                used_ = start;
+                return {};
+            }
+        }
+        offsets_[++count_] = used_;
+        return at(count_ - 1);
+    }
+
+    void clear() {
+        used_ = 0;
+        count_ = 0;
+        sensors_ = channels_ = 0;
+        offsets_[0] = 0;
+    }
+
+    // Empty view for ids outside the built range.
+    std::string_view topic(uint32_t sensor_id, uint32_t channel) const {
+        const uint32_t s = sensor_id - first_id_;
+        if (sensor_id < first_id_ || s >= sensors_ || channel >= channels_) return {};
+        return at(s * channels_ + channel);
+    }
+
+    // Topic by flat index in build order (sensor-major).
+    std::string_view at(uint32_t i) const {
+        if (i >= count_) return {};
+        return std::string_view(arena_ + offsets_[i], offsets_[i + 1] - offsets_[i]);
+    }
+
+    uint32_t size() const { return count_; }
+    uint32_t bytes_used() const { return used_; }
+    static constexpr uint32_t capacity_bytes() { return BYTES; }
+
+private:
+    bool append(std::string_view s) {
+        if (s.size() > BYTES - used_) return false;
+        std::memcpy(arena_ + used_, s.data(), s.size());
+        used_ += static_cast<uint32_t>(s.size());
+        return true;
+    }
+
+    char arena_[BYTES];
+    uint32_t offsets_[MAX_TOPICS + 1]{}; // offsets_[i]..offsets_[i + 1] is topic i
+    uint32_t used_{0};
+    uint32_t count_{0};
+    uint32_t first_id_{0};
+    uint32_t sensors_{0};
+    uint32_t channels_{0};
+};
+
+} // namespace industrial
@@ -0,0 +1,194 @@
+/**
+ * @file industrial/TopicTrie.hpp
+ * @brief MQTT-style topic filter trie: subscriptions are compiled into levels once, topics are matched by walking it.
+ *
+ * @tparam MAX_NODES   Maximum number of distinct filter levels across all subscriptions.
+ * @tparam LABEL_BYTES Character storage for level labels.
+ *
+ * Each node is one filter level ("sensors", "+", ...). A node carries two subscriber masks: exact
+ * (filters ending at this level) and multi (filters "<this level>/#"). match(topic) walks the topic
+ * level by level, following the literal child and the '+' child, and ORs together every mask it
+ * reaches, so the cost depends on topic depth, not on the number of subscriptions. Subscribers are
+ * small integer ids (0..63) and a match result is a bit mask of them.
+ *
+ * Filter rules follow MQTT 3.1.1: '+' matches exactly one level, '#' matches any number of levels
+ * including the parent ("a/#" matches "a"), both must occupy a whole level and '#' must be last.
+ * Topics starting with '$' are not matched by a leading wildcard.
+ *
+ * @note:
+ * - No heap, no exceptions; add() returns false for invalid filters or when the trie is full.
+ * - Unsubscribing clears bits but keeps nodes, so re-subscribing to a known filter never allocates.
+ * - Not thread-safe; the owner serializes add/remove with match.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "industrial/Config.hpp"
+
+namespace industrial {
+
+template <uint32_t MAX_NODES = kTopicTrieMaxNodes, uint32_t LABEL_BYTES = kTopicTrieLabelBytes>
+class TopicTrie {
+public:
+    using Mask = uint64_t;
+    static constexpr uint32_t kMaxSubscribers = 64;
+    static_assert(MAX_NODES >= 1, "the root needs a node");
+
+    TopicTrie() { clear(); }
+    TopicTrie(const TopicTrie&) = delete;
+    TopicTrie& operator=(const TopicTrie&) = delete;
+
+    void clear() {
+        nodes_[0] = Node{};
+        used_nodes_ = 1;
+        used_bytes_ = 0;
+    }
+
+    static bool valid_filter(std::string_view filter) {
+        if (filter.empty()) return false;
+        size_t pos = 0;
+        for (;;) {
+            const size_t end = filter.find('/', pos);
+            const std::string_view level = filter.substr(pos, end == std::string_view::npos ? end : end - pos);
+            if (level.size() > 1 && (level.find('+') != std::string_view::npos || level.find('#') != std::string_view::npos))
+                return false;
+            if (level == "#" && end != std::string_view::npos) return false;
+            if (end == std::string_view::npos) return true;
+            pos = end + 1;
+        }
+    }
+
+    bool add(std::string_view filter, uint32_t subscriber) {
+        if (subscriber >= kMaxSubscribers || !valid_filter(filter)) return false;
+        int32_t node = 0;
+        size_t pos = 0;
+        for (;;) {
+            const size_t end = filter.find('/', pos);
+            const std::string_view level = filter.substr(pos, end == std::string_view::npos ? end : end - pos);
+            if (level == "#") {
+                nodes_[node].multi |= bit(subscriber);
+                return true;
+            }
+            node = child(node, level, true);
+            if (node < 0) return false;
+            if (end == std::string_view::npos) {
+                nodes_[node].exact |= bit(subscriber);
+                return true;
+            }
+            pos = end + 1;
+        }
+    }
+
+    // Drop one filter of a subscriber; false if it was never added.
+    bool remove(std::string_view filter, uint32_t subscriber) {
+        if (subscriber >= kMaxSubscribers || !valid_filter(filter)) return false;
+        int32_t node = 0;
+        size_t pos = 0;
+        for (;;) {
+            const size_t end = filter.find('/', pos);
+            const std::string_view level = filter.substr(pos, end == std::string_view::npos ? end : end - pos);
+            Mask* m = nullptr;
+            if (level == "#") {
+                m = &nodes_[node].multi;
+            } else {
+                node = child(node, level, false);
+                if (node < 0) return false;
+                if (end == std::string_view::npos) m = &nodes_[node].exact;
+            }
+            if (m != nullptr) {
+                const bool had = (*m & bit(subscriber)) != 0;
+                *m &= ~bit(subscriber);
+                return had;
+            }
+            pos = end + 1;
+        }
+    }
+
+    // Drop every filter of a subscriber (disconnect).
+    void remove_all(uint32_t subscriber) {
+        if (subscriber >= kMaxSubscribers) return;
+        for (uint32_t i = 0; i < used_nodes_; ++i) {
+            nodes_[i].exact &= ~bit(subscriber);
+            nodes_[i].multi &= ~bit(subscriber);
+        }
+    }
+
+    Mask match(std::string_view topic) const {
+        if (topic.empty()) return 0;
+        Mask out = 0;
+        walk(0, topic, 0, topic[0] == '$', out);
+        return out;
+    }
+
+    uint32_t nodes_used() const { return used_nodes_; }
+
+private:
+    struct Node {
+        uint32_t label_off{0};
+        uint32_t label_len{0};
+        int32_t first_child{-1};
+        int32_t next_sibling{-1};
+        int32_t plus{-1}; // the '+' child, kept apart so matching never scans for it
+        Mask exact{0};
+        Mask multi{0};
+    };
+
+    static constexpr Mask bit(uint32_t s) { return Mask{1} << s; }
+
+    std::string_view label(const Node& n) const { return std::string_view(labels_ + n.label_off, n.label_len); }
+
+    int32_t find_child(int32_t parent, std::string_view level) const {
+        for (int32_t c = nodes_[parent].first_child; c >= 0; c = nodes_[c].next_sibling)
+            if (label(nodes_[c]) == level) return c;
+        return -1;
+    }
+
+    int32_t child(int32_t parent, std::string_view level, bool create) {
+        const bool plus = level == "+";
+        int32_t c = plus ? nodes_[parent].plus : find_child(parent, level);
+        if (c >= 0 || !create) return c;
+        if (used_nodes_ >= MAX_NODES || (!plus && level.size() > LABEL_BYTES - used_bytes_)) return -1;
+        c = static_cast<int32_t>(used_nodes_++);
+        nodes_[c] = Node{};
+        if (plus) {
+            nodes_[parent].plus = c;
+        } else {
+            std::memcpy(labels_ + used_bytes_, level.data(), level.size());
+            nodes_[c].label_off = used_bytes_;
+            nodes_[c].label_len = static_cast<uint32_t>(level.size());
+            used_bytes_ += static_cast<uint32_t>(level.size());
+            nodes_[c].next_sibling = nodes_[parent].first_child;
+            nodes_[parent].first_child = c;
+        }
+        return c;
+    }
+
+    // Match the topic level starting at pos against the children of node.
+    void walk(int32_t node, std::string_view topic, size_t pos, bool no_wildcards, Mask& out) const {
+        const Node& n = nodes_[node];
+        if (!no_wildcards) out |= n.multi;
+        const size_t end = topic.find('/', pos);
+        const std::string_view level = topic.substr(pos, end == std::string_view::npos ? end : end - pos);
+        const int32_t lit = find_child(node, level);
+        if (lit >= 0) descend(lit, topic, end, out);
+        if (n.plus >= 0 && !no_wildcards) descend(n.plus, topic, end, out);
+    }
+
+    void descend(int32_t node, std::string_view topic, size_t end, Mask& out) const {
+        if (end == std::string_view::npos) {
+            out |= nodes_[node].exact | nodes_[node].multi; // "a/#" also matches "a"
+            return;
+        }
+        walk(node, topic, end + 1, false, out);
+    }
+
+    Node nodes_[MAX_NODES];
+    char labels_[LABEL_BYTES];
+    uint32_t used_nodes_{1};
+    uint32_t used_bytes_{0};
+};
+
+} // namespace industrial
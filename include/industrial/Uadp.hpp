@@ -0,0 +1,65 @@
+/**
+ * @file industrial/Uadp.hpp
+ * @brief OPC UA PubSub UADP NetworkMessage encoder for SensorSample channels (OPC 10000-14).
+ *
+ * Each call produces one NetworkMessage carrying one key-frame DataSetMessage:
+ *
+ *   UADPFlags 0xF1       version 1 | PublisherId | GroupHeader | PayloadHeader | ExtendedFlags1
+ *   ExtendedFlags1 0x01  PublisherId type UInt16
+ *   PublisherId          UInt16
+ *   GroupFlags 0x09      WriterGroupId | SequenceNumber
+ *   WriterGroupId        UInt16
+ *   SequenceNumber       UInt16 (NetworkMessage counter)
+ *   Count 1, DataSetWriterId UInt16
+ *   DataSetFlags1 0x89   valid | Variant field encoding | SequenceNumber | DataSetFlags2
+ *   DataSetFlags2 0x10   key frame | Timestamp
+ *   DataSetMessage SequenceNumber UInt16, Timestamp DateTime
+ *   FieldCount UInt16, then each field as Variant Float (0x0A + IEEE754)
+ *
+ * All integers little-endian. No security, no chunking: a message is far below one datagram.
+ *
+ * @note:
+ * - No heap, no exceptions; encode() returns 0 if the buffer is too small.
+ * - Not thread-safe (sequence numbers live in the encoder).
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace industrial {
+
+struct UadpConfig {
+    uint16_t publisher_id{1};
+    uint16_t writer_group_id{1};
+    uint16_t dataset_writer_id{1};
+};
+
+class UadpEncoder {
+public:
+    UadpEncoder() = default;
+    explicit UadpEncoder(const UadpConfig& cfg) : cfg_{cfg} {}
+
+    // Encode one NetworkMessage with the given Float fields; timestamp in OPC UA DateTime units.
+    size_t encode(uint8_t* buf, size_t cap, const float* fields, uint16_t n, int64_t timestamp);
+
+    static constexpr size_t header_size() { return 26; }
+    static constexpr size_t message_size(uint16_t n_fields) { return header_size() + 5u * n_fields; }
+
+    // OPC UA DateTime: 100 ns intervals since 1601-01-01 UTC.
+    static int64_t to_datetime(std::chrono::system_clock::time_point tp) {
+        constexpr int64_t kEpochDelta = 116444736000000000LL; // 1601 -> 1970 in 100 ns
+        return kEpochDelta +
+               std::chrono::duration_cast<std::chrono::duration<int64_t, std::ratio<1, 10000000>>>(tp.time_since_epoch()).count();
+    }
+
+    uint16_t network_seq() const { return net_seq_; }
+
+private:
+    UadpConfig cfg_{};
+    uint16_t net_seq_{0};
+    uint16_t ds_seq_{0};
+};
+
+} // namespace industrial
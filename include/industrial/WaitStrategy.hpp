@@ -0,0 +1,278 @@
+/**
+ * @file industrial/WaitStrategy.hpp
+ * @brief Idle strategies for queue consumers, from lowest latency to lowest CPU use.
+ *
+ * A consumer that finds its queue empty calls idle(ready, max_wait_ns) and tries again; after it
+ * got an item it calls reset(). ready() re-checks the queue (used by the parking strategies after
+ * they announce the sleep). Each strategy is also a SpscRing Signal: the producer's push calls
+ * ring(), which is empty for the spinning ones.
+ *
+ *   BusySpin     pause in a tight loop: lowest latency, one core at 100 % (isolated cores only)
+ *   SpinYield    spin kSpins times, then sched_yield(): low latency, still 100 % CPU but polite
+ *   Backoff      spin, yield, then sleep with the sleep doubling from min_ns up to max_ns: latency
+ *                grows with idle time (up to max_ns), CPU use falls to near zero
+ *   FutexPark    spin briefly, then sleep on a futex that ring() wakes only while the consumer is
+ *                parked: microsecond wake-ups and no CPU while idle (battery-powered gateways)
+ *   EventfdWait  the same through an eventfd Doorbell, for consumers that also wait on sockets
+ *   SleepPoll    fixed 5 ms sleeps, no wake-up at all: the old polling loop, kept for comparison
+ *   AnyWait      one of the above chosen at run time (configuration), dispatching with a switch
+ *
+ * @note:
+ * - One producer and one consumer per instance. The parking strategies use the arm / re-check /
+ *   sleep pattern with seq_cst fences on both sides, so a push can never be slept through.
+ * - FutexPark is the C++17 stand-in for std::atomic::wait/notify_one (Linux futex syscall).
+ * - No heap, no exceptions.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <thread>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "industrial/Doorbell.hpp"
+
+namespace industrial {
+
+// Spin-wait hint: lets the sibling hyper-thread run and saves power while spinning
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+class BusySpin {
+public:
+    void ring() {}
+    void reset() {}
+    template <typename Ready>
+    void idle(Ready&&, int64_t) {
+        cpu_relax();
+    }
+    static const char* name() { return "spin"; }
+};
+
+class SpinYield {
+public:
+    static constexpr uint32_t kSpins = 256;
+
+    void ring() {}
+    void reset() { spins_ = 0; }
+    template <typename Ready>
+    void idle(Ready&&, int64_t) {
+        if (spins_ < kSpins) {
+            ++spins_;
+            cpu_relax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    static const char* name() { return "yield"; }
+
+private:
+    uint32_t spins_{0};
+};
+
+class Backoff {
+public:
+    static constexpr uint32_t kSpins = 64;
+    static constexpr uint32_t kYields = 8;
+
+    explicit Backoff(uint32_t min_ns = 1000, uint32_t max_ns = 1000000)
+        : min_ns_{min_ns > 0 ? min_ns : 1}, max_ns_{max_ns > min_ns ? max_ns : min_ns}, sleep_ns_{min_ns_} {}
+
+    void ring() {}
+    void reset() {
+        step_ = 0;
+        sleep_ns_ = min_ns_;
+    }
+    template <typename Ready>
+    void idle(Ready&&, int64_t max_wait_ns) {
+        if (step_ < kSpins) {
+            ++step_;
+            cpu_relax();
+            return;
+        }
+        if (step_ < kSpins + kYields) {
+            ++step_;
+            std::this_thread::yield();
+            return;
+        }
+        const int64_t ns = max_wait_ns < sleep_ns_ ? (max_wait_ns > 0 ? max_wait_ns : 0) : sleep_ns_;
+        std::this_thread::sleep_for(std::chrono::nanoseconds(ns));
+        sleep_ns_ = sleep_ns_ * 2 < max_ns_ ? sleep_ns_ * 2 : max_ns_;
+    }
+    static const char* name() { return "backoff"; }
+
+private:
+    uint32_t min_ns_;
+    uint32_t max_ns_;
+    uint32_t sleep_ns_;
+    uint32_t step_{0};
+};
+
+class FutexPark {
+public:
+    static constexpr uint32_t kSpins = 64; // brief spin first: a burst usually continues
+
+    FutexPark() = default;
+    FutexPark(const FutexPark&) = delete;
+    FutexPark& operator=(const FutexPark&) = delete;
+
+    // Producer, after making an item visible: one fence and a load unless the consumer is parked.
+    void ring() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (state_.load(std::memory_order_relaxed) != kParked) return;
+        if (state_.exchange(kAwake, std::memory_order_relaxed) != kParked) return;
+        (void)::syscall(SYS_futex, word(), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+        wakes_.fetch_add(1, std::memory_order_relaxed);
+    }
+    void reset() { spins_ = 0; }
+    template <typename Ready>
+    void idle(Ready&& ready, int64_t max_wait_ns) {
+        if (spins_ < kSpins) {
+            ++spins_;
+            cpu_relax();
+            return;
+        }
+        state_.store(kParked, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst); // announce before the re-check
+        if (!ready() && max_wait_ns > 0) {
+            timespec ts{static_cast<time_t>(max_wait_ns / 1000000000), static_cast<long>(max_wait_ns % 1000000000)};
+            // Returns at once (EAGAIN) if ring() already flipped the word back to kAwake
+            (void)::syscall(SYS_futex, word(), FUTEX_WAIT_PRIVATE, kParked, &ts, nullptr, 0);
+            parks_.fetch_add(1, std::memory_order_relaxed);
+        }
+        state_.store(kAwake, std::memory_order_relaxed);
+    }
+    static const char* name() { return "park"; }
+
+    uint64_t parks() const { return parks_.load(std::memory_order_relaxed); } // futex sleeps
+    uint64_t wakes() const { return wakes_.load(std::memory_order_relaxed); } // futex wake calls
+
+private:
+    static constexpr uint32_t kAwake = 0;
+    static constexpr uint32_t kParked = 1;
+
+    uint32_t* word() { return reinterpret_cast<uint32_t*>(&state_); }
+
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex needs a plain 32-bit word");
+    std::atomic<uint32_t> state_{kAwake};
+    uint32_t spins_{0};
+    std::atomic<uint64_t> parks_{0};
+    std::atomic<uint64_t> wakes_{0};
+};
+
+class EventfdWait {
+public:
+    bool open() { return bell_.open(); }
+    void ring() { bell_.ring(); }
+    void reset() {}
+    template <typename Ready>
+    void idle(Ready&& ready, int64_t max_wait_ns) {
+        bell_.arm();
+        if (ready() || max_wait_ns <= 0) {
+            bell_.disarm();
+            return;
+        }
+        (void)bell_.wait(static_cast<int>((max_wait_ns + 999999) / 1000000));
+    }
+    static const char* name() { return "event"; }
+
+    Doorbell& doorbell() { return bell_; } // fd() for an epoll set of the consumer's own
+
+private:
+    Doorbell bell_;
+};
+
+class SleepPoll {
+public:
+    static constexpr int64_t kPollNs = 5000000;
+
+    void ring() {}
+    void reset() {}
+    template <typename Ready>
+    void idle(Ready&&, int64_t max_wait_ns) {
+        const int64_t ns = max_wait_ns < kPollNs ? (max_wait_ns > 0 ? max_wait_ns : 0) : kPollNs;
+        std::this_thread::sleep_for(std::chrono::nanoseconds(ns));
+    }
+    static const char* name() { return "sleep"; }
+};
+
+// Run-time choice among the strategies above (one of each is embedded; only the selected one runs).
+class AnyWait {
+public:
+    enum class Kind : uint8_t { Spin, Yield, Backoff, Park, Event, Sleep };
+
+    // Accepts "spin", "yield", "backoff", "park", "event" or "sleep"; false (and no change) otherwise.
+    bool select(const char* name) {
+        static const char* const kNames[] = {"spin", "yield", "backoff", "park", "event", "sleep"};
+        for (uint8_t i = 0; i < 6; ++i)
+            if (std::strcmp(name, kNames[i]) == 0) return select(static_cast<Kind>(i));
+        return false;
+    }
+    // Event needs an eventfd; false if it cannot be created.
+    bool select(Kind k) {
+        if (k == Kind::Event && !event_.open()) return false;
+        kind_ = k;
+        return true;
+    }
+    Kind kind() const { return kind_; }
+    const char* name() const {
+        switch (kind_) {
+        case Kind::Spin: return BusySpin::name();
+        case Kind::Yield: return SpinYield::name();
+        case Kind::Backoff: return Backoff::name();
+        case Kind::Park: return FutexPark::name();
+        case Kind::Event: return EventfdWait::name();
+        case Kind::Sleep: return SleepPoll::name();
+        }
+        return "?";
+    }
+
+    void ring() {
+        if (kind_ == Kind::Park) {
+            park_.ring();
+        } else if (kind_ == Kind::Event) {
+            event_.ring();
+        }
+    }
+    void reset() {
+        yield_.reset();
+        backoff_.reset();
+        park_.reset();
+    }
+    template <typename Ready>
+    void idle(Ready&& ready, int64_t max_wait_ns) {
+        switch (kind_) {
+        case Kind::Spin: spin_.idle(ready, max_wait_ns); break;
+        case Kind::Yield: yield_.idle(ready, max_wait_ns); break;
+        case Kind::Backoff: backoff_.idle(ready, max_wait_ns); break;
+        case Kind::Park: park_.idle(ready, max_wait_ns); break;
+        case Kind::Event: event_.idle(ready, max_wait_ns); break;
+        case Kind::Sleep: sleep_.idle(ready, max_wait_ns); break;
+        }
+    }
+
+    FutexPark& park() { return park_; }
+    EventfdWait& event() { return event_; }
+
+private:
+    Kind kind_{Kind::Park};
+    BusySpin spin_;
+    SpinYield yield_;
+    Backoff backoff_;
+    FutexPark park_;
+    EventfdWait event_;
+    SleepPoll sleep_;
+};
+
+} // namespace industrial
@@ -0,0 +1,202 @@
+/**
+ * @file AsyncLog.cpp
+ * @brief Writer side of the asynchronous logger: merge, format, batch (see industrial/AsyncLog.hpp).
+ *
+ * Formatting walks the format string once per record and hands each conversion, rebuilt with a
+ * 64-bit length modifier, to snprintf together with its stored argument; literal text is copied.
+ */
+#include "industrial/AsyncLog.hpp"
+
+#include <chrono>
+#include <cstring>
+
+namespace industrial {
+
+namespace {
+
+std::atomic<uint64_t> next_log_id{1}; // distinguishes loggers in the per-thread ring cache
+
+bool is_int_conv(char c) { return c == 'd' || c == 'i'; }
+bool is_uint_conv(char c) { return c == 'u' || c == 'o' || c == 'x' || c == 'X'; }
+bool is_float_conv(char c) {
+    return c == 'f' || c == 'F' || c == 'e' || c == 'E' || c == 'g' || c == 'G' || c == 'a' || c == 'A';
+}
+
+// Numeric value of an argument, whatever it was stored as
+int64_t as_int(AsyncLog::ArgKind k, const AsyncLog::ArgValue& v) {
+    switch (k) {
+    case AsyncLog::ArgKind::Int: return v.i;
+    case AsyncLog::ArgKind::Uint: return static_cast<int64_t>(v.u);
+    case AsyncLog::ArgKind::Double: return static_cast<int64_t>(v.d);
+    case AsyncLog::ArgKind::Str: break;
+    }
+    return 0;
+}
+double as_double(AsyncLog::ArgKind k, const AsyncLog::ArgValue& v) {
+    switch (k) {
+    case AsyncLog::ArgKind::Int: return static_cast<double>(v.i);
+    case AsyncLog::ArgKind::Uint: return static_cast<double>(v.u);
+    case AsyncLog::ArgKind::Double: return v.d;
+    case AsyncLog::ArgKind::Str: break;
+    }
+    return 0.0;
+}
+
+} // namespace
+
+AsyncLog::AsyncLog() : id_{next_log_id.fetch_add(1, std::memory_order_relaxed)} {}
+
+AsyncLog::~AsyncLog() { stop(); }
+
+bool AsyncLog::start(std::FILE* out) {
+    if (out == nullptr || running_.exchange(true)) return false;
+    out_ = out;
+    writer_ = std::thread([this] { writer_loop(); });
+    return true;
+}
+
+void AsyncLog::stop() {
+    if (!running_.exchange(false)) return;
+    if (writer_.joinable()) writer_.join();
+}
+
+void AsyncLog::flush() {
+    if (!running_.load(std::memory_order_acquire)) {
+        if (out_ != nullptr) (void)drain();
+        return;
+    }
+    // A full writer pass that began after this call has seen everything queued before it
+    const uint64_t p = passes_.load(std::memory_order_acquire);
+    while (running_.load(std::memory_order_acquire) && passes_.load(std::memory_order_acquire) < p + 2)
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+}
+
+bool AsyncLog::set_level(const char* name) {
+    static const char* const kNames[] = {"error", "warn", "info", "debug"};
+    for (uint8_t i = 0; i < 4; ++i) {
+        if (std::strcmp(name, kNames[i]) == 0) {
+            set_level(static_cast<LogLevel>(i));
+            return true;
+        }
+    }
+    return false;
+}
+
+void AsyncLog::writer_loop() {
+    for (;;) {
+        const bool run = running_.load(std::memory_order_acquire);
+        const size_t n = drain();
+        passes_.fetch_add(1, std::memory_order_release);
+        if (!run) break; // stop() was called before this pass: everything is written
+        if (n == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+size_t AsyncLog::drain() {
+    size_t n = 0;
+    uint32_t rings = claimed_.load(std::memory_order_acquire);
+    if (rings > kLogMaxThreads) rings = kLogMaxThreads;
+    for (;;) {
+        // Oldest record among the ring heads (calls still being queued show up in the next pass)
+        int best = -1;
+        for (uint32_t i = 0; i < rings; ++i) {
+            if (!have_[i]) have_[i] = channels_[i].ring.try_pop(head_[i]);
+            if (have_[i] && (best < 0 || head_[i].seq < head_[best].seq)) best = static_cast<int>(i);
+        }
+        if (best < 0) break;
+        emit(head_[best]);
+        have_[best] = false;
+        ++n;
+    }
+    write_out();
+    return n;
+}
+
+void AsyncLog::emit(const Record& r) {
+    if (kLogBatchBytes - len_ < kLogMaxLine) write_out();
+    len_ += format(r, buf_ + len_, kLogMaxLine);
+    written_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AsyncLog::write_out() {
+    if (len_ == 0) return;
+    (void)std::fwrite(buf_, 1, len_, out_);
+    std::fflush(out_);
+    batches_.fetch_add(1, std::memory_order_relaxed);
+    bytes_.fetch_add(len_, std::memory_order_relaxed);
+    len_ = 0;
+}
+
+size_t AsyncLog::format(const Record& r, char* out, size_t cap) {
+    if (cap < 2) return 0;
+    const size_t room = cap - 1; // the newline always fits
+    size_t n = 0;
+    uint32_t arg = 0;
+    const char* p = r.format->fmt;
+    while (*p != '\0' && n < room) {
+        if (*p != '%') {
+            out[n++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[n++] = '%';
+            p += 2;
+            continue;
+        }
+        // %[flags][width][.precision][length]conv -> the same with "ll" (integers) and no length
+        char spec[32];
+        size_t s = 0;
+        const char* q = p + 1;
+        spec[s++] = '%';
+        while (*q != '\0' && std::strchr("-+ #0123456789.", *q) != nullptr && s < sizeof(spec) - 4)
+            spec[s++] = *q++;
+        while (*q != '\0' && std::strchr("hlLqjzt", *q) != nullptr) ++q;
+        const char conv = *q;
+        if (conv == '\0') break;
+        p = q + 1;
+        if (arg >= r.nargs) {
+            out[n++] = '?'; // more conversions than arguments
+            continue;
+        }
+        const ArgKind kind = r.kinds[arg];
+        const ArgValue& v = r.args[arg];
+        ++arg;
+        int w;
+        const size_t left = room - n + 1; // snprintf counts its terminator
+        if (is_int_conv(conv) || is_uint_conv(conv)) {
+            spec[s++] = 'l';
+            spec[s++] = 'l';
+            spec[s++] = conv;
+            spec[s] = '\0';
+            w = is_int_conv(conv) ? std::snprintf(out + n, left, spec, static_cast<long long>(as_int(kind, v)))
+                                  : std::snprintf(out + n, left, spec,
+                                                  static_cast<unsigned long long>(as_int(kind, v)));
+        } else if (is_float_conv(conv)) {
+            spec[s++] = conv;
+            spec[s] = '\0';
+            w = std::snprintf(out + n, left, spec, as_double(kind, v));
+        } else if (conv == 'c') {
+            spec[s++] = 'c';
+            spec[s] = '\0';
+            w = std::snprintf(out + n, left, spec, static_cast<int>(as_int(kind, v)));
+        } else if (conv == 's') {
+            spec[s++] = 's';
+            spec[s] = '\0';
+            const char* str = kind == ArgKind::Str ? (v.s != nullptr ? v.s : "(null)") : "?";
+            w = std::snprintf(out + n, left, spec, str);
+        } else if (conv == 'p') {
+            spec[s++] = 'p';
+            spec[s] = '\0';
+            w = std::snprintf(out + n, left, spec, kind == ArgKind::Str ? static_cast<const void*>(v.s)
+                                                         : reinterpret_cast<const void*>(static_cast<uintptr_t>(v.u)));
+        } else {
+            out[n++] = '?'; // unknown conversion; its argument is skipped
+            continue;
+        }
+        if (w > 0) n += static_cast<size_t>(w) < room - n ? static_cast<size_t>(w) : room - n;
+    }
+    out[n++] = '\n';
+    return n;
+}
+
+} // namespace industrial
@@ -0,0 +1,208 @@
+/**
+ * @file GorillaCodec.cpp
+ * @brief Delta-of-delta timestamp and XOR float coding for SensorSample blocks.
+ *
+ * See industrial/GorillaCodec.hpp for the wire layout. The encoder writes straight into the
+ * caller's buffer through BitWriter; the decoder pulls fields through BitReader's 64-bit window
+ * so each sample costs a handful of shifts and at most a few byte loads.
+ */
+#include "industrial/GorillaCodec.hpp"
+
+#include <chrono>
+#include <cstring>
+
+namespace industrial {
+
+namespace {
+
+int64_t to_ns(TimePoint tp) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+}
+
+TimePoint from_ns(int64_t ns) {
+    return TimePoint(std::chrono::duration_cast<TimePoint::duration>(std::chrono::nanoseconds(ns)));
+}
+
+uint32_t float_bits(float f) {
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+float bits_float(uint32_t u) {
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+bool fits_signed(int64_t v, unsigned bits) {
+    const int64_t lim = int64_t(1) << (bits - 1u);
+    return v >= -lim && v < lim;
+}
+
+int64_t sign_extend(uint64_t v, unsigned bits) {
+    const uint64_t m = uint64_t(1) << (bits - 1u);
+    return static_cast<int64_t>((v ^ m) - m);
+}
+
+} // namespace
+
+GorillaEncoder::GorillaEncoder(uint8_t* buf, size_t cap)
+    : buf_{buf},
+      cap_{cap},
+      bw_{cap >= kGorillaHeaderBytes ? buf + kGorillaHeaderBytes : buf,
+          cap >= kGorillaHeaderBytes ? cap - kGorillaHeaderBytes : 0}
+{
+}
+
+bool GorillaEncoder::append(const SensorSample& s) {
+    if (count_ == UINT16_MAX || cap_ < kGorillaHeaderBytes) return false;
+    const int64_t ts = to_ns(s.ts);
+    if (count_ == 0) {
+        bw_.write(static_cast<uint64_t>(ts), 64);
+        temp_.prev = float_bits(s.temperature_c);
+        press_.prev = float_bits(s.pressure_kpa);
+        bw_.write(temp_.prev, 32);
+        bw_.write(press_.prev, 32);
+        prev_ts_ = ts;
+    } else {
+        put_ts(ts);
+        put_float(temp_, s.temperature_c);
+        put_float(press_, s.pressure_kpa);
+    }
+    if (!bw_.ok()) return false;
+    ++count_;
+    return true;
+}
+
+void GorillaEncoder::put_ts(int64_t ts) {
+    // Wrapping arithmetic: pathological jumps must round-trip, not overflow
+    const int64_t delta = static_cast<int64_t>(static_cast<uint64_t>(ts) - static_cast<uint64_t>(prev_ts_));
+    const int64_t dod = static_cast<int64_t>(static_cast<uint64_t>(delta) - static_cast<uint64_t>(prev_delta_));
+    prev_ts_ = ts;
+    prev_delta_ = delta;
+    const uint64_t u = static_cast<uint64_t>(dod);
+    if (dod == 0) {
+        bw_.write(0b0, 1);
+    } else if (fits_signed(dod, 12)) {
+        bw_.write(0b10, 2);
+        bw_.write(u, 12);
+    } else if (fits_signed(dod, 20)) {
+        bw_.write(0b110, 3);
+        bw_.write(u, 20);
+    } else if (fits_signed(dod, 32)) {
+        bw_.write(0b1110, 4);
+        bw_.write(u, 32);
+    } else {
+        bw_.write(0b1111, 4);
+        bw_.write(u, 64);
+    }
+}
+
+void GorillaEncoder::put_float(FloatState& st, float v) {
+    const uint32_t cur = float_bits(v);
+    const uint32_t x = cur ^ st.prev;
+    st.prev = cur;
+    if (x == 0) {
+        bw_.write(0b0, 1);
+        return;
+    }
+    const unsigned lead = static_cast<unsigned>(__builtin_clz(x));
+    const unsigned trail = static_cast<unsigned>(__builtin_ctz(x));
+    if (st.lead != 0xFFu && lead >= st.lead && trail >= st.trail) {
+        const unsigned len = 32u - st.lead - st.trail;
+        bw_.write(0b10, 2);
+        bw_.write(x >> st.trail, len);
+        return;
+    }
+    const unsigned len = 32u - lead - trail;
+    bw_.write(0b11, 2);
+    bw_.write(lead, 5);
+    bw_.write(len - 1u, 5);
+    bw_.write(x >> trail, len);
+    st.lead = lead;
+    st.trail = trail;
+}
+
+size_t GorillaEncoder::finish() {
+    if (cap_ < kGorillaHeaderBytes) return 0;
+    bw_.flush();
+    if (!bw_.ok()) return 0;
+    buf_[0] = kGorillaVersion;
+    buf_[1] = static_cast<uint8_t>(count_ & 0xFFu);
+    buf_[2] = static_cast<uint8_t>(count_ >> 8);
+    return kGorillaHeaderBytes + bw_.bytes();
+}
+
+GorillaDecoder::GorillaDecoder(const uint8_t* buf, size_t len)
+    : br_{len >= kGorillaHeaderBytes ? buf + kGorillaHeaderBytes : buf,
+          len >= kGorillaHeaderBytes ? len - kGorillaHeaderBytes : 0}
+{
+    if (len >= kGorillaHeaderBytes && buf[0] == kGorillaVersion) {
+        valid_ = true;
+        count_ = static_cast<uint16_t>(buf[1] | (buf[2] << 8));
+    }
+}
+
+bool GorillaDecoder::next(SensorSample& out) {
+    if (!valid_ || index_ >= count_) return false;
+    if (index_ == 0) {
+        prev_ts_ = static_cast<int64_t>(br_.read(64));
+        temp_.prev = static_cast<uint32_t>(br_.read(32));
+        press_.prev = static_cast<uint32_t>(br_.read(32));
+    } else {
+        int64_t dod = 0;
+        switch (br_.read_unary(4)) {
+        case 0: dod = 0; break;
+        case 1: dod = sign_extend(br_.read(12), 12); break;
+        case 2: dod = sign_extend(br_.read(20), 20); break;
+        case 3: dod = sign_extend(br_.read(32), 32); break;
+        default: dod = static_cast<int64_t>(br_.read(64)); break;
+        }
+        prev_delta_ = static_cast<int64_t>(static_cast<uint64_t>(prev_delta_) + static_cast<uint64_t>(dod));
+        prev_ts_ = static_cast<int64_t>(static_cast<uint64_t>(prev_ts_) + static_cast<uint64_t>(prev_delta_));
+        get_float(temp_);
+        get_float(press_);
+    }
+    if (!br_.ok() || !valid_) return false;
+    out.ts = from_ns(prev_ts_);
+    out.temperature_c = bits_float(temp_.prev);
+    out.pressure_kpa = bits_float(press_.prev);
+    ++index_;
+    return true;
+}
+
+float GorillaDecoder::get_float(FloatState& st) {
+    if (!br_.read_bit()) return bits_float(st.prev);
+    if (br_.read_bit()) {
+        st.lead = static_cast<unsigned>(br_.read(5));
+        st.len = static_cast<unsigned>(br_.read(5)) + 1u;
+    }
+    // Only reachable with corrupt input: a '10' before any window was set, or a window past bit 31
+    if (st.len == 0u || st.lead + st.len > 32u) {
+        valid_ = false;
+        return bits_float(st.prev);
+    }
+    const unsigned trail = 32u - st.lead - st.len;
+    const uint32_t x = static_cast<uint32_t>(br_.read(st.len)) << trail;
+    st.prev ^= x;
+    return bits_float(st.prev);
+}
+
+size_t gorilla_encode(const SensorSample* samples, size_t n, uint8_t* out, size_t cap) {
+    GorillaEncoder enc(out, cap);
+    for (size_t i = 0; i < n; ++i) {
+        if (!enc.append(samples[i])) return 0;
+    }
+    return enc.finish();
+}
+
+size_t gorilla_decode(const uint8_t* in, size_t len, SensorSample* out, size_t max) {
+    GorillaDecoder dec(in, len);
+    if (!dec.valid() || dec.count() > max) return 0;
+    size_t n = 0;
+    while (n < dec.count() && dec.next(out[n])) ++n;
+    return n == dec.count() ? n : 0;
+}
+
+} // namespace industrial
@@ -0,0 +1,282 @@
+/**
+ * @file InfluxSink.cpp
+ * @brief Batched line-protocol delivery over TCP or HTTP/1.1 keep-alive (see industrial/InfluxSink.hpp).
+ */
+#include "industrial/InfluxSink.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace industrial {
+
+namespace {
+
+// Case-insensitive search for a header name at the start of a line; returns its value or nullptr.
+const char* find_header(const char* head, size_t len, const char* name) {
+    const size_t n = std::strlen(name);
+    for (size_t i = 0; i + n < len; ++i) {
+        if ((i == 0 || head[i - 1] == '\n') && ::strncasecmp(head + i, name, n) == 0) {
+            const char* v = head + i + n;
+            while (*v == ' ') ++v;
+            return v;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+InfluxSink::~InfluxSink() { close(); }
+
+bool InfluxSink::open(const std::string& url) {
+    close();
+    std::string rest = url;
+    const size_t scheme = rest.find("://");
+    if (scheme == std::string::npos) return false;
+    const std::string s = rest.substr(0, scheme);
+    if (s == "http") {
+        http_ = true;
+    } else if (s == "tcp") {
+        http_ = false;
+    } else {
+        return false;
+    }
+    rest = rest.substr(scheme + 3);
+    const size_t slash = rest.find('/');
+    target_ = http_ ? (slash == std::string::npos ? "/write" : rest.substr(slash)) : std::string();
+    if (slash != std::string::npos) rest.resize(slash);
+    port_ = http_ ? 8086 : 8094;
+    const size_t colon = rest.rfind(':');
+    if (colon != std::string::npos) {
+        char* end = nullptr;
+        unsigned long p = std::strtoul(rest.c_str() + colon + 1, &end, 10);
+        if (end == rest.c_str() + colon + 1 || *end != '\0' || p == 0 || p > 65535) return false;
+        port_ = static_cast<uint16_t>(p);
+        rest.resize(colon);
+    }
+    if (rest.empty()) return false;
+    host_ = rest;
+    configured_ = true;
+    used_ = 0;
+    pending_lines_ = 0;
+    if (!connect_now()) retry_at_ = clock::now() + std::chrono::milliseconds(kInfluxRetryMs);
+    return true;
+}
+
+void InfluxSink::close() {
+    if (!configured_) return;
+    if (used_ > 0) {
+        retry_at_ = clock::time_point{}; // one last attempt, whatever the backoff says
+        if (!flush()) drop_batch();      // no later chance: count what is lost
+    }
+    disconnect();
+    configured_ = false;
+}
+
+void InfluxSink::set_flush(size_t bytes, std::chrono::milliseconds max_age) {
+    flush_bytes_ = bytes == 0 ? 1 : (bytes > sizeof(buf_) ? sizeof(buf_) : bytes);
+    max_age_ = max_age;
+}
+
+bool InfluxSink::connect_now() {
+    struct addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* res = nullptr;
+    char port_str[8];
+    std::snprintf(port_str, sizeof(port_str), "%u", (unsigned)port_);
+    if (::getaddrinfo(host_.c_str(), port_str, &hints, &res) != 0 || res == nullptr) return false;
+    for (struct addrinfo* ai = res; ai != nullptr && fd_ < 0; ai = ai->ai_next) {
+        int fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) continue;
+        if (::connect(fd, ai->ai_addr, ai->ai_addrlen) != 0) {
+            int err = 0;
+            socklen_t elen = sizeof(err);
+            struct pollfd p{fd, POLLOUT, 0};
+            if (errno != EINPROGRESS || ::poll(&p, 1, io_timeout_ms_) <= 0 ||
+                ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &elen) != 0 || err != 0) {
+                ::close(fd);
+                continue;
+            }
+        }
+        // Blocking from here on, bounded by the I/O timeout: this thread has nothing else to do
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+        struct timeval tv{io_timeout_ms_ / 1000, (io_timeout_ms_ % 1000) * 1000};
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)); // batches are already large
+        fd_ = fd;
+    }
+    ::freeaddrinfo(res);
+    if (fd_ < 0) return false;
+    ++connects_;
+    rx_len_ = 0;
+    return true;
+}
+
+void InfluxSink::disconnect() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    rx_len_ = 0;
+}
+
+bool InfluxSink::write(const Frame& f) {
+    if (!configured_) return false;
+    const size_t need = f.len + (f.len > 0 && f.data[f.len - 1] != '\n' ? 1 : 0);
+    if (need == 0) return true;
+    if (need > sizeof(buf_)) {
+        ++dropped_lines_;
+        return false;
+    }
+    if (used_ + need > sizeof(buf_) && !flush()) drop_batch(); // keep the newest data
+    if (used_ == 0) oldest_ = clock::now();
+    std::memcpy(buf_ + used_, f.data, f.len);
+    used_ += f.len;
+    if (need > f.len) buf_[used_++] = '\n';
+    for (size_t i = 0; i < f.len; ++i) pending_lines_ += f.data[i] == '\n' ? 1u : 0u;
+    pending_lines_ += need > f.len ? 1u : 0u;
+    if (used_ >= flush_bytes_) (void)flush();
+    return true;
+}
+
+void InfluxSink::idle() {
+    if (used_ > 0 && clock::now() - oldest_ >= max_age_) (void)flush();
+}
+
+bool InfluxSink::flush() {
+    if (used_ == 0) return true;
+    // A kept-alive connection may have been closed by the server since the last batch: a failure on
+    // a reused connection earns one immediate retry on a fresh one
+    bool reused = fd_ >= 0;
+    if (fd_ < 0) {
+        if (clock::now() < retry_at_) return false;
+        if (!connect_now()) {
+            ++send_failures_;
+            retry_at_ = clock::now() + std::chrono::milliseconds(kInfluxRetryMs);
+            return false;
+        }
+    }
+    Outcome out = send_batch();
+    if (out == Outcome::Retry && reused) {
+        disconnect();
+        if (connect_now()) out = send_batch();
+    }
+    switch (out) {
+    case Outcome::Sent:
+        ++batches_;
+        lines_ += pending_lines_;
+        bytes_sent_ += used_;
+        used_ = 0;
+        pending_lines_ = 0;
+        return true;
+    case Outcome::Rejected:
+        drop_batch();
+        return false;
+    case Outcome::Retry:
+        break;
+    }
+    ++send_failures_;
+    disconnect();
+    retry_at_ = clock::now() + std::chrono::milliseconds(kInfluxRetryMs);
+    return false;
+}
+
+void InfluxSink::drop_batch() {
+    dropped_lines_ += pending_lines_;
+    used_ = 0;
+    pending_lines_ = 0;
+}
+
+InfluxSink::Outcome InfluxSink::send_batch() {
+    if (!http_) {
+        last_status_ = 0;
+        return send_all(nullptr, 0, buf_, used_) ? Outcome::Sent : Outcome::Retry;
+    }
+    char head[512];
+    const int n = std::snprintf(head, sizeof(head),
+                                "POST %s HTTP/1.1\r\nHost: %s:%u\r\nContent-Type: text/plain; charset=utf-8\r\n"
+                                "Content-Length: %zu\r\n\r\n",
+                                target_.c_str(), host_.c_str(), (unsigned)port_, used_);
+    if (n <= 0 || (size_t)n >= sizeof(head)) return Outcome::Rejected;
+    if (!send_all(head, (size_t)n, buf_, used_)) return Outcome::Retry;
+    last_status_ = read_http_status();
+    if (last_status_ >= 200 && last_status_ < 300) return Outcome::Sent;
+    if (last_status_ >= 400 && last_status_ < 500) return Outcome::Rejected; // bad data or auth: retrying will not help
+    return Outcome::Retry;
+}
+
+bool InfluxSink::send_all(const void* hdr, size_t hdr_len, const void* body, size_t body_len) {
+    struct iovec iov[2] = {{const_cast<void*>(hdr), hdr_len}, {const_cast<void*>(body), body_len}};
+    struct iovec* v = hdr_len > 0 ? iov : iov + 1;
+    int cnt = hdr_len > 0 ? 2 : 1;
+    while (cnt > 0) {
+        struct msghdr msg{};
+        msg.msg_iov = v;
+        msg.msg_iovlen = static_cast<size_t>(cnt);
+        ssize_t w = ::sendmsg(fd_, &msg, MSG_NOSIGNAL);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return false; // includes EAGAIN: SO_SNDTIMEO expired
+        }
+        size_t done = static_cast<size_t>(w);
+        while (cnt > 0 && done >= v->iov_len) {
+            done -= v->iov_len;
+            ++v;
+            --cnt;
+        }
+        if (cnt > 0) {
+            v->iov_base = static_cast<char*>(v->iov_base) + done;
+            v->iov_len -= done;
+        }
+    }
+    return true;
+}
+
+// Read one response: status line and headers, then skip Content-Length bytes of body.
+int InfluxSink::read_http_status() {
+    rx_len_ = 0;
+    const char* end = nullptr;
+    while (end == nullptr) {
+        if (rx_len_ == sizeof(rx_)) return -1; // headers larger than we care to parse
+        ssize_t r = ::recv(fd_, rx_ + rx_len_, sizeof(rx_) - rx_len_, 0);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return -1;
+        rx_len_ += static_cast<size_t>(r);
+        for (size_t i = 3; i < rx_len_ && end == nullptr; ++i)
+            if (std::memcmp(rx_ + i - 3, "\r\n\r\n", 4) == 0) end = rx_ + i + 1;
+    }
+    const size_t head_len = static_cast<size_t>(end - rx_);
+    int status = -1;
+    if (head_len > 12 && std::memcmp(rx_, "HTTP/1.", 7) == 0) status = std::atoi(rx_ + 9);
+    const char* cl = find_header(rx_, head_len, "content-length:");
+    size_t body = cl != nullptr ? std::strtoul(cl, nullptr, 10) : 0;
+    const char* conn = find_header(rx_, head_len, "connection:");
+    const bool close_after = conn != nullptr && ::strncasecmp(conn, "close", 5) == 0;
+    size_t have = rx_len_ - head_len;
+    while (have < body) {
+        ssize_t r = ::recv(fd_, rx_, body - have < sizeof(rx_) ? body - have : sizeof(rx_), 0);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return -1;
+        have += static_cast<size_t>(r);
+    }
+    rx_len_ = 0;
+    if (close_after) disconnect();
+    return status;
+}
+
+} // namespace industrial
@@ -0,0 +1,233 @@
+/**
+ * @file LocalSubServer.cpp
+ * @brief Unix domain socket subscription server and client (protocol in industrial/LocalSubServer.hpp).
+ */
+#include "industrial/LocalSubServer.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace industrial {
+
+namespace {
+
+enum : uint8_t {
+    kOpSubscribe = 'S',
+    kOpUnsubscribe = 'U',
+    kRecAck = 'A',
+    kRecData = 'D',
+    kFlagBinary = 0x01,
+};
+
+bool make_addr(const std::string& path, sockaddr_un& addr) {
+    addr = {};
+    addr.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) return false;
+    std::memcpy(addr.sun_path, path.data(), path.size());
+    return true;
+}
+
+} // namespace
+
+LocalSubServer::LocalSubServer() {
+    for (int& fd : fds_) fd = -1;
+}
+
+LocalSubServer::~LocalSubServer() { close(); }
+
+bool LocalSubServer::open(const std::string& path) {
+    close();
+    sockaddr_un addr;
+    if (!make_addr(path, addr)) return false;
+    int fd = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return false;
+    (void)::unlink(path.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, 16) != 0) {
+        ::close(fd);
+        return false;
+    }
+    listen_fd_ = fd;
+    path_ = path;
+    return true;
+}
+
+void LocalSubServer::close() {
+    for (uint32_t c = 0; c < kLocalSubMaxClients; ++c)
+        if (fds_[c] >= 0) drop_client(c);
+    if (listen_fd_ >= 0) {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        (void)::unlink(path_.c_str());
+    }
+    trie_.clear();
+    ++gen_;
+}
+
+void LocalSubServer::drop_client(uint32_t c) {
+    ::close(fds_[c]);
+    fds_[c] = -1;
+    --clients_;
+    trie_.remove_all(c);
+    ++gen_;
+}
+
+void LocalSubServer::service() {
+    since_service_ = 0;
+    if (listen_fd_ < 0) return;
+    for (;;) {
+        int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) break;
+        uint32_t slot = 0;
+        while (slot < kLocalSubMaxClients && fds_[slot] >= 0) ++slot;
+        if (slot == kLocalSubMaxClients) { // full: refuse by closing
+            ::close(fd);
+            continue;
+        }
+        fds_[slot] = fd;
+        ++clients_;
+    }
+    char msg[kLocalSubMaxRecord];
+    for (uint32_t c = 0; c < kLocalSubMaxClients; ++c) {
+        while (fds_[c] >= 0) {
+            ssize_t n = ::recv(fds_[c], msg, sizeof(msg), MSG_DONTWAIT);
+            if (n > 0) {
+                handle(c, msg, static_cast<size_t>(n));
+            } else if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                drop_client(c);
+            } else {
+                break;
+            }
+        }
+    }
+}
+
+void LocalSubServer::handle(uint32_t c, const char* msg, size_t n) {
+    const std::string_view filter(msg + 1, n - 1);
+    bool ok = false;
+    if (msg[0] == kOpSubscribe) {
+        ok = trie_.add(filter, c);
+    } else if (msg[0] == kOpUnsubscribe) {
+        ok = trie_.remove(filter, c);
+    }
+    ++gen_;
+    uint8_t hdr[2] = {kRecAck, static_cast<uint8_t>(ok ? 0 : 1)};
+    iovec iov[2] = {{hdr, sizeof(hdr)}, {const_cast<char*>(filter.data()), filter.size()}};
+    msghdr mh{};
+    mh.msg_iov = iov;
+    mh.msg_iovlen = 2;
+    if (::sendmsg(fds_[c], &mh, MSG_DONTWAIT | MSG_NOSIGNAL) < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+        drop_client(c);
+}
+
+LocalSubServer::Trie::Mask LocalSubServer::lookup(std::string_view topic) {
+    CacheEntry& e = cache_[(reinterpret_cast<uintptr_t>(topic.data()) >> 3) % kCacheSlots];
+    if (e.topic == topic.data() && e.len == topic.size() && e.gen == gen_) return e.mask;
+    e.topic = topic.data();
+    e.len = topic.size();
+    e.gen = gen_;
+    e.mask = trie_.match(topic);
+    return e.mask;
+}
+
+bool LocalSubServer::write(const Frame& f) {
+    if (listen_fd_ < 0) return false;
+    if (++since_service_ >= kServiceEvery) service();
+    if (clients_ == 0 || f.topic.size() > 0xFFFF) return true;
+    Trie::Mask mask = lookup(f.topic);
+    if (mask == 0) return true;
+
+    uint8_t hdr[4] = {kRecData, static_cast<uint8_t>(f.binary ? kFlagBinary : 0),
+                      static_cast<uint8_t>(f.topic.size()), static_cast<uint8_t>(f.topic.size() >> 8)};
+    iovec iov[3] = {{hdr, sizeof(hdr)},
+                    {const_cast<char*>(f.topic.data()), f.topic.size()},
+                    {const_cast<uint8_t*>(f.data), f.len}};
+    msghdr mh{};
+    mh.msg_iov = iov;
+    mh.msg_iovlen = 3;
+    while (mask != 0) {
+        const uint32_t c = static_cast<uint32_t>(__builtin_ctzll(mask));
+        mask &= mask - 1;
+        if (::sendmsg(fds_[c], &mh, MSG_DONTWAIT | MSG_NOSIGNAL) >= 0) {
+            ++delivered_;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) {
+            ++dropped_; // slow reader: skip this frame for it only
+        } else {
+            drop_client(c);
+        }
+    }
+    return true;
+}
+
+LocalSubClient::~LocalSubClient() { close(); }
+
+bool LocalSubClient::connect(const std::string& path) {
+    close();
+    sockaddr_un addr;
+    if (!make_addr(path, addr)) return false;
+    int fd = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd < 0) return false;
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return false;
+    }
+    fd_ = fd;
+    return true;
+}
+
+void LocalSubClient::close() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool LocalSubClient::request(char op, std::string_view filter, int timeout_ms) {
+    if (fd_ < 0 || filter.empty() || filter.size() > sizeof(buf_) - 2) return false;
+    buf_[0] = static_cast<uint8_t>(op);
+    std::memcpy(buf_ + 1, filter.data(), filter.size());
+    if (::send(fd_, buf_, 1 + filter.size(), MSG_NOSIGNAL) < 0) return false;
+    using clock = std::chrono::steady_clock;
+    const auto deadline = clock::now() + std::chrono::milliseconds(timeout_ms);
+    for (;;) {
+        const int left = static_cast<int>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock::now()).count());
+        if (left < 0) return false;
+        Message m = recv(left);
+        if (m.kind == Kind::None) return false;
+        if ((m.kind == Kind::Ack || m.kind == Kind::Nack) && m.topic == filter) return m.kind == Kind::Ack;
+    }
+}
+
+LocalSubClient::Message LocalSubClient::recv(int timeout_ms) {
+    Message m;
+    if (fd_ < 0) return m;
+    pollfd p{fd_, POLLIN, 0};
+    if (::poll(&p, 1, timeout_ms) <= 0) return m;
+    ssize_t n = ::recv(fd_, buf_, sizeof(buf_), 0);
+    if (n <= 0) {
+        if (n == 0) close(); // server went away
+        return m;
+    }
+    const char* b = reinterpret_cast<const char*>(buf_);
+    if (buf_[0] == kRecAck && n >= 2) {
+        m.kind = buf_[1] == 0 ? Kind::Ack : Kind::Nack;
+        m.topic = std::string_view(b + 2, static_cast<size_t>(n) - 2);
+    } else if (buf_[0] == kRecData && n >= 4) {
+        const size_t tlen = buf_[2] | (static_cast<size_t>(buf_[3]) << 8);
+        if (4 + tlen > static_cast<size_t>(n)) return m;
+        m.kind = Kind::Data;
+        m.binary = (buf_[1] & kFlagBinary) != 0;
+        m.topic = std::string_view(b + 4, tlen);
+        m.data = buf_ + 4 + tlen;
+        m.len = static_cast<size_t>(n) - 4 - tlen;
+    }
+    return m;
+}
+
+} // namespace industrial
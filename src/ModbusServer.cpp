@@ -0,0 +1,274 @@
+/**
+ * @file ModbusServer.cpp
+ * @brief Modbus TCP FC 3/4 server over one epoll loop (see industrial/ModbusServer.hpp).
+ */
+#include "industrial/ModbusServer.hpp"
+
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace industrial {
+
+namespace {
+
+constexpr uint32_t kListenTag = kModbusMaxClients;     // epoll data for the listening socket
+constexpr uint32_t kWakeTag = kModbusMaxClients + 1;   // ... and for the stop() doorbell
+constexpr size_t kMbapLen = 7;                         // transaction, protocol, length, unit
+constexpr uint32_t kEventsPerWait = 64;
+
+inline uint16_t get_be16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+
+inline void put_be16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v >> 8);
+    p[1] = static_cast<uint8_t>(v);
+}
+
+uint16_t scaled(float v, float scale) {
+    const double r = static_cast<double>(v) * static_cast<double>(scale);
+    if (std::isnan(r)) return 0x8000;
+    if (r >= 32767.0) return 32767;
+    if (r <= -32767.0) return static_cast<uint16_t>(-32767);
+    return static_cast<uint16_t>(static_cast<int16_t>(std::lround(r)));
+}
+
+} // namespace
+
+ModbusServer::ModbusServer() = default;
+
+ModbusServer::~ModbusServer() { close(); }
+
+bool ModbusServer::open(uint16_t port, const char* addr) {
+    close();
+    sockaddr_in sa{};
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons(port);
+    if (::inet_pton(AF_INET, addr, &sa.sin_addr) != 1) return false;
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return false;
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    socklen_t alen = sizeof(sa);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&sa), sizeof(sa)) != 0 || ::listen(fd, 128) != 0 ||
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&sa), &alen) != 0) {
+        ::close(fd);
+        return false;
+    }
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u32 = kListenTag;
+    bool ok = epoll_fd_ >= 0 && wake_fd_ >= 0 && ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) == 0;
+    ev.data.u32 = kWakeTag;
+    ok = ok && ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev) == 0;
+    listen_fd_ = fd;
+    if (!ok) {
+        close();
+        return false;
+    }
+    port_ = ntohs(sa.sin_port);
+    return true;
+}
+
+void ModbusServer::close() {
+    stop();
+    for (uint32_t c = 0; c < kModbusMaxClients; ++c)
+        if (conns_[c].fd >= 0) drop_client(c);
+    int* fds[] = {&listen_fd_, &epoll_fd_, &wake_fd_};
+    for (int* fd : fds) {
+        if (*fd >= 0) ::close(*fd);
+        *fd = -1;
+    }
+    port_ = 0;
+}
+
+bool ModbusServer::map(Table t, uint16_t address, uint32_t channel, float scale) {
+    if (address >= kModbusRegisters || channel >= kModbusChannels) return false;
+    regs_[static_cast<int>(t)][address] = {Source::Channel, static_cast<uint8_t>(channel), scale};
+    return true;
+}
+
+bool ModbusServer::map_counter(Table t, uint16_t address) {
+    if (address >= kModbusRegisters) return false;
+    regs_[static_cast<int>(t)][address] = {Source::Counter, 0, 1.0f};
+    return true;
+}
+
+void ModbusServer::update(const float* values, uint32_t n) {
+    Image img{};
+    if (n > kModbusChannels) n = kModbusChannels;
+    std::memcpy(img.values, values, n * sizeof(float));
+    img.updates = ++update_count_;
+    image_.store(img);
+}
+
+bool ModbusServer::start() {
+    if (listen_fd_ < 0) return false;
+    if (running_.exchange(true)) return true;
+    thread_ = std::thread([this] {
+        while (running_.load(std::memory_order_relaxed)) (void)poll(-1);
+    });
+    return true;
+}
+
+void ModbusServer::stop() {
+    if (!running_.exchange(false)) return;
+    const uint64_t one = 1;
+    (void)!::write(wake_fd_, &one, sizeof(one));
+    if (thread_.joinable()) thread_.join();
+}
+
+bool ModbusServer::poll(int timeout_ms) {
+    if (epoll_fd_ < 0) return false;
+    epoll_event events[kEventsPerWait];
+    const int n = ::epoll_wait(epoll_fd_, events, kEventsPerWait, timeout_ms);
+    for (int i = 0; i < n; ++i) {
+        const uint32_t tag = events[i].data.u32;
+        if (tag == kListenTag) {
+            accept_all();
+        } else if (tag == kWakeTag) {
+            uint64_t v;
+            (void)!::read(wake_fd_, &v, sizeof(v));
+        } else if (conns_[tag].fd >= 0) {
+            serve(tag);
+        }
+    }
+    return true;
+}
+
+void ModbusServer::accept_all() {
+    for (;;) {
+        int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;
+        uint32_t slot = 0;
+        while (slot < kModbusMaxClients && conns_[slot].fd >= 0) ++slot;
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.u32 = slot;
+        if (slot == kModbusMaxClients || ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            ::close(fd); // full: refuse by closing
+            continue;
+        }
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)); // responses are tiny and awaited
+        conns_[slot].fd = fd;
+        conns_[slot].len = 0;
+        clients_.fetch_add(1, std::memory_order_relaxed);
+        connects_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ModbusServer::drop_client(uint32_t slot) {
+    Conn& c = conns_[slot];
+    if (epoll_fd_ >= 0) ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, c.fd, nullptr);
+    ::close(c.fd);
+    c.fd = -1;
+    c.len = 0;
+    clients_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void ModbusServer::serve(uint32_t slot) {
+    Conn& c = conns_[slot];
+    const ssize_t r = ::recv(c.fd, c.rx + c.len, sizeof(c.rx) - c.len, MSG_DONTWAIT);
+    if (r == 0 || (r < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        drop_client(slot);
+        return;
+    }
+    if (r < 0) return;
+    c.len += static_cast<uint32_t>(r);
+
+    // One snapshot per batch: every request answered here sees the same update
+    const Image img = image_.load();
+    uint8_t tx[16 * kModbusMaxAdu];
+    size_t tx_len = 0;
+    size_t off = 0;
+    bool alive = true;
+    while (alive && c.len - off >= kMbapLen) {
+        const uint8_t* adu = c.rx + off;
+        const uint16_t len = get_be16(adu + 4);
+        if (get_be16(adu + 2) != 0 || len < 2 || len > kModbusMaxAdu - 6) {
+            alive = false; // not Modbus: nothing later in the stream can be trusted
+            break;
+        }
+        if (c.len - off < 6u + len) break;
+        const size_t n = respond(adu, 6u + len, img, tx + tx_len);
+        tx_len += n;
+        off += 6u + len;
+        if (tx_len + kModbusMaxAdu > sizeof(tx) || c.len - off < kMbapLen) {
+            if (::send(c.fd, tx, tx_len, MSG_DONTWAIT | MSG_NOSIGNAL) != static_cast<ssize_t>(tx_len)) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                alive = false;
+            }
+            tx_len = 0;
+        }
+    }
+    if (alive && tx_len > 0 &&
+        ::send(c.fd, tx, tx_len, MSG_DONTWAIT | MSG_NOSIGNAL) != static_cast<ssize_t>(tx_len)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        alive = false;
+    }
+    if (!alive) {
+        drop_client(slot);
+        return;
+    }
+    c.len -= static_cast<uint32_t>(off);
+    if (c.len > 0 && off > 0) std::memmove(c.rx, c.rx + off, c.len);
+}
+
+size_t ModbusServer::respond(const uint8_t* adu, size_t len, const Image& img, uint8_t* out) {
+    requests_.fetch_add(1, std::memory_order_relaxed);
+    const uint8_t* pdu = adu + kMbapLen;
+    const size_t pdu_len = len - kMbapLen;
+    const uint8_t fc = pdu[0];
+    std::memcpy(out, adu, kMbapLen); // transaction id, protocol id, unit id echoed
+    uint8_t ex = 0;
+    uint16_t start = 0;
+    uint16_t qty = 0;
+    if (fc != kFcReadHolding && fc != kFcReadInput) {
+        ex = kExIllegalFunction;
+    } else if (pdu_len != 5) {
+        ex = kExIllegalValue;
+    } else {
+        start = get_be16(pdu + 1);
+        qty = get_be16(pdu + 3);
+        if (qty == 0 || qty > kMaxReadQuantity) {
+            ex = kExIllegalValue;
+        } else if (static_cast<uint32_t>(start) + qty > kModbusRegisters) {
+            ex = kExIllegalAddress;
+        }
+    }
+    if (ex != 0) {
+        exceptions_.fetch_add(1, std::memory_order_relaxed);
+        put_be16(out + 4, 3);
+        out[kMbapLen] = static_cast<uint8_t>(fc | 0x80);
+        out[kMbapLen + 1] = ex;
+        return kMbapLen + 2;
+    }
+    const Reg* table = regs_[fc == kFcReadHolding ? static_cast<int>(Table::Holding) : static_cast<int>(Table::Input)];
+    put_be16(out + 4, static_cast<uint16_t>(3 + 2 * qty));
+    out[kMbapLen] = fc;
+    out[kMbapLen + 1] = static_cast<uint8_t>(2 * qty);
+    uint8_t* p = out + kMbapLen + 2;
+    for (uint16_t i = 0; i < qty; ++i, p += 2) {
+        const Reg& reg = table[start + i];
+        uint16_t v = 0;
+        if (reg.source == Source::Channel) {
+            v = scaled(img.values[reg.channel], reg.scale);
+        } else if (reg.source == Source::Counter) {
+            v = static_cast<uint16_t>(img.updates);
+        }
+        put_be16(p, v);
+    }
+    return kMbapLen + 2 + 2u * qty;
+}
+
+} // namespace industrial
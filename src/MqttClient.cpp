@@ -0,0 +1,433 @@
+/**
+ * @file MqttClient.cpp
+ * @brief MQTT 3.1.1 publish-only client: packet framing, vectored writes, QoS 1 window.
+ *
+ * Packet layouts follow the OASIS MQTT 3.1.1 specification:
+ * - CONNECT  0x10 | rl | 00 04 'M' 'Q' 'T' 'T' | 04 | flags(clean session) | keep-alive | client id
+ * - PUBLISH  0x30 | dup/qos/retain | rl | topic len | topic | [packet id] | payload
+ * - PUBACK   0x40 02 | packet id
+ * - PINGREQ  0xC0 00, PINGRESP 0xD0 00, DISCONNECT 0xE0 00
+ * rl is the variable-length "remaining length" (7 bits per byte, at most 4 bytes).
+ */
+#include "industrial/MqttClient.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace industrial {
+
+namespace {
+
+constexpr uint32_t kMaxRemaining = 268435455u;
+
+// Encode MQTT remaining length; returns bytes written (1..4).
+uint32_t encode_remaining(uint8_t* out, uint32_t v) {
+    uint32_t n = 0;
+    do {
+        uint8_t b = static_cast<uint8_t>(v & 0x7Fu);
+        v >>= 7;
+        if (v) b |= 0x80u;
+        out[n++] = b;
+    } while (v);
+    return n;
+}
+
+void put_u16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v >> 8);
+    p[1] = static_cast<uint8_t>(v);
+}
+
+bool wait_fd(int fd, short events, int timeout_ms) {
+    struct pollfd p{fd, events, 0};
+    int rc;
+    do {
+        rc = ::poll(&p, 1, timeout_ms);
+    } while (rc < 0 && errno == EINTR);
+    return rc > 0 && (p.revents & (events | POLLERR | POLLHUP)) != 0;
+}
+
+} // namespace
+
+MqttClient::~MqttClient() { disconnect(); }
+
+bool MqttClient::parse_uri(const std::string& uri, std::string& host, uint16_t& port) {
+    std::string rest = uri;
+    const size_t scheme = rest.find("://");
+    if (scheme != std::string::npos) {
+        const std::string s = rest.substr(0, scheme);
+        if (s != "tcp" && s != "mqtt") return false;
+        rest = rest.substr(scheme + 3);
+    }
+    port = 1883;
+    const size_t colon = rest.rfind(':');
+    if (colon != std::string::npos) {
+        char* end = nullptr;
+        unsigned long p = std::strtoul(rest.c_str() + colon + 1, &end, 10);
+        if (end == rest.c_str() + colon + 1 || *end != '\0' || p == 0 || p > 65535) return false;
+        port = static_cast<uint16_t>(p);
+        rest = rest.substr(0, colon);
+    }
+    if (rest.empty()) return false;
+    host = rest;
+    return true;
+}
+
+int64_t MqttClient::now_ms() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+MqttClient::Result MqttClient::fail(Result r) {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    tx_used_ = 0;
+    done_frames_ += queued_frames_;
+    iov_count_ = iov_pos_ = queued_frames_ = 0;
+    inflight_ = 0;
+    rx_len_ = skip_ = 0;
+    ping_sent_ms_ = 0;
+    return r;
+}
+
+MqttClient::Result MqttClient::connect(const std::string& host, uint16_t port, const std::string& client_id,
+                                       uint16_t keep_alive_s, int timeout_ms) {
+    if (fd_ >= 0) disconnect();
+    if (client_id.size() > 65535u) return Result::TooLarge;
+
+    struct addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* res = nullptr;
+    char port_str[8];
+    std::snprintf(port_str, sizeof(port_str), "%u", (unsigned)port);
+    if (::getaddrinfo(host.c_str(), port_str, &hints, &res) != 0 || res == nullptr) return Result::ResolveFailed;
+
+    Result rc = Result::ConnectFailed;
+    for (struct addrinfo* ai = res; ai != nullptr; ai = ai->ai_next) {
+        int fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) continue;
+        if (::connect(fd, ai->ai_addr, ai->ai_addrlen) != 0) {
+            if (errno != EINPROGRESS) {
+                ::close(fd);
+                continue;
+            }
+            int err = 0;
+            socklen_t elen = sizeof(err);
+            if (!wait_fd(fd, POLLOUT, timeout_ms) ||
+                ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &elen) != 0 || err != 0) {
+                ::close(fd);
+                rc = Result::ConnectFailed;
+                continue;
+            }
+        }
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)); // batching is ours to do
+        fd_ = fd;
+        break;
+    }
+    ::freeaddrinfo(res);
+    if (fd_ < 0) return rc;
+
+    keep_alive_s_ = keep_alive_s;
+    next_id_ = 1;
+
+    // CONNECT with clean session
+    const uint32_t rl = 10u + 2u + static_cast<uint32_t>(client_id.size());
+    uint8_t* p = arena_alloc(5 + 10 + 2);
+    uint32_t n = 0;
+    p[n++] = 0x10;
+    n += encode_remaining(p + n, rl);
+    const uint8_t vh[10] = {0x00, 0x04, 'M', 'Q', 'T', 'T', 0x04, 0x02,
+                            static_cast<uint8_t>(keep_alive_s >> 8), static_cast<uint8_t>(keep_alive_s)};
+    std::memcpy(p + n, vh, sizeof(vh));
+    n += sizeof(vh);
+    put_u16(p + n, static_cast<uint16_t>(client_id.size()));
+    n += 2;
+    tx_used_ = n;
+    push_iov(p, n);
+    push_iov(client_id.data(), client_id.size());
+    rc = write_pending(timeout_ms);
+    if (rc != Result::Ok) return fail(rc);
+
+    // Await CONNACK (0x20 0x02 flags rc)
+    const int64_t deadline = now_ms() + timeout_ms;
+    while (rx_len_ < 4) {
+        const int64_t left = deadline - now_ms();
+        if (left <= 0 || !wait_fd(fd_, POLLIN, (int)left)) return fail(Result::Timeout);
+        ssize_t r = ::recv(fd_, rx_ + rx_len_, sizeof(rx_) - rx_len_, 0);
+        if (r == 0) return fail(Result::IoError);
+        if (r < 0) {
+            if (errno == EAGAIN || errno == EINTR) continue;
+            return fail(Result::IoError);
+        }
+        rx_len_ += static_cast<uint32_t>(r);
+    }
+    if (rx_[0] != 0x20 || rx_[1] != 0x02) return fail(Result::ProtocolError);
+    if (rx_[3] != 0) return fail(Result::Refused);
+    std::memmove(rx_, rx_ + 4, rx_len_ - 4);
+    rx_len_ -= 4;
+    last_tx_ms_ = now_ms();
+    return Result::Ok;
+}
+
+void MqttClient::disconnect() {
+    if (fd_ < 0) return;
+    // Drop anything unsent; a clean DISCONNECT tells the broker not to publish a will
+    tx_used_ = 0;
+    done_frames_ += queued_frames_;
+    iov_count_ = iov_pos_ = queued_frames_ = 0;
+    static const uint8_t kDisconnect[2] = {0xE0, 0x00};
+    (void)::send(fd_, kDisconnect, sizeof(kDisconnect), MSG_NOSIGNAL);
+    (void)fail(Result::Ok);
+}
+
+uint8_t* MqttClient::arena_alloc(size_t n) {
+    if (tx_used_ + n > sizeof(tx_)) return nullptr;
+    uint8_t* p = tx_ + tx_used_;
+    tx_used_ += n;
+    return p;
+}
+
+bool MqttClient::push_iov(const void* p, size_t n) {
+    if (n == 0) return true;
+    if (iov_count_ == kMqttMaxIov) return false;
+    // Coalesce with the previous vector when the bytes are contiguous (arena-resident frames)
+    if (iov_count_ > iov_pos_) {
+        struct iovec& last = iov_[iov_count_ - 1];
+        if (static_cast<uint8_t*>(last.iov_base) + last.iov_len == p) {
+            last.iov_len += n;
+            return true;
+        }
+    }
+    iov_[iov_count_].iov_base = const_cast<void*>(p);
+    iov_[iov_count_].iov_len = n;
+    ++iov_count_;
+    return true;
+}
+
+MqttClient::Result MqttClient::queue_publish(std::string_view topic, const void* payload, size_t len,
+                                             int qos, bool retain, bool copy) {
+    if (fd_ < 0) return Result::NotConnected;
+    qos = qos > 0 ? 1 : 0;
+    const size_t vh = 2u + topic.size() + (qos ? 2u : 0u);
+    if (topic.empty() || topic.size() > 65535u || vh + len > kMaxRemaining) return Result::TooLarge;
+    const size_t frame_arena = 5u + vh + (copy ? len : 0u);
+    if (frame_arena > sizeof(tx_)) return Result::TooLarge;
+
+    if (qos && inflight_ >= max_inflight_) {
+        Result rc = poll(0); // maybe acks are already waiting
+        if (rc != Result::Ok) return rc;
+        if (inflight_ >= max_inflight_) return Result::WindowFull;
+    }
+    if (tx_used_ + frame_arena > sizeof(tx_) || iov_count_ + 2u > kMqttMaxIov) {
+        Result rc = flush(kMqttIoTimeoutMs);
+        if (rc != Result::Ok) return rc;
+    }
+
+    uint8_t* p = arena_alloc(5u + vh);
+    uint32_t n = 0;
+    p[n++] = static_cast<uint8_t>(0x30u | (qos ? 0x02u : 0u) | (retain ? 0x01u : 0u));
+    n += encode_remaining(p + n, static_cast<uint32_t>(vh + len));
+    put_u16(p + n, static_cast<uint16_t>(topic.size()));
+    n += 2;
+    std::memcpy(p + n, topic.data(), topic.size());
+    n += static_cast<uint32_t>(topic.size());
+    if (qos) {
+        const uint16_t id = next_id_;
+        next_id_ = static_cast<uint16_t>(next_id_ == 65535u ? 1u : next_id_ + 1u);
+        put_u16(p + n, id);
+        n += 2;
+        inflight_ids_[inflight_++] = id;
+    }
+    tx_used_ -= (5u + vh) - n; // give back unused remaining-length bytes
+    push_iov(p, n);
+    if (copy) {
+        uint8_t* c = arena_alloc(len);
+        std::memcpy(c, payload, len);
+        push_iov(c, len);
+    } else {
+        push_iov(payload, len);
+    }
+    ++queued_frames_;
+    return Result::Ok;
+}
+
+MqttClient::Result MqttClient::flush(int timeout_ms) {
+    if (fd_ < 0) return Result::NotConnected;
+    return write_pending(timeout_ms);
+}
+
+MqttClient::Result MqttClient::write_pending(int timeout_ms) {
+    const int64_t deadline = now_ms() + timeout_ms;
+    while (iov_pos_ < iov_count_) {
+        const int cnt = static_cast<int>(iov_count_ - iov_pos_);
+        struct msghdr msg{};
+        msg.msg_iov = iov_ + iov_pos_;
+        msg.msg_iovlen = static_cast<size_t>(cnt > IOV_MAX ? IOV_MAX : cnt);
+        ssize_t w = ::sendmsg(fd_, &msg, MSG_NOSIGNAL); // writev() semantics without SIGPIPE
+        ++write_calls_;
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) return fail(Result::IoError);
+            const int64_t left = deadline - now_ms();
+            if (left <= 0 || !wait_fd(fd_, POLLOUT, (int)left)) return Result::Timeout; // batch kept
+            continue;
+        }
+        size_t done = static_cast<size_t>(w);
+        while (done > 0 && iov_pos_ < iov_count_) {
+            struct iovec& v = iov_[iov_pos_];
+            if (done >= v.iov_len) {
+                done -= v.iov_len;
+                ++iov_pos_;
+            } else {
+                v.iov_base = static_cast<uint8_t*>(v.iov_base) + done;
+                v.iov_len -= done;
+                done = 0;
+            }
+        }
+    }
+    tx_used_ = 0;
+    done_frames_ += queued_frames_;
+    iov_count_ = iov_pos_ = queued_frames_ = 0;
+    last_tx_ms_ = now_ms();
+    return Result::Ok;
+}
+
+MqttClient::Result MqttClient::poll(int timeout_ms) {
+    if (fd_ < 0) return Result::NotConnected;
+    if (timeout_ms <= 0 || wait_fd(fd_, POLLIN, timeout_ms)) {
+        Result rc = read_available();
+        if (rc != Result::Ok) return rc;
+    }
+    const int64_t now = now_ms();
+    if (keep_alive_s_ > 0) {
+        if (ping_sent_ms_ != 0 && now - ping_sent_ms_ > keep_alive_s_ * 1000LL) return fail(Result::Timeout);
+        if (ping_sent_ms_ == 0 && iov_count_ == 0 && now - last_tx_ms_ >= keep_alive_s_ * 500LL) {
+            static const uint8_t kPingReq[2] = {0xC0, 0x00};
+            ssize_t w = ::send(fd_, kPingReq, sizeof(kPingReq), MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (w == (ssize_t)sizeof(kPingReq)) {
+                ping_sent_ms_ = now;
+                last_tx_ms_ = now;
+            } else if (w < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                return fail(Result::IoError);
+            }
+        }
+    }
+    return Result::Ok;
+}
+
+MqttClient::Result MqttClient::wait_acked(int timeout_ms) {
+    const int64_t deadline = now_ms() + timeout_ms;
+    while (inflight_ > 0) {
+        const int64_t left = deadline - now_ms();
+        if (left <= 0) return Result::Timeout;
+        Result rc = poll((int)left);
+        if (rc != Result::Ok) return rc;
+    }
+    return Result::Ok;
+}
+
+MqttClient::Result MqttClient::read_available() {
+    for (;;) {
+        ssize_t r = ::recv(fd_, rx_ + rx_len_, sizeof(rx_) - rx_len_, MSG_DONTWAIT);
+        if (r == 0) return fail(Result::IoError);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return Result::Ok;
+            return fail(Result::IoError);
+        }
+        rx_len_ += static_cast<uint32_t>(r);
+
+        uint32_t off = 0;
+        for (;;) {
+            if (skip_ > 0) {
+                const uint32_t s = rx_len_ - off < skip_ ? rx_len_ - off : skip_;
+                off += s;
+                skip_ -= s;
+                if (skip_ > 0) break;
+            }
+            if (rx_len_ - off < 2) break;
+            uint32_t rl = 0, mult = 1, i = 1;
+            bool complete = false;
+            while (off + i < rx_len_ && i <= 4) {
+                const uint8_t b = rx_[off + i++];
+                rl += (b & 0x7Fu) * mult;
+                mult <<= 7;
+                if ((b & 0x80u) == 0) {
+                    complete = true;
+                    break;
+                }
+            }
+            if (!complete) {
+                if (i > 4) return fail(Result::ProtocolError);
+                break;
+            }
+            const uint8_t type = rx_[off];
+            if (i + rl > sizeof(rx_)) { // larger than we care about: discard as it streams in
+                skip_ = i + rl;
+                continue;
+            }
+            if (rx_len_ - off < i + rl) break;
+            Result rc = handle_packet(type, rx_ + off + i, rl);
+            if (rc != Result::Ok) return fail(rc);
+            off += i + rl;
+        }
+        std::memmove(rx_, rx_ + off, rx_len_ - off);
+        rx_len_ -= off;
+    }
+}
+
+MqttClient::Result MqttClient::handle_packet(uint8_t type, const uint8_t* body, uint32_t len) {
+    switch (type & 0xF0u) {
+    case 0x40: { // PUBACK
+        if (len != 2) return Result::ProtocolError;
+        const uint16_t id = static_cast<uint16_t>((body[0] << 8) | body[1]);
+        for (uint32_t k = 0; k < inflight_; ++k) {
+            if (inflight_ids_[k] == id) {
+                inflight_ids_[k] = inflight_ids_[--inflight_];
+                break;
+            }
+        }
+        return Result::Ok;
+    }
+    case 0xD0: // PINGRESP
+        ping_sent_ms_ = 0;
+        return Result::Ok;
+    case 0x20: // late/duplicate CONNACK
+        return Result::ProtocolError;
+    default:   // SUBACK, PUBLISH etc. are not expected by a publish-only client; ignore
+        return Result::Ok;
+    }
+}
+
+const char* MqttClient::result_name(Result r) {
+    switch (r) {
+    case Result::Ok: return "ok";
+    case Result::NotConnected: return "not-connected";
+    case Result::ResolveFailed: return "resolve-failed";
+    case Result::ConnectFailed: return "connect-failed";
+    case Result::Refused: return "refused";
+    case Result::Timeout: return "timeout";
+    case Result::WindowFull: return "window-full";
+    case Result::TooLarge: return "too-large";
+    case Result::IoError: return "io-error";
+    case Result::ProtocolError: return "protocol-error";
+    }
+    return "unknown";
+}
+
+} // namespace industrial
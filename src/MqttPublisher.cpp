@@ -1,121 +1,293 @@
 /**
  * @file MqttPublisher.cpp
- * @brief Exception-free MQTT publishing backend implemented with Eclipse Paho MQTT C.
+ * @brief Exception-free MQTT publishing facade over the in-tree MqttClient.
  *
- * Implements the runtime of industrial::MqttPublisher using the Paho C API:
+ * Implements the runtime of industrial::MqttPublisher:
  * - Connects with clean session and configurable keep-alive.
- * - Publishes with caller-specified QoS and retain flags.
- * - For QoS > 0, blocks until delivery completion (up to ~5s).
- * - Ensures orderly disconnect on request and in the destructor (~2s timeout).
- *
- * Build-time behavior:
- * - If PAHO_MQTT_C_AVAILABLE is defined, uses the Paho C API directly.
- * - Otherwise, methods act as stubs (feature unavailable) and return false.
+ * - Publishes with caller-specified QoS and retain flags in Sync, Pipelined or Batched mode.
+ * - Keeps pooled payloads referenced (not copied) until the client has written or dropped their frames.
+ * - For QoS > 0 in Sync mode, blocks until delivery completion (up to ~5s).
+ * - Ensures orderly disconnect on request and in the destructor.
+ * - Optionally supervises the session from a background thread and reconnects with
+ *   exponential backoff plus jitter.
  *
  * Error handling:
  * - No exceptions; all operations return boolean success. Callers must check results.
  *
  * Notes:
- * - Manages MQTTClient lifecycle internally.
- * - Not inherently thread-safe; external synchronization may be required.
- * - uses Paho C lib (not the C++ wrapper) since this project targets no-exceptions builds
- *   and the C++ wrapper reports errors via exceptions.
+ * - The publishing thread is the only one touching the client while the state is Connected.
+ *   Loss is detected there (socket errors, keep-alive timeouts in service()); the supervisor
+ *   takes over only after the state has left Connected and waits for in-flight calls (busy_)
+ *   before tearing the old session down.
  */
 #include "industrial/MqttPublisher.hpp"
 
-#if defined(PAHO_MQTT_C_AVAILABLE)
-#include <cstring>
-#include <MQTTClient.h>
-#endif
+#include <chrono>
+
+#include "industrial/Config.hpp"
+#include "industrial/MqttClient.hpp"
 
 namespace industrial {
 
+namespace {
+
+int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// xorshift64*; jitter only needs to de-synchronize clients, not be cryptographic
+double unit_random(uint64_t& s) {
+    s ^= s >> 12;
+    s ^= s << 25;
+    s ^= s >> 27;
+    return (double)((s * 2685821657736338717ULL) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+} // namespace
+
 MqttPublisher::MqttPublisher() = default;
-MqttPublisher::~MqttPublisher() { disconnect(); }
+MqttPublisher::~MqttPublisher() {
+    disconnect();
+    delete client_;
+}
 
 /**
  * @brief Connects to an MQTT broker and initializes the internal MQTT client.
  *
- * Creates a new Eclipse Paho C MQTT client and attempts a clean-session connection
- * to the specified broker. If already connected, the call is a no-op and returns true.
- * The keep-alive interval is set to keepAliveSec if > 0, otherwise defaults to 60 seconds.
- * On success, updates internal state and retains the client handle; on failure, cleans up.
- *
- * @note Requires compilation with PAHO_MQTT_C_AVAILABLE. When not available, the function
- *       performs no connection and returns false.
+ * Attempts a clean-session connection to the specified broker. If already connected, the call is
+ * a no-op and returns true. The keep-alive interval is set to keepAliveSec if > 0, otherwise
+ * defaults to 60 seconds. The parameters are remembered so the reconnect supervisor can reuse them.
  */
 bool MqttPublisher::connect(const std::string& brokerUri, const std::string& clientId, int keepAliveSec) {
-#if defined(PAHO_MQTT_C_AVAILABLE)
-    if (connected_) return true;
-    MQTTClient c = nullptr;
-    int rc = MQTTClient_create(&c, brokerUri.c_str(), clientId.c_str(), MQTTCLIENT_PERSISTENCE_NONE, nullptr);
-    if (rc != MQTTCLIENT_SUCCESS) return false;
-
-    MQTTClient_connectOptions opts = MQTTClient_connectOptions_initializer;
-    opts.keepAliveInterval = keepAliveSec > 0 ? keepAliveSec : 60;
-    opts.cleansession = 1;
-    rc = MQTTClient_connect(c, &opts);
-    if (rc != MQTTCLIENT_SUCCESS) {
-        MQTTClient_destroy(&c);
+    if (state() == State::Connected) return true;
+    uri_ = brokerUri;
+    client_id_ = clientId;
+    keep_alive_ = keepAliveSec > 0 ? keepAliveSec : 60;
+    if (supervising_.load(std::memory_order_acquire)) return false; // supervisor owns the attempts
+    if (!backend_connect()) return false;
+    state_.store(State::Connected, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Starts connecting without waiting for the broker.
+ *
+ * The connection parameters are stored as in connect() and the supervisor thread takes over the
+ * first attempt, so a slow or unreachable broker never delays the caller. The time until the first
+ * session is up is reported like any other recovery (last_recovery_ns()).
+ */
+bool MqttPublisher::connect_async(const std::string& brokerUri, const std::string& clientId, int keepAliveSec,
+                                  const ReconnectPolicy& policy) {
+    if (state() == State::Connected) return true;
+    uri_ = brokerUri;
+    client_id_ = clientId;
+    keep_alive_ = keepAliveSec > 0 ? keepAliveSec : 60;
+    return start_reconnect(policy);
+}
+
+void MqttPublisher::set_mode(Mode mode, uint32_t batch_frames) {
+    mode_ = mode;
+    batch_frames_ = batch_frames == 0 ? 1 : batch_frames;
+}
+
+template <typename Fn>
+bool MqttPublisher::with_client(Fn&& fn) {
+    // Announce the client use before checking state; pairs with supervise()
+    busy_.fetch_add(1, std::memory_order_seq_cst);
+    if (state_.load(std::memory_order_seq_cst) != State::Connected) {
+        busy_.fetch_sub(1, std::memory_order_release);
         return false;
     }
-    client_ = c;
-    connected_ = true;
-    return true;
-#else // suppress 'unused parameter' warnings for these stubs if they are not needed
-    (void)brokerUri; (void)clientId; (void)keepAliveSec;
-    return false;
-#endif
+    const bool ok = fn(*client_);
+    const bool alive = client_->connected();
+    release_done(client_->done_frames()); // a lost session has dropped everything it had queued
+    busy_.fetch_sub(1, std::memory_order_release);
+    if (!alive) mark_lost();
+    return ok;
 }
 
 /**
  * @brief Publish a message to the specified MQTT topic.
  *
- * Publishes the given payload using the configured MQTT client with the provided
- * QoS and retain settings. For QoS 1 or 2, the call blocks until delivery completes
- * or a 5-second timeout elapses.
- *
- * return true on success; false if the client is not connected, if publishing or completion
- * fails, or when built without Paho MQTT C support.
- *
- * @note When PAHO_MQTT_C_AVAILABLE is not defined, this function is a stub that returns false.
+ * return true on success; false if the client is not connected or the write/acknowledgement
+ * fails. While disconnected the call returns immediately without touching the network.
+ * Every call is accounted: success/failure counters, the failing Result and, for calls that
+ * reached the client, the time spent inside publish().
  */
-bool MqttPublisher::publish(const std::string& topic, const void* payload, size_t len, int qos, bool retain) {
-#if defined(PAHO_MQTT_C_AVAILABLE)
-    if (!connected_ || client_ == nullptr) return false;
-    MQTTClient_message msg = MQTTClient_message_initializer;
-    msg.payload = const_cast<void*>(payload);
-    msg.payloadlen = (int)len;
-    msg.qos = qos;
-    msg.retained = retain ? 1 : 0;
-    MQTTClient_deliveryToken token = 0;
-    int rc = MQTTClient_publishMessage((MQTTClient)client_, topic.c_str(), &msg, &token);
-    if (rc != MQTTCLIENT_SUCCESS) return false;
-    if (qos > 0) {
-        rc = MQTTClient_waitForCompletion((MQTTClient)client_, token, 5000L);
-        if (rc != MQTTCLIENT_SUCCESS) return false;
+bool MqttPublisher::publish(std::string_view topic, const void* payload, size_t len, int qos, bool retain,
+                            const PayloadRef& ref) {
+    using R = MqttClient::Result;
+    R why = R::NotConnected; // stays NotConnected if with_client() never runs the lambda
+    const int64_t t0 = now_ns();
+    const bool ok = with_client([&](MqttClient& c) {
+        // With a ref the payload is never copied; without one, Batched mode must copy it
+        const bool hold = ref && len > 0;
+        if (hold && held_len_ == kMaxHeld && (why = c.flush(kMqttIoTimeoutMs)) != R::Ok) return false;
+        release_done(c.done_frames());
+        const uint64_t frame = c.done_frames() + c.queued(); // number our frame gets if queued
+        why = publish_once(c, topic, payload, len, qos, retain, mode_ == Mode::Batched && !hold);
+        // Still queued: a batch, or a write that timed out and kept it (even though the call failed)
+        if (hold && c.done_frames() <= frame && c.done_frames() + c.queued() > frame) {
+            ref.retain();
+            held_[(held_head_ + held_len_) % kMaxHeld] = {frame, ref};
+            held_count_.store(++held_len_, std::memory_order_relaxed);
+        }
+        return why == R::Ok;
+    });
+    if (why != R::NotConnected) publish_latency_.record(now_ns() - t0); // fail-fast calls would only skew it
+    if (ok) {
+        published_.fetch_add(1, std::memory_order_relaxed);
+        bytes_published_.fetch_add(len, std::memory_order_relaxed);
+    } else {
+        failures_[static_cast<uint8_t>(why)].fetch_add(1, std::memory_order_relaxed);
+        last_error_.store(why, std::memory_order_relaxed);
     }
-    return true;
-#else // suppress 'unused parameter' warnings for these stubs if they are not needed
-    (void)topic; (void)payload; (void)len; (void)qos; (void)retain;
-    return false;
-#endif
+    return ok;
 }
 
-// Disconnects from the MQTT broker if connected, destroys the client handle, and resets the connection state.
+MqttClient::Result MqttPublisher::publish_once(MqttClient& c, std::string_view topic, const void* payload, size_t len,
+                                               int qos, bool retain, bool copy) {
+    using R = MqttClient::Result;
+    const bool batched = mode_ == Mode::Batched;
+    R rc = c.queue_publish(topic, payload, len, qos, retain, copy);
+    if (rc == R::WindowFull) {
+        // Pipelined/batched QoS 1: wait for the broker to open the window again
+        if (batched && (rc = c.flush(kMqttIoTimeoutMs)) != R::Ok) return rc;
+        rc = R::WindowFull;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(kMqttIoTimeoutMs);
+        while (rc == R::WindowFull && std::chrono::steady_clock::now() < deadline) {
+            const R pr = c.poll(10);
+            if (pr != R::Ok) return pr;
+            rc = c.queue_publish(topic, payload, len, qos, retain, copy);
+        }
+    }
+    if (rc != R::Ok) return rc;
+    if (batched) return c.queued() < batch_frames_ ? R::Ok : c.flush(kMqttIoTimeoutMs);
+    if ((rc = c.flush(kMqttIoTimeoutMs)) != R::Ok) return rc;
+    if (qos > 0 && mode_ == Mode::Sync) return c.wait_acked(kMqttIoTimeoutMs);
+    return R::Ok;
+}
+
+void MqttPublisher::release_done(uint64_t done_frames) {
+    while (held_len_ > 0 && held_[held_head_].frame < done_frames) {
+        held_[held_head_].ref.release();
+        held_head_ = (held_head_ + 1) % kMaxHeld;
+        held_count_.store(--held_len_, std::memory_order_relaxed);
+    }
+}
+
+uint64_t MqttPublisher::publish_failures() const {
+    uint64_t n = 0;
+    for (const auto& f : failures_) n += f.load(std::memory_order_relaxed);
+    return n;
+}
+
+bool MqttPublisher::flush() {
+    return with_client([](MqttClient& c) { return c.flush(kMqttIoTimeoutMs) == MqttClient::Result::Ok; });
+}
+
+bool MqttPublisher::service() {
+    return with_client([](MqttClient& c) {
+        using R = MqttClient::Result;
+        if (c.queued() > 0 && c.flush(kMqttIoTimeoutMs) != R::Ok) return false;
+        return c.poll(0) == R::Ok;
+    });
+}
+
+// Connected -> Disconnected, remembering when the outage began. Idempotent.
+void MqttPublisher::mark_lost() {
+    State expected = State::Connected;
+    if (state_.compare_exchange_strong(expected, State::Disconnected, std::memory_order_seq_cst)) {
+        lost_at_ns_.store(now_ns(), std::memory_order_relaxed);
+    }
+}
+
+// Disconnects from the MQTT broker if connected and resets the connection state.
 void MqttPublisher::disconnect() {
-#if defined(PAHO_MQTT_C_AVAILABLE)
-    if (client_ != nullptr) {
-        if (connected_) {
-            MQTTClient_disconnect((MQTTClient)client_, 2000);
+    stop_reconnect();
+    if (client_ != nullptr && state() == State::Connected) (void)client_->flush(kMqttIoTimeoutMs);
+    backend_close();
+    if (client_ != nullptr) release_done(client_->done_frames()); // unsent frames were dropped
+    state_.store(State::Disconnected, std::memory_order_release);
+}
+
+bool MqttPublisher::is_connected() const { return state() == State::Connected; }
+
+bool MqttPublisher::start_reconnect(const ReconnectPolicy& policy) {
+    std::string host;
+    uint16_t port = 0;
+    if (!MqttClient::parse_uri(uri_, host, port) || supervising_.exchange(true)) return false;
+    if (state() != State::Connected) lost_at_ns_.store(now_ns(), std::memory_order_relaxed);
+    supervisor_ = std::thread([this, policy] { supervise(policy); });
+    return true;
+}
+
+void MqttPublisher::stop_reconnect() {
+    if (!supervising_.exchange(false)) return;
+    if (supervisor_.joinable()) supervisor_.join();
+}
+
+/**
+ * @brief Supervisor loop: rebuild the session after loss.
+ *
+ * Once the session is lost it waits for in-flight calls to leave the client, closes it, and
+ * retries with delays growing from initial_ms by multiplier up to max_ms, each scaled by a random
+ * factor in [1 - jitter, 1 + jitter]. Recovery time is measured from the moment the loss was detected.
+ */
+void MqttPublisher::supervise(ReconnectPolicy policy) {
+    uint64_t rng = (uint64_t)now_ns() | 1u;
+    double delay_ms = policy.initial_ms;
+    auto sleep_while_running = [this](std::chrono::milliseconds d) {
+        auto until = std::chrono::steady_clock::now() + d;
+        while (supervising_.load(std::memory_order_acquire) && std::chrono::steady_clock::now() < until) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    };
+
+    while (supervising_.load(std::memory_order_acquire)) {
+        if (state() == State::Connected) {
+            sleep_while_running(std::chrono::milliseconds(20));
+            continue;
         }
-        MQTTClient_destroy((MQTTClient*)&client_);
-        client_ = nullptr;
+
+        // Session lost or never established: make sure no publish still holds the old client
+        while (busy_.load(std::memory_order_seq_cst) != 0) std::this_thread::yield();
+        backend_close();
+
+        state_.store(State::Connecting, std::memory_order_release);
+        if (backend_connect()) {
+            const int64_t took = now_ns() - lost_at_ns_.load(std::memory_order_relaxed);
+            last_recovery_ns_.store(took, std::memory_order_relaxed);
+            if (took > max_recovery_ns_.load(std::memory_order_relaxed))
+                max_recovery_ns_.store(took, std::memory_order_relaxed);
+            reconnects_.fetch_add(1, std::memory_order_relaxed);
+            delay_ms = policy.initial_ms;
+            state_.store(State::Connected, std::memory_order_release);
+            continue;
+        }
+
+        connect_failures_.fetch_add(1, std::memory_order_relaxed);
+        state_.store(State::Backoff, std::memory_order_release);
+        const double factor = 1.0 + policy.jitter * (2.0 * unit_random(rng) - 1.0);
+        sleep_while_running(std::chrono::milliseconds((int64_t)(delay_ms * factor)));
+        delay_ms *= policy.multiplier;
+        if (delay_ms > policy.max_ms) delay_ms = policy.max_ms;
+        state_.store(State::Disconnected, std::memory_order_release);
     }
-    connected_ = false;
-#endif
 }
 
-bool MqttPublisher::is_connected() const { return connected_; }
+bool MqttPublisher::backend_connect() {
+    std::string host;
+    uint16_t port = 0;
+    if (!MqttClient::parse_uri(uri_, host, port)) return false;
+    if (client_ == nullptr) client_ = new MqttClient();
+    const uint16_t ka = (uint16_t)(keep_alive_ > 65535 ? 65535 : keep_alive_);
+    return client_->connect(host, port, client_id_, ka, kMqttIoTimeoutMs) == MqttClient::Result::Ok;
+}
+
+void MqttPublisher::backend_close() {
+    if (client_ != nullptr) client_->disconnect();
+}
 
 } // namespace industrial
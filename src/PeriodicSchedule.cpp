@@ -0,0 +1,58 @@
+/**
+ * @file PeriodicSchedule.cpp
+ * @brief Policy parsing and CSV export for the periodic-task timing (see industrial/PeriodicSchedule.hpp).
+ */
+#include "industrial/PeriodicSchedule.hpp"
+
+#include <cstring>
+
+namespace industrial {
+
+namespace {
+
+bool write_buckets(std::FILE* out, const char* series, const LatencyHistogram& h) {
+    for (uint32_t i = 0; i < LatencyHistogram::kBuckets; ++i) {
+        const uint64_t n = h.bucket(i);
+        if (n == 0) continue;
+        if (std::fprintf(out, "%s,%llu,%llu,%llu\n", series, (unsigned long long)LatencyHistogram::lower_edge(i),
+                         (unsigned long long)LatencyHistogram::upper_edge(i), (unsigned long long)n) < 0)
+            return false;
+    }
+    return true;
+}
+
+bool write_summary(std::FILE* out, const char* series, const LatencyHistogram& h) {
+    return std::fprintf(out, "%s_p50_ns,%llu\n%s_p99_ns,%llu\n%s_p999_ns,%llu\n%s_max_ns,%llu\n", series,
+                        (unsigned long long)h.percentile(50), series, (unsigned long long)h.percentile(99), series,
+                        (unsigned long long)h.percentile(99.9), series, (unsigned long long)h.max()) >= 0;
+}
+
+} // namespace
+
+bool PeriodicSchedule::set_policy(const char* name) {
+    if (std::strcmp(name, "catchup") == 0) {
+        policy_ = MissPolicy::CatchUp;
+    } else if (std::strcmp(name, "skip") == 0) {
+        policy_ = MissPolicy::Skip;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool PeriodicSchedule::write_csv(std::FILE* out) const {
+    if (out == nullptr) return false;
+    bool ok = std::fprintf(out, "name,value\nperiod_ns,%lld\npolicy,%s\niterations,%llu\noverruns,%llu\n"
+                                "deadline_misses,%llu\nskipped,%llu\n",
+                           (long long)period_, policy_name(), (unsigned long long)iterations(),
+                           (unsigned long long)overruns(), (unsigned long long)misses(),
+                           (unsigned long long)skipped()) >= 0;
+    ok = ok && write_summary(out, "lateness", lateness_) && write_summary(out, "run", run_) &&
+         write_summary(out, "jitter", jitter_);
+    ok = ok && std::fprintf(out, "\nseries,lower_ns,upper_ns,count\n") >= 0;
+    ok = ok && write_buckets(out, "lateness", lateness_) && write_buckets(out, "run", run_) &&
+         write_buckets(out, "jitter", jitter_);
+    return ok && std::fflush(out) == 0;
+}
+
+} // namespace industrial
@@ -0,0 +1,220 @@
+/**
+ * @file Sinks.cpp
+ * @brief Stdout, file, MQTT and UDP sink implementations (see industrial/Sinks.hpp).
+ */
+#include "industrial/Sinks.hpp"
+
+#include "industrial/MqttPublisher.hpp"
+#include "industrial/Spool.hpp"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <unistd.h>
+
+namespace industrial {
+
+bool StdoutSink::write(const Frame& f) {
+    std::fwrite(f.topic.data(), 1, f.topic.size(), stdout);
+    if (f.binary) {
+        std::fprintf(stdout, " <%zu bytes>\n", f.len);
+        return true;
+    }
+    std::fputc(' ', stdout);
+    std::fwrite(f.data, 1, f.len, stdout);
+    std::fputc('\n', stdout);
+    return true;
+}
+
+void StdoutSink::idle() { std::fflush(stdout); }
+
+FileSink::~FileSink() { close(); }
+
+bool FileSink::open(const std::string& path) {
+    close();
+    f_ = std::fopen(path.c_str(), "ab");
+    if (f_ == nullptr) return false;
+    std::setvbuf(f_, nullptr, _IOFBF, 1u << 16); // batch small records into large writes
+    return true;
+}
+
+void FileSink::close() {
+    if (f_ != nullptr) {
+        std::fclose(f_);
+        f_ = nullptr;
+    }
+}
+
+bool FileSink::write(const Frame& f) {
+    if (f_ == nullptr) return false;
+    bool ok;
+    if (f.binary) {
+        const uint32_t n = static_cast<uint32_t>(f.len);
+        const uint8_t len_le[4] = {uint8_t(n), uint8_t(n >> 8), uint8_t(n >> 16), uint8_t(n >> 24)};
+        ok = std::fwrite(len_le, 1, 4, f_) == 4 && std::fwrite(f.data, 1, f.len, f_) == f.len;
+    } else {
+        ok = std::fwrite(f.data, 1, f.len, f_) == f.len && std::fputc('\n', f_) != EOF;
+    }
+    dirty_ = true;
+    return ok;
+}
+
+void FileSink::idle() {
+    if (dirty_ && f_ != nullptr) {
+        std::fflush(f_);
+        dirty_ = false;
+    }
+}
+
+MqttSink::~MqttSink() {
+    while (backlog_len_ > 0) {
+        backlog_[backlog_head_].ref.release();
+        backlog_head_ = (backlog_head_ + 1) % kMqttBacklogFrames;
+        --backlog_len_;
+    }
+}
+
+bool MqttSink::publish(const Frame& f) {
+    const LaneOptions& o = f.priority ? priority_ : telemetry_;
+    if (!mqtt_.publish(f.topic, f.data, f.len, o.qos, o.retain, f.ref)) return false;
+    if (f.priority && mqtt_.mode() != MqttPublisher::Mode::Sync) (void)mqtt_.flush();
+    return true;
+}
+
+bool MqttSink::write(const Frame& f) {
+    if (mqtt_.is_connected() && replay_backlog()) {
+        if (publish(f)) return true;
+        if (spool_ == nullptr && mqtt_.is_connected()) return false; // rejected by a live session: no retry
+    }
+    if (spool_ != nullptr && spool_->enqueue(f.topic, f.data, f.len)) return true;
+    return hold(f); // no spool, or its queue is full: keep the buffer until the session is up
+}
+
+// Keeps the frame's buffer (no copy) until the session is up; a full backlog drops its oldest.
+bool MqttSink::hold(const Frame& f) {
+    if (!f.ref) return false;
+    if (backlog_len_ == kMqttBacklogFrames) {
+        backlog_[backlog_head_].ref.release();
+        backlog_head_ = (backlog_head_ + 1) % kMqttBacklogFrames;
+        --backlog_len_;
+        ++backlog_dropped_;
+    }
+    f.ref.retain();
+    backlog_[(backlog_head_ + backlog_len_) % kMqttBacklogFrames] = f;
+    ++backlog_len_;
+    return true;
+}
+
+// Publishes held frames in order; stops (false) only when the session is lost again. A frame the
+// live session rejects is dropped rather than retried forever.
+bool MqttSink::replay_backlog() {
+    while (backlog_len_ > 0) {
+        const Frame& f = backlog_[backlog_head_];
+        if (publish(f)) {
+            ++backlog_replayed_;
+        } else if (!mqtt_.is_connected()) {
+            return false;
+        } else {
+            ++backlog_dropped_;
+        }
+        f.ref.release();
+        backlog_head_ = (backlog_head_ + 1) % kMqttBacklogFrames;
+        --backlog_len_;
+    }
+    return true;
+}
+
+// Replay held and spooled payloads (oldest first; the spool at a bounded rate) while live data keeps flowing
+void MqttSink::idle() {
+    if (!mqtt_.is_connected()) return;
+    if (!replay_backlog()) return;
+    (void)mqtt_.service(); // write pending batches, collect acks, keep-alive
+    if (spool_ == nullptr) return;
+    auto now = TokenBucket::clock::now();
+    spool_->drain(drain_burst_, [&](const Spool::Record& r) {
+        if (!drain_.try_take(now)) return false;
+        return mqtt_.publish(std::string_view(r.topic, r.topic_len), r.payload, r.len, 0, false);
+    });
+}
+
+UdpMulticastSink::~UdpMulticastSink() { close(); }
+
+bool UdpMulticastSink::open(const std::string& addr, uint16_t port, int ttl, bool loopback, const char* iface) {
+    close();
+    sockaddr_in dst{};
+    dst.sin_family = AF_INET;
+    dst.sin_port = htons(port);
+    if (inet_pton(AF_INET, addr.c_str(), &dst.sin_addr) != 1) return false;
+    int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return false;
+    if (IN_MULTICAST(ntohl(dst.sin_addr.s_addr))) {
+        const unsigned char t = static_cast<unsigned char>(ttl);
+        const unsigned char loop = loopback ? 1 : 0;
+        bool ok = ::setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &t, sizeof(t)) == 0 &&
+                  ::setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) == 0;
+        if (ok && iface != nullptr) {
+            in_addr ifa{};
+            ok = inet_pton(AF_INET, iface, &ifa) == 1 &&
+                 ::setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &ifa, sizeof(ifa)) == 0;
+        }
+        if (!ok) {
+            ::close(fd);
+            return false;
+        }
+    }
+    fd_ = fd;
+    dst_ = dst;
+    queued_ = 0;
+    return true;
+}
+
+void UdpMulticastSink::close() {
+    if (fd_ >= 0) {
+        (void)flush();
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool UdpMulticastSink::write(const Frame& f) {
+    if (fd_ < 0 || f.len > kUdpMaxDatagram) return false;
+    iov_[queued_] = {const_cast<uint8_t*>(f.data), f.len};
+    f.ref.retain();
+    refs_[queued_] = f.ref;
+    if (++queued_ < batch_ && f.ref) return true;
+    return flush(); // a full batch, or borrowed bytes that are only valid during this call
+}
+
+// One sendmmsg() for everything queued; a short count means the socket buffer filled up, so the
+// rest is offered again until the kernel refuses with an error.
+bool UdpMulticastSink::flush() {
+    if (queued_ == 0) return true;
+    mmsghdr msgs[kUdpBatchDatagrams];
+    for (uint32_t i = 0; i < queued_; ++i) {
+        msgs[i] = {};
+        msgs[i].msg_hdr.msg_name = &dst_;
+        msgs[i].msg_hdr.msg_namelen = sizeof(dst_);
+        msgs[i].msg_hdr.msg_iov = &iov_[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    uint32_t sent = 0;
+    while (sent < queued_) {
+        int r = ::sendmmsg(fd_, msgs + sent, queued_ - sent, 0);
+        ++send_calls_;
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        sent += static_cast<uint32_t>(r);
+    }
+    datagrams_ += sent;
+    const bool ok = sent == queued_;
+    if (!ok) send_errors_ += queued_ - sent;
+    for (uint32_t i = 0; i < queued_; ++i) {
+        refs_[i].release();
+        refs_[i] = PayloadRef{};
+    }
+    queued_ = 0;
+    return ok;
+}
+
+} // namespace industrial
@@ -0,0 +1,107 @@
+/**
+ * @file Sparkplug.cpp
+ * @brief Sparkplug B payload encoding on top of ProtoWriter.
+ *
+ * Field numbers follow sparkplug_b.proto:
+ *   Payload { timestamp = 1 (uint64); metrics = 2 (repeated Metric); seq = 3 (uint64) }
+ *   Metric  { name = 1; alias = 2; timestamp = 3; datatype = 4 (uint32);
+ *             int_value = 10; long_value = 11; float_value = 12; double_value = 13;
+ *             boolean_value = 14; string_value = 15 }
+ */
+#include "industrial/Sparkplug.hpp"
+
+namespace industrial {
+
+namespace {
+
+enum : uint32_t {
+    kPayloadTimestamp = 1,
+    kPayloadMetrics = 2,
+    kPayloadSeq = 3,
+
+    kMetricName = 1,
+    kMetricAlias = 2,
+    kMetricTimestamp = 3,
+    kMetricDatatype = 4,
+    kMetricIntValue = 10,
+    kMetricLongValue = 11,
+    kMetricFloatValue = 12,
+    kMetricDoubleValue = 13,
+    kMetricBooleanValue = 14,
+    kMetricStringValue = 15,
+};
+
+size_t encode_birth(uint8_t* buf, size_t cap, uint64_t seq, uint64_t bd_seq, bool with_bd_seq,
+                    uint64_t timestamp_ms, const sparkplug::MetricDef* defs, const sparkplug::Value* values,
+                    size_t n) {
+    SparkplugEncoder enc(buf, cap);
+    enc.begin(timestamp_ms);
+    if (with_bd_seq) {
+        enc.birth_metric({"bdSeq", 0, sparkplug::DataType::UInt64}, timestamp_ms, sparkplug::Value::of_uint64(bd_seq));
+    }
+    for (size_t i = 0; i < n; ++i) enc.birth_metric(defs[i], timestamp_ms, values[i]);
+    return enc.finish(seq);
+}
+
+} // namespace
+
+void SparkplugEncoder::begin(uint64_t timestamp_ms) { w_.varint(kPayloadTimestamp, timestamp_ms); }
+
+void SparkplugEncoder::value(const sparkplug::Value& v) {
+    using sparkplug::DataType;
+    switch (v.type) {
+    case DataType::Int32: w_.varint(kMetricIntValue, static_cast<uint32_t>(static_cast<int32_t>(v.i))); break;
+    case DataType::UInt32: w_.varint(kMetricIntValue, static_cast<uint32_t>(v.u)); break;
+    case DataType::Int64: w_.varint(kMetricLongValue, static_cast<uint64_t>(v.i)); break;
+    case DataType::UInt64: w_.varint(kMetricLongValue, v.u); break;
+    case DataType::Float: w_.float32(kMetricFloatValue, v.f); break;
+    case DataType::Double: w_.double64(kMetricDoubleValue, v.d); break;
+    case DataType::Boolean: w_.boolean(kMetricBooleanValue, v.b); break;
+    case DataType::String: w_.string(kMetricStringValue, v.s); break;
+    }
+}
+
+void SparkplugEncoder::birth_metric(const sparkplug::MetricDef& def, uint64_t timestamp_ms,
+                                    const sparkplug::Value& v) {
+    const size_t m = w_.begin(kPayloadMetrics);
+    w_.string(kMetricName, def.name);
+    if (def.alias != 0) w_.varint(kMetricAlias, def.alias); // alias 0 = metric is addressed by name only
+    w_.varint(kMetricTimestamp, timestamp_ms);
+    w_.varint(kMetricDatatype, static_cast<uint32_t>(def.type));
+    value(v);
+    w_.end(m);
+}
+
+void SparkplugEncoder::metric(uint64_t alias, uint64_t timestamp_ms, const sparkplug::Value& v) {
+    const size_t m = w_.begin(kPayloadMetrics);
+    w_.varint(kMetricAlias, alias);
+    w_.varint(kMetricTimestamp, timestamp_ms);
+    value(v);
+    w_.end(m);
+}
+
+void SparkplugEncoder::metric_float(uint64_t alias, uint64_t timestamp_ms, float v) {
+    const size_t m = w_.begin(kPayloadMetrics);
+    w_.varint(kMetricAlias, alias);
+    w_.varint(kMetricTimestamp, timestamp_ms);
+    w_.float32(kMetricFloatValue, v);
+    w_.end(m);
+}
+
+size_t SparkplugEncoder::finish(uint64_t seq) {
+    w_.varint(kPayloadSeq, seq);
+    return w_.ok() ? w_.size() : 0;
+}
+
+size_t sparkplug_nbirth(uint8_t* buf, size_t cap, SparkplugSession& session, uint64_t timestamp_ms,
+                        const sparkplug::MetricDef* defs, const sparkplug::Value* values, size_t n) {
+    session.rebirth();
+    return encode_birth(buf, cap, session.next_seq(), session.bd_seq(), true, timestamp_ms, defs, values, n);
+}
+
+size_t sparkplug_dbirth(uint8_t* buf, size_t cap, SparkplugSession& session, uint64_t timestamp_ms,
+                        const sparkplug::MetricDef* defs, const sparkplug::Value* values, size_t n) {
+    return encode_birth(buf, cap, session.next_seq(), 0, false, timestamp_ms, defs, values, n);
+}
+
+} // namespace industrial
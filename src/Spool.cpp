@@ -0,0 +1,312 @@
+/**
+ * @file Spool.cpp
+ * @brief mmap-backed segment spool with crash-safe commit markers (see industrial/Spool.hpp).
+ *
+ * Segment states move Free -> Active (writer) -> Sealed (writer) -> Free (reader). The writer
+ * only ever touches Free or its own Active segment; the reader only frees Sealed segments it
+ * has fully drained, so the two sides coordinate purely through atomics in the mapping.
+ */
+#include "industrial/Spool.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace industrial {
+
+namespace {
+
+constexpr uint32_t kSegMagic = 0x314C5053u; // "SPL1"
+constexpr uint32_t kHeaderBytes = 64;
+
+enum SegState : uint32_t { kFree = 0, kActive = 1, kSealed = 2 };
+
+struct SegHeader {
+    uint32_t magic;
+    std::atomic<uint32_t> state;
+    uint64_t seq;                    // generation; written before state becomes Active
+    std::atomic<uint32_t> read_off;  // reader progress, persisted for restarts
+    std::atomic<uint32_t> write_off; // informational; recovery rescans commit markers instead
+};
+
+struct RecHeader {
+    std::atomic<uint32_t> commit;
+    uint32_t len;
+    uint16_t topic_len;
+    uint16_t reserved;
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "spool relies on address-free atomics in shared memory");
+static_assert(sizeof(SegHeader) <= kHeaderBytes, "segment header too large");
+static_assert(sizeof(RecHeader) == 12, "unexpected record header layout");
+
+uint32_t commit_tag(uint64_t seq) { return 0x80000000u | static_cast<uint32_t>(seq & 0x7FFFFFFFu); }
+
+uint32_t record_bytes(size_t topic_len, size_t len) {
+    return static_cast<uint32_t>((sizeof(RecHeader) + topic_len + len + 7u) & ~size_t(7));
+}
+
+SegHeader* header(uint8_t* base) { return reinterpret_cast<SegHeader*>(base); }
+RecHeader* record(uint8_t* base, uint32_t off) { return reinterpret_cast<RecHeader*>(base + off); }
+
+} // namespace
+
+Spool::~Spool() { close(); }
+
+bool Spool::open(const std::string& dir, uint32_t segment_bytes, uint32_t segment_count) {
+    if (is_open()) return false;
+    if (segment_count == 0 || segment_count > kMaxSegments) return false;
+    if (segment_bytes < kHeaderBytes + 1024u || (segment_bytes & 7u) != 0) return false;
+    if (::mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) return false;
+
+    seg_bytes_ = segment_bytes;
+    for (uint32_t i = 0; i < segment_count; ++i) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "/spool-%03u.seg", i);
+        if (!map_segment(i, dir + name)) {
+            close();
+            return false;
+        }
+        seg_count_ = i + 1;
+    }
+    recover();
+    return true;
+}
+
+bool Spool::map_segment(uint32_t idx, const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return false;
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || (st.st_size != 0 && st.st_size != (off_t)seg_bytes_)) {
+        ::close(fd); // refuse to reinterpret a segment written with a different geometry
+        return false;
+    }
+    if (st.st_size == 0 && ::posix_fallocate(fd, 0, seg_bytes_) != 0) {
+        ::close(fd);
+        return false;
+    }
+    void* p = ::mmap(nullptr, seg_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+    segs_[idx].fd = fd;
+    segs_[idx].base = static_cast<uint8_t*>(p);
+    SegHeader* h = header(segs_[idx].base);
+    if (h->magic != kSegMagic) {
+        h->seq = 0;
+        h->read_off.store(kHeaderBytes, std::memory_order_relaxed);
+        h->write_off.store(kHeaderBytes, std::memory_order_relaxed);
+        h->state.store(kFree, std::memory_order_relaxed);
+        h->magic = kSegMagic;
+    }
+    return true;
+}
+
+// Single-threaded, before start(): rebuild writer and reader positions from the mappings.
+void Spool::recover() {
+    max_seq_ = 0;
+    uint64_t active_seq = 0;
+    for (uint32_t i = 0; i < seg_count_; ++i) {
+        SegHeader* h = header(segs_[i].base);
+        if (h->seq > max_seq_) max_seq_ = h->seq;
+        if (h->state.load(std::memory_order_relaxed) == kFree) continue;
+
+        const uint32_t tag = commit_tag(h->seq);
+        uint32_t off = kHeaderBytes;
+        while (off + sizeof(RecHeader) <= seg_bytes_) {
+            RecHeader* r = record(segs_[i].base, off);
+            if (r->commit.load(std::memory_order_relaxed) != tag) break;
+            const uint32_t n = record_bytes(r->topic_len, r->len);
+            if (n > seg_bytes_ - off) break;
+            off += n;
+        }
+        h->write_off.store(off, std::memory_order_relaxed);
+        if (h->read_off.load(std::memory_order_relaxed) > off) h->read_off.store(off, std::memory_order_relaxed);
+
+        h->state.store(kSealed, std::memory_order_relaxed);
+        if (h->seq > active_seq) {
+            active_seq = h->seq;
+            cur_ = static_cast<int>(i);
+            wpos_ = off;
+        }
+    }
+    // Keep appending to the newest segment; everything older is sealed
+    if (cur_ >= 0) header(segs_[cur_].base)->state.store(kActive, std::memory_order_release);
+}
+
+void Spool::close() {
+    stop();
+    for (uint32_t i = 0; i < seg_count_; ++i) {
+        if (segs_[i].base) {
+            ::msync(segs_[i].base, seg_bytes_, MS_ASYNC);
+            ::munmap(segs_[i].base, seg_bytes_);
+        }
+        if (segs_[i].fd >= 0) ::close(segs_[i].fd);
+        segs_[i] = Segment{};
+    }
+    seg_count_ = 0;
+    cur_ = -1;
+    rseg_ = -1;
+    rlen_ = 0;
+}
+
+void Spool::start() {
+    if (!is_open() || running_.exchange(true)) return;
+    writer_ = std::thread([this] { writer_loop(); });
+}
+
+void Spool::stop() {
+    if (!running_.exchange(false)) return;
+    if (writer_.joinable()) writer_.join();
+}
+
+void Spool::writer_loop() {
+    Entry e;
+    auto last_sync = std::chrono::steady_clock::now();
+    for (;;) {
+        if (queue_.try_pop(e)) {
+            (void)append(e.topic, e.topic_len, e.payload, e.len);
+            continue;
+        }
+        if (!running_.load(std::memory_order_acquire)) break; // queue drained; exit
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_sync > std::chrono::seconds(1)) {
+            sync();
+            last_sync = now;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    sync();
+}
+
+bool Spool::enqueue(std::string_view topic, const void* payload, size_t len) {
+    if (topic.size() > kSpoolMaxTopic || len > kSpoolMaxPayload) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    Entry e;
+    e.topic_len = static_cast<uint16_t>(topic.size());
+    e.len = static_cast<uint16_t>(len);
+    std::memcpy(e.topic, topic.data(), topic.size());
+    std::memcpy(e.payload, payload, len);
+    if (!queue_.try_push(e)) { // writer thread behind: refuse rather than overwrite an unwritten entry
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+int Spool::acquire_free_segment() {
+    for (uint32_t i = 0; i < seg_count_; ++i) {
+        SegHeader* h = header(segs_[i].base);
+        if (h->state.load(std::memory_order_acquire) != kFree) continue;
+        h->seq = ++max_seq_;
+        h->read_off.store(kHeaderBytes, std::memory_order_relaxed);
+        h->write_off.store(kHeaderBytes, std::memory_order_relaxed);
+        h->state.store(kActive, std::memory_order_release);
+        return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void Spool::seal_current() {
+    if (cur_ < 0) return;
+    header(segs_[cur_].base)->state.store(kSealed, std::memory_order_release);
+    cur_ = -1;
+}
+
+bool Spool::append(const char* topic, size_t topic_len, const void* payload, size_t len) {
+    const uint32_t need = record_bytes(topic_len, len);
+    if (!is_open() || topic_len > UINT16_MAX || need > seg_bytes_ - kHeaderBytes) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (cur_ >= 0 && wpos_ + need > seg_bytes_) seal_current();
+    if (cur_ < 0) {
+        cur_ = acquire_free_segment();
+        wpos_ = kHeaderBytes;
+        if (cur_ < 0) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+    uint8_t* base = segs_[cur_].base;
+    RecHeader* r = record(base, wpos_);
+    r->len = static_cast<uint32_t>(len);
+    r->topic_len = static_cast<uint16_t>(topic_len);
+    r->reserved = 0;
+    std::memcpy(base + wpos_ + sizeof(RecHeader), topic, topic_len);
+    std::memcpy(base + wpos_ + sizeof(RecHeader) + topic_len, payload, len);
+    r->commit.store(commit_tag(header(base)->seq), std::memory_order_release); // commit marker last
+    wpos_ += need;
+    header(base)->write_off.store(wpos_, std::memory_order_relaxed);
+    appended_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void Spool::sync() {
+    const int cur = cur_;
+    if (cur >= 0) ::msync(segs_[cur].base, seg_bytes_, MS_ASYNC);
+}
+
+// Oldest non-free segment (smallest generation) becomes the read segment.
+bool Spool::select_read_segment() {
+    int best = -1;
+    uint64_t best_seq = 0;
+    for (uint32_t i = 0; i < seg_count_; ++i) {
+        SegHeader* h = header(segs_[i].base);
+        if (h->state.load(std::memory_order_acquire) == kFree) continue;
+        if (best < 0 || h->seq < best_seq) {
+            best = static_cast<int>(i);
+            best_seq = h->seq;
+        }
+    }
+    if (best < 0) return false;
+    rseg_ = best;
+    rpos_ = header(segs_[best].base)->read_off.load(std::memory_order_relaxed);
+    return true;
+}
+
+bool Spool::peek(Record& out) {
+    if (!is_open()) return false;
+    for (;;) {
+        if (rseg_ < 0 && !select_read_segment()) return false;
+        uint8_t* base = segs_[rseg_].base;
+        SegHeader* h = header(base);
+        const uint32_t tag = commit_tag(h->seq);
+        const bool sealed = h->state.load(std::memory_order_acquire) == kSealed;
+        if (rpos_ + sizeof(RecHeader) <= seg_bytes_) {
+            RecHeader* r = record(base, rpos_);
+            if (r->commit.load(std::memory_order_acquire) == tag) {
+                out.topic = reinterpret_cast<const char*>(base + rpos_ + sizeof(RecHeader));
+                out.topic_len = r->topic_len;
+                out.payload = base + rpos_ + sizeof(RecHeader) + r->topic_len;
+                out.len = r->len;
+                rlen_ = record_bytes(r->topic_len, r->len);
+                return true;
+            }
+        }
+        if (!sealed) return false; // caught up with the writer
+        // Sealed and fully read: hand the segment back to the writer
+        h->read_off.store(kHeaderBytes, std::memory_order_relaxed);
+        h->state.store(kFree, std::memory_order_release);
+        rseg_ = -1;
+    }
+}
+
+void Spool::consume() {
+    if (rseg_ < 0 || rlen_ == 0) return;
+    rpos_ += rlen_;
+    rlen_ = 0;
+    header(segs_[rseg_].base)->read_off.store(rpos_, std::memory_order_relaxed);
+    drained_.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace industrial
@@ -0,0 +1,79 @@
+/**
+ * @file Uadp.cpp
+ * @brief UADP NetworkMessage encoding (layout documented in industrial/Uadp.hpp).
+ */
+#include "industrial/Uadp.hpp"
+
+#include <cstring>
+
+namespace industrial {
+
+namespace {
+
+enum : uint8_t {
+    kUadpVersion = 0x01,
+    kFlagPublisherId = 0x10,
+    kFlagGroupHeader = 0x20,
+    kFlagPayloadHeader = 0x40,
+    kFlagExtendedFlags1 = 0x80,
+
+    kExt1PublisherIdUInt16 = 0x01,
+
+    kGroupWriterGroupId = 0x01,
+    kGroupSequenceNumber = 0x08,
+
+    kDsValid = 0x01,
+    kDsSequenceNumber = 0x08,
+    kDsFlags2 = 0x80,
+    kDs2KeyFrame = 0x00,
+    kDs2Timestamp = 0x10,
+
+    kVariantFloat = 10,
+};
+
+inline uint8_t* put_u16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+    return p + 2;
+}
+
+inline uint8_t* put_u32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+    return p + 4;
+}
+
+inline uint8_t* put_u64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+    return p + 8;
+}
+
+} // namespace
+
+size_t UadpEncoder::encode(uint8_t* buf, size_t cap, const float* fields, uint16_t n, int64_t timestamp) {
+    const size_t size = message_size(n);
+    if (size > cap) return 0;
+    uint8_t* p = buf;
+    *p++ = kUadpVersion | kFlagPublisherId | kFlagGroupHeader | kFlagPayloadHeader | kFlagExtendedFlags1;
+    *p++ = kExt1PublisherIdUInt16;
+    p = put_u16(p, cfg_.publisher_id);
+    *p++ = kGroupWriterGroupId | kGroupSequenceNumber;
+    p = put_u16(p, cfg_.writer_group_id);
+    p = put_u16(p, net_seq_++);
+    *p++ = 1; // DataSetMessage count
+    p = put_u16(p, cfg_.dataset_writer_id);
+
+    *p++ = kDsValid | kDsSequenceNumber | kDsFlags2; // Variant field encoding (bits 1-2 = 0)
+    *p++ = kDs2KeyFrame | kDs2Timestamp;
+    p = put_u16(p, ds_seq_++);
+    p = put_u64(p, static_cast<uint64_t>(timestamp));
+    p = put_u16(p, n);
+    for (uint16_t i = 0; i < n; ++i) {
+        uint32_t bits;
+        std::memcpy(&bits, &fields[i], sizeof(bits));
+        *p++ = kVariantFloat;
+        p = put_u32(p, bits);
+    }
+    return static_cast<size_t>(p - buf);
+}
+
+} // namespace industrial
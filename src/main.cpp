@@ -2,48 +2,52 @@
  * @file main.cpp
  * @brief Host-side demo entry point for the Industrial Sensor Simulator
  *
- * This file wires together a simulated sensor, a single-producer/single-consumer (SPSC) ring buffer,
- * a runtime-configurable moving average filter, and an optional MQTT publisher to form a simple
- * end-to-end data path suitable for host testing and demonstration.
+ * This file wires together a simulated sensor, a runtime-configurable moving average filter and the
+ * output sinks as stages of a Pipeline (SPSC links between them) to form an end-to-end data path
+ * suitable for host testing and demonstration. README.md documents every option in detail.
  *
  * Data flow:
- *   SimSensor -> producer_task(SensorSample) -> SpscRing -> consumer_task -> M.A Filter
- *   -> console logging and optional MQTT CSV publishing
+ *   SimSensor -> "sensor" stage -> Link<SensorSample> -> "average" stage (M.A Filter, AsyncLog)
+ *   -> Link<Reading> -> "publish" stage -> encode once into a PayloadPool buffer -> SinkFanOut
+ *   -> one thread per enabled sink (MQTT, file, stdout, null, local subscribers)
+ *   Optional side outputs: UADP over UDP, InfluxDB line protocol, Modbus TCP snapshot server.
  *
- * Responsibilities:
- * - Initializes a no-heap SPSC ring buffer (capacity 256) for SensorSample transport.
- * - Spawns two std::thread tasks:
- *   - Producer: samples SimSensor at a fixed period and pushes into the ring (overwrites oldest on full).
- *   - Consumer: drains the ring with a deadline, computes moving averages (temperature/pressure),
- *     logs results, and optionally publishes compact CSV payloads over MQTT.
- * - Configures MQTT from environment variables or compile-time macros:
- *   - MQTT_BROKER_URL (default: tcp://127.0.0.1:1883)
- *   - MQTT_TOPIC       (default: sensors/demo/readings)
- *   Uses client-id "sensor-sim" and keep-alive 60 s. If connection fails, runs without publishing.
- * - Parses optional CLI arguments:
- *   - window: moving average window size (default 8, clamped to [1, 256])
- *   - count: total samples to produce/consume (default 50)
+ * Configuration (environment; CLI arguments: [window (default 8, 1..256)] [count (default 50)]):
+ * - Pipeline: PIPELINE_THREADS, CONSUMER_WAIT (see WaitStrategy.hpp), LOG_LEVEL.
+ * - Sampling: RT_MODE, RT_CPUS, RT_PRIORITY (see Realtime.hpp); SENSOR_MISS_POLICY and
+ *   TIMING_EXPORT (see PeriodicSchedule.hpp).
+ * - MQTT: MQTT_BROKER_URL, MQTT_TOPIC, MQTT_PAYLOAD (csv, gorilla, sparkplug), MQTT_MODE,
+ *   MQTT_STATS_MS, per-lane QoS/retain; SPOOL_DIR and SPOOL_DRAIN_RATE for store-and-forward.
+ * - Data reduction and events: CONFLATE, DEADBAND_*, HEARTBEAT_MS, ALARM_*.
+ * - Sinks: SINKS, SINK_FILE, LOCAL_SUB_SOCKET, UADP_ADDR, INFLUX_URL, MODBUS_PORT.
  *
  * Output and payloads:
- * - Console: per-sample raw and averaged values plus a final consumed count
- * - MQTT: CSV "tempC,avgTempC,pressKPa,avgPressKPa" with three decimal places (QoS 0, retain=false)
+ * - Console: per-sample raw and averaged values (LOG_LEVEL=debug), per-stage, per-sink, MQTT,
+ *   timing and latency statistics at exit
+ * - MQTT: CSV "tempC,avgTempC,pressKPa,avgPressKPa", Gorilla blocks or Sparkplug B DDATA batches;
+ *   alarm events on "<topic>/alarm" through the priority lane
  *
  * Timing and threading notes:
  * - Uses std::chrono steady_clock and sleep_until/for for host convenience.
- * - SpscRing is single-producer/single-consumer safe; producer overwrites oldest item on full.
- * - Consumer uses a polling loop with a short sleep and a fixed 5 s timeout; may terminate early
- *   if the producer runs too slowly.
+ * - The sensor link drops the oldest sample when full (counted); the readings link blocks averaging
+ *   until publishing catches up.
+ * - The MQTT session connects and reconnects in the background; the sink holds frames meanwhile.
+ * - The run stops 5 s after the sensor should have finished; whatever was sampled by then is still
+ *   published.
  *
  * Limitations:
- * - Overwrite-on-full behavior may lose oldest unprocessed samples under backpressure.
- * - Polling-based consumer is not real-time deterministic.
+ * - Without RT_MODE, host threads under the default scheduler are not real-time deterministic.
  * - Moving average window is capped at 256 samples.
- * - MQTT errors are not retried.
+ * - While the MQTT session is down, frames go to the SPOOL_DIR spool if there is one and room in
+ *   its queue, otherwise they are held in memory (their pool buffers, no copy) and replayed in
+ *   order after the reconnect. That backlog is bounded by kMqttBacklogFrames and drops its oldest
+ *   frame when full (counted at exit); a frame a live session rejects is dropped, not retried.
  *
  * Embedded considerations (what would be done differently on an MCU platform):
  * - Replace std::thread and sleeps with RTOS tasks and delay-until/timers or ISR-driven producers.
  * - Replace std::chrono with hardware timers or RTOS tick counters.
- * - Replace std::cout/stdio with lightweight logging or disable logs entirely.
+ * - Point AsyncLog's writer at a UART/DMA or log ring instead of stdio, or raise LOG_LEVEL in
+ *   firmware.
  * - Prefer event/notification-driven consumption over polling.
  */
 
@@ -52,102 +56,503 @@
 #include <cstdio>   // std::snprintf for tiny payload formatting
 #include <cstring>  // std::strlen
 #include <chrono>   // std::chrono clocks/durations: prefer HW timers or tick counters
+#include <atomic>   // std::atomic flag for the stats reporter thread
 #include <thread>   // std::thread/sleep: use RTOS delay or WFI/idle hooks instead
 
 #include "industrial/Config.hpp"
 #include "industrial/Status.hpp"
 #include "industrial/SensorSample.hpp"
 #include "industrial/SimSensor.hpp"
-#include "industrial/SpscRing.hpp"
 #include "industrial/MovingAverageFloat.hpp"
 #include "industrial/MqttPublisher.hpp"
+#include "industrial/GorillaCodec.hpp"
+#include "industrial/Spool.hpp"
+#include "industrial/PayloadPool.hpp"
+#include "industrial/Sinks.hpp"
+#include "industrial/SinkFanOut.hpp"
+#include "industrial/Deadband.hpp"
+#include "industrial/Sparkplug.hpp"
+#include "industrial/Uadp.hpp"
+#include "industrial/LocalSubServer.hpp"
+#include "industrial/InfluxSink.hpp"
+#include "industrial/LineProtocol.hpp"
+#include "industrial/ModbusServer.hpp"
+#include "industrial/ThresholdAlarm.hpp"
+#include "industrial/WaitStrategy.hpp"
+#include "industrial/LatencyHistogram.hpp"
+#include "industrial/AsyncLog.hpp"
+#include "industrial/Pipeline.hpp"
+#include "industrial/Realtime.hpp"
+#include "industrial/PeriodicSchedule.hpp"
+#include "industrial/TopicArena.hpp"
 
-/**
- * @brief Minimal producer: read N samples from SimSensor at a fixed period and try_push to the SPSC ring.
- */
-using RingBuf = industrial::SpscRing<industrial::SensorSample, industrial::kRingCapacity>;
-using MovingAvg = industrial::MovingAverageFloat<industrial::kMaxAvgWindow>;
+// Consumer console lines; the async logger queues the format id and raw values, its writer thread formats
+static const industrial::LogFormat kLogSample{industrial::LogLevel::Debug, "consumer: T=%g C (avg=%g), P=%g (avg=%g)"};
+static const industrial::LogFormat kLogConsumed{industrial::LogLevel::Info, "consumer: total consumed=%zu"};
+static const industrial::LogFormat kLogPickup{industrial::LogLevel::Info,
+                                              "consumer: wait=%s pickup latency p50=%llu us p99=%llu us max=%llu us "
+                                              "cpu=%lld ms"};
+static const industrial::LogFormat kLogPickupWakes{industrial::LogLevel::Info,
+                                                   "consumer: wait=%s pickup latency p50=%llu us p99=%llu us "
+                                                   "max=%llu us cpu=%lld ms wake-ups=%llu"};
+static const industrial::LogFormat kLogJitter{industrial::LogLevel::Info,
+                                              "sensor: period jitter p50=%llu us p99=%llu us max=%llu us (rt=%s)"};
+static const industrial::LogFormat kLogLateness{industrial::LogLevel::Info,
+                                                "sensor: wake-up lateness p50=%llu us p99=%llu us max=%llu us, "
+                                                "read+push p99=%llu us max=%llu us"};
+static const industrial::LogFormat kLogMisses{industrial::LogLevel::Info,
+                                              "sensor: %llu samples, overruns=%llu deadline misses=%llu "
+                                              "skipped=%llu (policy=%s)"};
+static const industrial::LogFormat kLogRt{industrial::LogLevel::Info,
+                                          "rt: thread %u cpu %d: %s, SCHED_FIFO %d: %s, stack prefaulted: %s"};
+static const industrial::LogFormat kLogStage{industrial::LogLevel::Info,
+                                             "stage %s [thread %u]: in=%llu out=%llu (%.1f/s) dropped=%llu "
+                                             "blocked=%llu queue max=%u"};
 
-static void producer_task(RingBuf &q,
-                          industrial::SimSensor &sensor,
-                          std::size_t count,
-                          std::chrono::milliseconds period)
+// One line of publish-path statistics; only reads the publisher's lock-free counters.
+static void print_publish_stats(const industrial::MqttPublisher &mqtt)
 {
-    using clock = std::chrono::steady_clock;
-    auto next = clock::now(); // timestamp via std::chrono; on MCU prefer a monotonic HW timer
-    for (std::size_t i = 0; i < count; ++i)
+    using R = industrial::MqttClient::Result;
+    const industrial::LatencyHistogram &lat = mqtt.publish_latency();
+    std::cout << "mqtt: published=" << mqtt.published() << " bytes=" << mqtt.bytes_published()
+              << " failed=" << mqtt.publish_failures() << " latency p50=" << lat.percentile(50) / 1000
+              << " us p99=" << lat.percentile(99) / 1000 << " us max=" << lat.max() / 1000 << " us";
+    for (uint8_t r = static_cast<uint8_t>(R::NotConnected); r <= static_cast<uint8_t>(R::ProtocolError); ++r)
     {
-        industrial::SensorSample sample{};
-        sensor.read(sample);
-        q.push(sample); // overwrites oldest on full
-        next += period;
-        std::this_thread::sleep_until(next); // replace with RTOS delay-until or timer-driven ISR
+        const uint64_t n = mqtt.publish_failures(static_cast<R>(r));
+        if (n > 0)
+            std::cout << ' ' << industrial::MqttClient::result_name(static_cast<R>(r)) << '=' << n;
     }
+    std::cout << '\n';
+}
+
+// One real-time step for the exit report: "off" if not requested, "ok", or why it failed
+static const char *rt_outcome(bool requested, bool ok, int err)
+{
+    if (!requested)
+        return "off";
+    return ok ? "ok" : std::strerror(err);
+}
+
+// True if name appears as an item of a comma-separated list.
+static bool has_item(const std::string &list, const char *name)
+{
+    std::size_t pos = 0;
+    while (pos <= list.size())
+    {
+        std::size_t end = list.find(',', pos);
+        if (end == std::string::npos)
+            end = list.size();
+        if (list.compare(pos, end - pos, name) == 0)
+            return true;
+        pos = end + 1;
+    }
+    return false;
+}
+
+using MovingAvg = industrial::MovingAverageFloat<industrial::kMaxAvgWindow>;
+using PayloadBufs = industrial::PayloadPool<industrial::kPayloadPoolSlots, industrial::kPayloadSlotBytes>;
+using Outputs = industrial::SinkFanOut<PayloadBufs, industrial::MqttSink, industrial::FileSink,
+                                       industrial::StdoutSink, industrial::NullSink, industrial::LocalSubServer>;
+enum : std::size_t { kSinkMqtt = 0, kSinkFile, kSinkStdout, kSinkNull, kSinkLocal };
+using UadpOutputs = industrial::SinkFanOut<PayloadBufs, industrial::UdpMulticastSink>;
+using InfluxOutputs = industrial::SinkFanOut<PayloadBufs, industrial::InfluxSink>;
+
+// InfluxDB output (INFLUX_URL): escaped "measurement,tags" prefix and the sink's fan-out
+struct InfluxOut
+{
+    std::string prefix;
+    InfluxOutputs *out = nullptr;
+};
+using Deadband = industrial::DeadbandFilter<2>; // channels: smoothed temperature, smoothed pressure
+using Alarms = industrial::ThresholdAlarm<2>;    // channels: smoothed temperature, smoothed pressure
+
+static_assert(industrial::kPayloadSlotBytes >= industrial::max_block_bytes(industrial::kGorillaBlockSamples),
+              "payload buffers must hold a full Gorilla block");
+static_assert(industrial::kPayloadSlotBytes >= industrial::kSparkplugEnvelopeMax +
+                                                   4 * industrial::kSparkplugBatchSamples * industrial::kSparkplugFloatMetricMax,
+              "payload buffers must hold a full Sparkplug DDATA batch");
+
+enum class PayloadFormat { Csv, Gorilla, Sparkplug };
+
+// Sparkplug B output (MQTT_PAYLOAD=sparkplug): topics, the birth/sequence session and the publisher
+// whose reconnect count triggers a rebirth
+struct SparkplugOut
+{
+    std::string_view nbirth_topic;
+    std::string_view dbirth_topic;
+    std::string_view ddata_topic;
+    industrial::SparkplugSession session;
+    const industrial::MqttPublisher *mqtt = nullptr;
+    uint64_t born_at_reconnects = ~0ull; // reconnect count of the last birth; ~0: not born yet
+};
+
+// Device metrics, in CSV column order; data messages refer to them by alias
+static const industrial::sparkplug::MetricDef kSparkplugDeviceMetrics[] = {
+    {"temperature", 1, industrial::sparkplug::DataType::Float},
+    {"temperature_avg", 2, industrial::sparkplug::DataType::Float},
+    {"pressure", 3, industrial::sparkplug::DataType::Float},
+    {"pressure_avg", 4, industrial::sparkplug::DataType::Float},
+};
+static const industrial::sparkplug::MetricDef kSparkplugNodeMetrics[] = {
+    {"Node Control/Rebirth", 100, industrial::sparkplug::DataType::Boolean},
+};
+
+// Samples carry steady_clock time points; wire formats want wall-clock time
+static std::chrono::system_clock::time_point to_system(industrial::TimePoint ts)
+{
+    using namespace std::chrono;
+    static const steady_clock::time_point steady0 = steady_clock::now();
+    static const system_clock::time_point system0 = system_clock::now();
+    return system0 + duration_cast<system_clock::duration>(ts - steady0);
+}
+
+// Sparkplug timestamps are ms since the Unix epoch
+static uint64_t epoch_ms(industrial::TimePoint ts)
+{
+    using namespace std::chrono;
+    return (uint64_t)duration_cast<milliseconds>(to_system(ts).time_since_epoch()).count();
 }
 
 /**
- * @brief Minimal consumer: try_pop samples from the ring, compute moving average on them and publish to MQTT broker (if used)
+ * @brief Sensor stage (pipeline source): reads SimSensor every period, count times. Between samples its
+ * thread waits for the next sampling instant; on MCU this is an RTOS delay-until or a timer-driven ISR.
+ * The schedule records wake-up lateness, period jitter, read + push time, overruns and deadline misses,
+ * and applies the miss policy (catch up or skip). An iteration ends when the stage is called again,
+ * which its thread does right after pushing the sample.
  */
-static void consumer_task_runtime(RingBuf &q,
-                                  std::size_t stop_after,
-                                  std::chrono::milliseconds timeout,
-                                  uint32_t window,
-                                  industrial::MqttPublisher *mqtt,
-                                  const std::string &mqtt_topic)
+struct SensorStage
+{
+    industrial::SimSensor &sensor;
+    std::size_t count;
+    industrial::PeriodicSchedule &schedule;
+    std::size_t produced = 0;
+    bool running = false; // an iteration began and has not ended yet
+
+    // steady_clock timestamps; on MCU prefer a monotonic HW timer
+    static int64_t now_ns()
+    {
+        using namespace std::chrono;
+        return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    industrial::Step produce(industrial::SensorSample &out, int64_t &wait_ns)
+    {
+        const int64_t now = now_ns();
+        if (running)
+        {
+            schedule.end(now);
+            running = false;
+        }
+        if (produced == count)
+            return industrial::Step::Done;
+        if (!schedule.started())
+            schedule.start(now); // first sample at once
+        const int64_t left = schedule.until_due(now);
+        if (left > 0)
+        {
+            if (left < wait_ns)
+                wait_ns = left;
+            return industrial::Step::Idle;
+        }
+        schedule.begin(now);
+        running = true;
+        sensor.read(out);
+        ++produced;
+        return industrial::Step::Busy;
+    }
+};
+
+// A sample with its moving averages, from the average stage to the publish stage
+struct Reading
+{
+    industrial::SensorSample s;
+    float t_smooth;
+    float p_smooth;
+};
+
+/**
+ * @brief Average stage (pipeline transform): moving averages of temperature and pressure, pickup latency
+ * (sample timestamp to here) and the per-sample console line.
+ */
+struct AverageStage
 {
-    using clock = std::chrono::steady_clock;
-    std::size_t consumed = 0;
-    auto deadline = clock::now() + timeout;
-    industrial::SensorSample s{};
     MovingAvg t_avg;
     MovingAvg p_avg;
-    t_avg.set_window(window);
-    p_avg.set_window(window);
-    while (consumed < stop_after && clock::now() < deadline) // polling now(); for embedded, prefer event/ISR or RTOS wait
-    { 
-        if (q.try_pop(s))
-        {
-            ++consumed;
-            float t_smooth = t_avg.push(s.temperature_c);
-            float p_smooth = p_avg.push(s.pressure_kpa);
-            std::cout << "consumer: T=" << s.temperature_c
-                      << " C (avg=" << t_smooth
-                      << "), P=" << s.pressure_kpa
-                      << " (avg=" << p_smooth << ")\n"; // std::cout is heavy; for embedded, use lightweight logging
-
-            // publish CSV to MQTT when available
-            if (mqtt && mqtt->is_connected())
+    industrial::LatencyHistogram &pickup;
+    industrial::AsyncLog &log;
+
+    AverageStage(uint32_t window, industrial::LatencyHistogram &pickup_hist, industrial::AsyncLog &console)
+        : pickup(pickup_hist), log(console)
+    {
+        t_avg.set_window(window);
+        p_avg.set_window(window);
+    }
+
+    bool process(const industrial::SensorSample &s, Reading &r)
+    {
+        pickup.record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s.ts)
+                          .count());
+        r.s = s;
+        r.t_smooth = t_avg.push(s.temperature_c);
+        r.p_smooth = p_avg.push(s.pressure_kpa);
+        // Copies four floats into the log ring; formatting and the write happen on the logger's thread
+        log.log(kLogSample, s.temperature_c, r.t_smooth, s.pressure_kpa, r.p_smooth);
+        return true;
+    }
+};
+
+/**
+ * @brief Publish stage (pipeline sink): alarms, Modbus snapshot, UADP and InfluxDB lines, then the MQTT
+ * payload format. Each payload is encoded once into a pooled buffer and its handle handed to the output
+ * fan-out (MQTT, file, stdout, null, local sinks).
+ */
+class PublishStage
+{
+public:
+    PublishStage(PayloadBufs &pool, Outputs &out, std::string_view topic, std::string_view block_topic,
+                 PayloadFormat format, Deadband *deadband, bool conflate, Alarms *alarms,
+                 std::string_view alarm_topic, SparkplugOut &spb, UadpOutputs *uadp_out,
+                 industrial::UadpEncoder &uadp, const InfluxOut &influx, industrial::ModbusServer *modbus)
+        : pool_(pool), out_(out), topic_(topic), block_topic_(block_topic), format_(format), deadband_(deadband),
+          conflate_(conflate), alarms_(alarms), alarm_topic_(alarm_topic), spb_(spb), uadp_out_(uadp_out),
+          uadp_(uadp), influx_(influx), modbus_(modbus)
+    {
+    }
+
+    void consume(const Reading &r)
+    {
+        const industrial::SensorSample &s = r.s;
+        if (modbus_ != nullptr)
+        {
+            const float latest[4] = {s.temperature_c, r.t_smooth, s.pressure_kpa, r.p_smooth};
+            modbus_->update(latest, 4); // never waits on pollers (SeqLock)
+        }
+        // Threshold alarms: transitions only, through the priority lane (never deadbanded or conflated)
+        if (alarms_ != nullptr)
+        {
+            const float smoothed[2] = {r.t_smooth, r.p_smooth};
+            Alarms::Event ev[4];
+            const uint32_t n_ev = alarms_->update(smoothed, ev);
+            for (uint32_t k = 0; k < n_ev; ++k)
+            {
+                PayloadBufs::Handle a = pool_.acquire();
+                if (a == PayloadBufs::kInvalid)
+                    break;
+                int n = std::snprintf((char *)pool_.data(a), PayloadBufs::buffer_size(), "%s,%s,%d,%.3f",
+                                      ev[k].channel == 0 ? "temperature" : "pressure",
+                                      ev[k].kind == Alarms::Kind::High ? "high" : "low", ev[k].active ? 1 : 0,
+                                      ev[k].value);
+                pool_.set_len(a, n > 0 ? (uint32_t)n : 0u);
+                out_.submit(a, alarm_topic_, false, Outputs::Lane::Priority);
+            }
+        }
+
+        // OPC UA PubSub: one cyclic UADP NetworkMessage per sample, independent of the MQTT format
+        if (uadp_out_ != nullptr)
+        {
+            PayloadBufs::Handle u = pool_.acquire();
+            if (u != PayloadBufs::kInvalid)
+            {
+                const float fields[4] = {s.temperature_c, r.t_smooth, s.pressure_kpa, r.p_smooth};
+                size_t n = uadp_.encode(pool_.data(u), PayloadBufs::buffer_size(), fields, 4,
+                                        industrial::UadpEncoder::to_datetime(to_system(s.ts)));
+                pool_.set_len(u, (uint32_t)n);
+                uadp_out_->submit(u, {}, true);
+            }
+        }
+
+        // InfluxDB: one line per sample; the sink batches them into large writes
+        if (influx_.out != nullptr)
+        {
+            PayloadBufs::Handle l = pool_.acquire();
+            if (l != PayloadBufs::kInvalid)
             {
-                char buf[160];
-                // CSV: temp,avgTemp,press,avgPress
-                int n = std::snprintf(buf, sizeof(buf), "%.3f,%.3f,%.3f,%.3f", s.temperature_c, t_smooth, s.pressure_kpa, p_smooth);
+                const industrial::InfluxField fields[4] = {{"temperature", s.temperature_c},
+                                                           {"temperature_avg", r.t_smooth},
+                                                           {"pressure", s.pressure_kpa},
+                                                           {"pressure_avg", r.p_smooth}};
+                const int64_t ts_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          to_system(s.ts).time_since_epoch()).count();
+                size_t n = industrial::influx_line((char *)pool_.data(l), PayloadBufs::buffer_size(),
+                                                   influx_.prefix, fields, 4, ts_ns);
                 if (n > 0)
                 {
-                    (void)mqtt->publish(mqtt_topic, buf, (size_t)std::strlen(buf), 0, false);
+                    pool_.set_len(l, (uint32_t)n);
+                    influx_.out->submit(l, {}, false);
+                }
+                else
+                {
+                    pool_.release(l);
                 }
             }
         }
+
+        if (format_ == PayloadFormat::Gorilla)
+        {
+            if (block_ == PayloadBufs::kInvalid && (block_ = pool_.acquire()) != PayloadBufs::kInvalid)
+                enc_ = industrial::GorillaEncoder(pool_.data(block_), PayloadBufs::buffer_size());
+            if (block_ != PayloadBufs::kInvalid)
+            {
+                (void)enc_.append(s);
+                if (enc_.count() == industrial::kGorillaBlockSamples)
+                    flush_block();
+            }
+            return;
+        }
+        // Report by exception: skip the message while the smoothed values stay inside their deadbands
+        const float channels[2] = {r.t_smooth, r.p_smooth};
+        if (deadband_ != nullptr && !deadband_->update(channels, s.ts))
+            return;
+        if (format_ == PayloadFormat::Sparkplug)
+        {
+            const float values[4] = {s.temperature_c, r.t_smooth, s.pressure_kpa, r.p_smooth};
+            sparkplug_births(s, values);
+            if (spb_.born_at_reconnects == ~0ull)
+                return; // no birth yet: data would be meaningless to the host
+            if (spb_batch_ == PayloadBufs::kInvalid && (spb_batch_ = pool_.acquire()) != PayloadBufs::kInvalid)
+            {
+                spb_enc_ = industrial::SparkplugEncoder(pool_.data(spb_batch_), PayloadBufs::buffer_size());
+                spb_enc_.begin(epoch_ms(s.ts));
+            }
+            if (spb_batch_ == PayloadBufs::kInvalid)
+                return;
+            const uint64_t ts = epoch_ms(s.ts);
+            for (uint32_t m = 0; m < 4; ++m)
+                spb_enc_.metric_float(kSparkplugDeviceMetrics[m].alias, ts, values[m]);
+            if (++spb_samples_ == industrial::kSparkplugBatchSamples)
+                flush_sparkplug();
+            return;
+        }
+        // CSV: temp,avgTemp,press,avgPress
+        PayloadBufs::Handle h = pool_.acquire(); // exhausted pool (all sinks backed up) drops the sample
+        if (h != PayloadBufs::kInvalid)
+        {
+            int n = std::snprintf((char *)pool_.data(h), PayloadBufs::buffer_size(), "%.3f,%.3f,%.3f,%.3f",
+                                  s.temperature_c, r.t_smooth, s.pressure_kpa, r.p_smooth);
+            if (n > 0)
+            {
+                pool_.set_len(h, (uint32_t)n);
+                out_.submit(h, topic_, false, conflate_ ? Outputs::Lane::Latest : Outputs::Lane::Bulk);
+            }
+            else
+            {
+                pool_.release(h);
+            }
+        }
+    }
+
+    // After the last reading: partial Gorilla blocks and Sparkplug batches go out
+    void finish()
+    {
+        flush_block();
+        flush_sparkplug();
+    }
+
+private:
+    // Compressed batches: raw samples are encoded straight into a pooled buffer and the finished Gorilla
+    // block goes out as one message
+    void flush_block()
+    {
+        if (block_ == PayloadBufs::kInvalid)
+            return;
+        size_t n = enc_.count() > 0 ? enc_.finish() : 0;
+        if (n > 0)
+        {
+            pool_.set_len(block_, (uint32_t)n);
+            out_.submit(block_, block_topic_, true);
+        }
         else
         {
-            // idle poll at ~200Hz; using sleep_for in lieu of a platform-specific wait instruction
-            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            pool_.release(block_);
         }
+        block_ = PayloadBufs::kInvalid;
+    }
+
+    // Sparkplug B: DDATA batches of kSparkplugBatchSamples samples, 4 aliased metrics each, encoded in place
+    // like Gorilla blocks. Births go out first and again after every reconnect.
+    void flush_sparkplug()
+    {
+        if (spb_batch_ == PayloadBufs::kInvalid)
+            return;
+        size_t n = spb_samples_ > 0 ? spb_enc_.finish(spb_.session.next_seq()) : 0;
+        if (n > 0)
+        {
+            pool_.set_len(spb_batch_, (uint32_t)n);
+            out_.submit(spb_batch_, spb_.ddata_topic, true);
+        }
+        else
+        {
+            pool_.release(spb_batch_);
+        }
+        spb_batch_ = PayloadBufs::kInvalid;
+        spb_samples_ = 0;
     }
-    std::cout << "consumer: total consumed=" << consumed << '\n';
-}
+
+    void sparkplug_births(const industrial::SensorSample &smp, const float (&values)[4])
+    {
+        const uint64_t rc = spb_.mqtt != nullptr ? spb_.mqtt->reconnects() : 0;
+        if (rc == spb_.born_at_reconnects)
+            return;
+        PayloadBufs::Handle nb = pool_.acquire();
+        PayloadBufs::Handle db = pool_.acquire();
+        if (nb == PayloadBufs::kInvalid || db == PayloadBufs::kInvalid) // retried with the next sample
+        {
+            if (nb != PayloadBufs::kInvalid)
+                pool_.release(nb);
+            if (db != PayloadBufs::kInvalid)
+                pool_.release(db);
+            return;
+        }
+        flush_sparkplug(); // pending data belongs to the previous birth cycle
+        using industrial::sparkplug::Value;
+        const uint64_t ts = epoch_ms(smp.ts);
+        const Value node_values[] = {Value::of_bool(false)};
+        const Value device_values[] = {Value::of_float(values[0]), Value::of_float(values[1]),
+                                       Value::of_float(values[2]), Value::of_float(values[3])};
+        size_t n = industrial::sparkplug_nbirth(pool_.data(nb), PayloadBufs::buffer_size(), spb_.session, ts,
+                                                kSparkplugNodeMetrics, node_values, 1);
+        size_t d = industrial::sparkplug_dbirth(pool_.data(db), PayloadBufs::buffer_size(), spb_.session, ts,
+                                                kSparkplugDeviceMetrics, device_values, 4);
+        pool_.set_len(nb, (uint32_t)n);
+        pool_.set_len(db, (uint32_t)d);
+        out_.submit(nb, spb_.nbirth_topic, true);
+        out_.submit(db, spb_.dbirth_topic, true);
+        spb_.born_at_reconnects = rc;
+    }
+
+    PayloadBufs &pool_;
+    Outputs &out_;
+    std::string_view topic_;
+    std::string_view block_topic_;
+    PayloadFormat format_;
+    Deadband *deadband_;
+    bool conflate_;
+    Alarms *alarms_;
+    std::string_view alarm_topic_;
+    SparkplugOut &spb_;
+    UadpOutputs *uadp_out_;
+    industrial::UadpEncoder &uadp_;
+    const InfluxOut &influx_;
+    industrial::ModbusServer *modbus_;
+
+    PayloadBufs::Handle block_ = PayloadBufs::kInvalid;
+    industrial::GorillaEncoder enc_{nullptr, 0};
+    PayloadBufs::Handle spb_batch_ = PayloadBufs::kInvalid;
+    uint32_t spb_samples_ = 0;
+    industrial::SparkplugEncoder spb_enc_{nullptr, 0};
+};
 
 /**
  * @brief Program entry for the industrial sensor simulator demo
  *
- * Initializes a single-producer single-consumer ring buffer, starts a simulated sensor
- * producer and a consumer that computes a moving average and optionally publishes results
- * to an MQTT broker. Designed for host demonstration with std::thread;
+ * Declares the sensor -> average -> publish pipeline, starts its threads and optionally
+ * publishes results to an MQTT broker. Designed for host demonstration with std::thread;
  */
 int main(int argc, char **argv)
 {
     using namespace industrial;
 
-    RingBuf q;
     SimSensor sensor;
 
     // MQTT setup (host-only convenience): configure via environment variables.
@@ -155,6 +560,7 @@ int main(int argc, char **argv)
     // MQTT_TOPIC default: sensors/demo/readings
     char *env_broker = std::getenv("MQTT_BROKER_URL");
     char *env_topic = std::getenv("MQTT_TOPIC");
+    char *env_payload = std::getenv("MQTT_PAYLOAD");
 #ifdef MQTT_BROKER_URL
     char *def_broker = MQTT_BROKER_URL;
 #else
@@ -167,15 +573,277 @@ int main(int argc, char **argv)
 #endif
     std::string broker = env_broker ? env_broker : std::string(def_broker);
     std::string topic = env_topic ? env_topic : std::string(def_topic);
+    // MQTT_PAYLOAD: "csv" (default, one message per sample), "gorilla" (compressed sample blocks) or
+    // "sparkplug" (Sparkplug B NBIRTH/DBIRTH + batched DDATA under SPARKPLUG_GROUP / SPARKPLUG_NODE)
+    PayloadFormat format = PayloadFormat::Csv;
+    if (env_payload && std::strcmp(env_payload, "gorilla") == 0)
+        format = PayloadFormat::Gorilla;
+    else if (env_payload && std::strcmp(env_payload, "sparkplug") == 0)
+        format = PayloadFormat::Sparkplug;
+    // Every topic published on is rendered once into one arena; stages and sinks only pass views of it
+    char *env_spb_group = std::getenv("SPARKPLUG_GROUP");
+    char *env_spb_node = std::getenv("SPARKPLUG_NODE");
+    const std::string_view spb_group = env_spb_group ? env_spb_group : "plant";
+    const std::string_view spb_node = env_spb_node ? env_spb_node : "sensor-sim";
+    const std::string_view spb_ns = industrial::sparkplug::kNamespace;
+    TopicArena<kAppTopicBytes, 8> topics;
+    const std::string_view readings_topic = topics.add({topic});
+    const std::string_view block_topic = topics.add({topic, "/gorilla"});
+    const std::string_view alarm_topic = topics.add({topic, "/alarm"});
+    SparkplugOut spb;
+    spb.nbirth_topic = topics.add({spb_ns, "/", spb_group, "/NBIRTH/", spb_node});
+    spb.dbirth_topic = topics.add({spb_ns, "/", spb_group, "/DBIRTH/", spb_node, "/sim0"});
+    spb.ddata_topic = topics.add({spb_ns, "/", spb_group, "/DDATA/", spb_node, "/sim0"});
+    if (topics.size() != 6) // add() refused one
+    {
+        std::cout << "mqtt: topics longer than " << kAppTopicBytes << " characters in total\n";
+        return 1;
+    }
+    // MQTT_MODE: "sync" (default), "pipelined" or "batched" (see MqttPublisher.hpp)
+    char *env_mode = std::getenv("MQTT_MODE");
     MqttPublisher mqtt;
-    bool mqtt_on = mqtt.connect(broker, "sensor-sim", 60);
-    if (mqtt_on)
+    spb.mqtt = &mqtt;
+    if (env_mode && std::strcmp(env_mode, "pipelined") == 0)
+    {
+        mqtt.set_mode(MqttPublisher::Mode::Pipelined);
+    }
+    else if (env_mode && std::strcmp(env_mode, "batched") == 0)
+    {
+        mqtt.set_mode(MqttPublisher::Mode::Batched);
+    }
+    // Connect in the background so sampling starts at once whatever the broker does; the supervisor
+    // also keeps the session alive later. publish() fails fast while it is down, and the MQTT sink
+    // holds (or spools) what is produced meanwhile.
+    bool mqtt_supervised = mqtt.connect_async(broker, "sensor-sim", 60);
+    if (mqtt_supervised)
     {
-        std::cout << "mqtt: connected to " << broker << ", topic='" << topic << "'\n";
+        std::cout << "mqtt: connecting to " << broker << " in background, topic='" << topic << "'\n";
     }
     else
     {
-        std::cout << "mqtt: disabled (library missing or connect failed)\n";
+        std::cout << "mqtt: disabled (bad broker url)\n";
+    }
+
+    // Store-and-forward spool (optional): SPOOL_DIR enables it, SPOOL_DRAIN_RATE caps replay in msgs/s.
+    // Payloads that cannot be published are kept on disk and replayed once the broker is reachable,
+    // including those left over from a previous run.
+    char *env_spool = std::getenv("SPOOL_DIR");
+    char *env_drain = std::getenv("SPOOL_DRAIN_RATE");
+    double drain_rate = env_drain ? std::strtod(env_drain, nullptr) : 200.0;
+    static Spool spool; // ~50 KiB of queue storage; keep it off the stack
+    if (env_spool && *env_spool)
+    {
+        if (spool.open(env_spool, kSpoolSegmentBytes, kSpoolSegments))
+        {
+            spool.start();
+            std::cout << "spool: " << env_spool << ", drain rate " << drain_rate << " msg/s\n";
+        }
+        else
+        {
+            std::cout << "spool: failed to open " << env_spool << ", unsent payloads will be dropped\n";
+        }
+    }
+
+    // Output sinks: SINKS is a comma-separated list of mqtt,file,stdout,null,local (default: mqtt).
+    // Each enabled sink runs on its own thread and receives the same encoded buffer by handle.
+    // SINK_FILE names the file sink's output (default: sensor_sim.out), LOCAL_SUB_SOCKET the
+    // local subscription socket (default: /tmp/sensor_sim.sock).
+    char *env_sinks = std::getenv("SINKS");
+    char *env_sink_file = std::getenv("SINK_FILE");
+    char *env_local_sock = std::getenv("LOCAL_SUB_SOCKET");
+    std::string sinks = env_sinks ? env_sinks : "mqtt";
+    static PayloadBufs pool; // shared encoded-payload buffers (~330 KiB); keep it off the stack
+    MqttSink mqtt_sink(mqtt, spool.is_open() ? &spool : nullptr, drain_rate, kSpoolDrainBurst);
+    FileSink file_sink;
+    StdoutSink stdout_sink;
+    NullSink null_sink;
+    static LocalSubServer local_sink; // ~30 KiB of topic trie; keep it off the stack
+    Outputs out(pool, mqtt_sink, file_sink, stdout_sink, null_sink, local_sink);
+    // Per-lane MQTT options: ALARM_QOS (default 1) / ALARM_RETAIN (default 0) for the priority lane,
+    // TELEMETRY_QOS / TELEMETRY_RETAIN (default 0 / 0) for everything else.
+    char *env_alarm_qos = std::getenv("ALARM_QOS");
+    char *env_alarm_retain = std::getenv("ALARM_RETAIN");
+    char *env_tele_qos = std::getenv("TELEMETRY_QOS");
+    char *env_tele_retain = std::getenv("TELEMETRY_RETAIN");
+    MqttSink::LaneOptions telemetry_lane{env_tele_qos ? std::atoi(env_tele_qos) : 0,
+                                         env_tele_retain ? std::atoi(env_tele_retain) != 0 : false};
+    MqttSink::LaneOptions alarm_lane{env_alarm_qos ? std::atoi(env_alarm_qos) : 1,
+                                     env_alarm_retain ? std::atoi(env_alarm_retain) != 0 : false};
+    mqtt_sink.set_lanes(telemetry_lane, alarm_lane);
+    out.enable(kSinkMqtt, has_item(sinks, "mqtt"));
+    out.enable(kSinkStdout, has_item(sinks, "stdout"));
+    out.enable(kSinkNull, has_item(sinks, "null"));
+    if (has_item(sinks, "file"))
+    {
+        const char *path = env_sink_file ? env_sink_file : "sensor_sim.out";
+        out.enable(kSinkFile, file_sink.open(path));
+        if (!file_sink.is_open())
+            std::cout << "sinks: cannot open " << path << ", file sink disabled\n";
+    }
+    if (has_item(sinks, "local"))
+    {
+        const char *path = env_local_sock ? env_local_sock : "/tmp/sensor_sim.sock";
+        out.enable(kSinkLocal, local_sink.open(path));
+        if (!local_sink.is_open())
+            std::cout << "sinks: cannot listen on " << path << ", local sink disabled\n";
+    }
+    std::cout << "sinks:";
+    for (std::size_t i = 0; i < Outputs::size(); ++i)
+        if (out.enabled(i))
+            std::cout << ' ' << out.name(i);
+    std::cout << '\n';
+    out.start();
+
+    // OPC UA PubSub over UDP (optional): UADP_ADDR=group[:port] (e.g. 239.0.0.1, default port 4840),
+    // UADP_PUBLISHER_ID (default 1). Runs on its own sink thread, sharing the payload pool.
+    char *env_uadp = std::getenv("UADP_ADDR");
+    char *env_uadp_pub = std::getenv("UADP_PUBLISHER_ID");
+    UdpMulticastSink udp_sink;
+    UadpOutputs uadp_out(pool, udp_sink);
+    UadpConfig uadp_cfg;
+    if (env_uadp_pub)
+        uadp_cfg.publisher_id = (uint16_t)std::strtoul(env_uadp_pub, nullptr, 10);
+    UadpEncoder uadp(uadp_cfg);
+    bool uadp_on = false;
+    if (env_uadp && *env_uadp)
+    {
+        std::string addr = env_uadp;
+        uint16_t port = 4840;
+        std::size_t colon = addr.find(':');
+        if (colon != std::string::npos)
+        {
+            port = (uint16_t)std::strtoul(addr.c_str() + colon + 1, nullptr, 10);
+            addr.resize(colon);
+        }
+        uadp_on = udp_sink.open(addr, port);
+        std::cout << "uadp: " << (uadp_on ? "publishing to " : "cannot open ") << addr << ':' << port
+                  << ", publisher id " << uadp_cfg.publisher_id << '\n';
+        uadp_out.enable(0, uadp_on);
+        uadp_out.start();
+    }
+
+    // InfluxDB line protocol (optional): INFLUX_URL=tcp://host:port (raw line protocol, e.g. Telegraf
+    // socket_listener) or http://host:port/write?db=plant (/api/v2/write?... for 2.x). INFLUX_MEASUREMENT
+    // (default sensor_sim) and INFLUX_TAGS (extra "k=v,k2=v2", already escaped) shape each line;
+    // INFLUX_FLUSH_BYTES / INFLUX_FLUSH_MS set the batch size and age thresholds.
+    char *env_influx = std::getenv("INFLUX_URL");
+    char *env_influx_meas = std::getenv("INFLUX_MEASUREMENT");
+    char *env_influx_tags = std::getenv("INFLUX_TAGS");
+    char *env_influx_bytes = std::getenv("INFLUX_FLUSH_BYTES");
+    char *env_influx_ms = std::getenv("INFLUX_FLUSH_MS");
+    static InfluxSink influx_sink; // 256 KiB batch buffer; keep it off the stack
+    InfluxOutputs influx_out(pool, influx_sink);
+    InfluxOut influx;
+    if (env_influx && *env_influx)
+    {
+        if (influx_sink.open(env_influx))
+        {
+            influx_escape(env_influx_meas ? env_influx_meas : "sensor_sim", false, influx.prefix);
+            influx.prefix += ",sensor=sim0";
+            if (env_influx_tags && *env_influx_tags)
+                influx.prefix += std::string(",") + env_influx_tags;
+            influx_sink.set_flush(env_influx_bytes ? std::strtoul(env_influx_bytes, nullptr, 10) : kInfluxFlushBytes,
+                                  std::chrono::milliseconds(env_influx_ms ? std::strtol(env_influx_ms, nullptr, 10)
+                                                                          : kInfluxFlushMs));
+            influx.out = &influx_out;
+            influx_out.enable(0, true);
+            influx_out.start();
+            std::cout << "influx: " << env_influx << (influx_sink.connected() ? "" : " (not reachable yet)")
+                      << ", measurement '" << influx.prefix << "'\n";
+        }
+        else
+        {
+            std::cout << "influx: disabled (bad url " << env_influx << ")\n";
+        }
+    }
+
+    // Modbus TCP server (optional): MODBUS_PORT (502 needs privileges; e.g. 1502), MODBUS_BIND (default
+    // 0.0.0.0). Holding and input tables carry the same map; values are x10 so one decimal survives.
+    char *env_modbus = std::getenv("MODBUS_PORT");
+    char *env_modbus_bind = std::getenv("MODBUS_BIND");
+    static ModbusServer modbus; // per-client receive buffers; keep it off the stack
+    bool modbus_on = false;
+    if (env_modbus && *env_modbus)
+    {
+        const uint16_t port = (uint16_t)std::strtoul(env_modbus, nullptr, 10);
+        modbus_on = modbus.open(port, env_modbus_bind ? env_modbus_bind : "0.0.0.0");
+        if (modbus_on)
+        {
+            for (ModbusServer::Table t : {ModbusServer::Table::Holding, ModbusServer::Table::Input})
+            {
+                for (uint16_t ch = 0; ch < 4; ++ch)
+                    modbus.map(t, ch, ch, 10.0f);
+                modbus.map_counter(t, 4);
+            }
+            modbus_on = modbus.start();
+        }
+        std::cout << "modbus: " << (modbus_on ? "serving on port " : "cannot listen on port ") << port << '\n';
+    }
+
+    // Report-by-exception (CSV payloads only; Gorilla blocks archive every raw sample):
+    // DEADBAND_TEMP / DEADBAND_PRESS are absolute deadbands (C / kPa) on the smoothed values,
+    // DEADBAND_PCT a percentage deadband for both, HEARTBEAT_MS the longest silence before an
+    // unchanged value is sent anyway. Unset means every sample is published.
+    char *env_db_t = std::getenv("DEADBAND_TEMP");
+    char *env_db_p = std::getenv("DEADBAND_PRESS");
+    char *env_db_pct = std::getenv("DEADBAND_PCT");
+    char *env_heartbeat = std::getenv("HEARTBEAT_MS");
+    Deadband deadband;
+    bool deadband_on = env_db_t || env_db_p || env_db_pct || env_heartbeat;
+    if (deadband_on)
+    {
+        float pct = env_db_pct ? std::strtof(env_db_pct, nullptr) : 0.0f;
+        deadband.set_channel(0, env_db_t ? std::strtof(env_db_t, nullptr) : 0.0f, pct);
+        deadband.set_channel(1, env_db_p ? std::strtof(env_db_p, nullptr) : 0.0f, pct);
+        deadband.set_max_silence(std::chrono::milliseconds(env_heartbeat ? std::strtol(env_heartbeat, nullptr, 10) : 0));
+        std::cout << "deadband: temp=" << (env_db_t ? env_db_t : "0") << " C, press=" << (env_db_p ? env_db_p : "0")
+                  << " kPa, pct=" << pct << "%, heartbeat=" << (env_heartbeat ? env_heartbeat : "0") << " ms\n";
+    }
+
+    // Threshold alarms on the smoothed values (unset limits are off): ALARM_TEMP_HIGH / ALARM_TEMP_LOW (C),
+    // ALARM_PRESS_HIGH / ALARM_PRESS_LOW (kPa); an alarm clears once the value is back inside by more than
+    // ALARM_TEMP_HYST (default 0.5 C) / ALARM_PRESS_HYST (default 5 kPa).
+    const char *alarm_env[4] = {std::getenv("ALARM_TEMP_HIGH"), std::getenv("ALARM_TEMP_LOW"),
+                                std::getenv("ALARM_PRESS_HIGH"), std::getenv("ALARM_PRESS_LOW")};
+    char *env_temp_hyst = std::getenv("ALARM_TEMP_HYST");
+    char *env_press_hyst = std::getenv("ALARM_PRESS_HYST");
+    const float hyst[2] = {env_temp_hyst ? std::strtof(env_temp_hyst, nullptr) : 0.5f,
+                           env_press_hyst ? std::strtof(env_press_hyst, nullptr) : 5.0f};
+    Alarms alarms;
+    for (uint32_t ch = 0; ch < 2; ++ch)
+    {
+        if (alarm_env[2 * ch])
+            alarms.set_high(ch, std::strtof(alarm_env[2 * ch], nullptr), hyst[ch]);
+        if (alarm_env[2 * ch + 1])
+            alarms.set_low(ch, std::strtof(alarm_env[2 * ch + 1], nullptr), hyst[ch]);
+    }
+    if (alarms.configured())
+        std::cout << "alarms: publishing to " << alarm_topic << " (priority lane, qos " << alarm_lane.qos << ")\n";
+
+    // Conflation (default on): CSV readings replace a pending older reading of the same topic when a
+    // sink is behind. Gorilla blocks, Sparkplug messages and births always queue in order.
+    char *env_conflate = std::getenv("CONFLATE");
+    bool conflate = !(env_conflate && std::strcmp(env_conflate, "0") == 0);
+
+    // Periodic publish statistics (optional): MQTT_STATS_MS prints them from a reporter thread that
+    // never touches the publishing path.
+    char *env_stats = std::getenv("MQTT_STATS_MS");
+    unsigned long stats_ms = env_stats ? std::strtoul(env_stats, nullptr, 10) : 0;
+    std::atomic<bool> stats_run{stats_ms > 0};
+    std::thread stats;
+    if (stats_ms > 0)
+    {
+        stats = std::thread([&]
+                            {
+            auto next = std::chrono::steady_clock::now();
+            while (stats_run.load(std::memory_order_relaxed))
+            {
+                next += std::chrono::milliseconds(stats_ms);
+                while (stats_run.load(std::memory_order_relaxed) && std::chrono::steady_clock::now() < next)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                if (stats_run.load(std::memory_order_relaxed))
+                    print_publish_stats(mqtt);
+            } });
     }
 
     // Parse optional CLI args: [window] [count]
@@ -205,15 +873,220 @@ int main(int argc, char **argv)
     std::size_t sample_count = static_cast<std::size_t>(count_ul);
     std::cout << "sample count set to " << sample_count << "\n";
 
-    // Run producer and consumer concurrently: host-only demo using std::thread
-    // On embedded, prefer RTOS tasks or a cooperative main loop plus ISRs
-    std::thread prod([&]
-                     { producer_task(q, sensor, sample_count, std::chrono::milliseconds(50)); });
-    std::thread cons([&]
-                     { consumer_task_runtime(q, sample_count, std::chrono::milliseconds(5000), window,
-                                             mqtt_on ? &mqtt : nullptr, topic); });
-    prod.join(); // thread join is a host primitive; on RTOS use task sync or semaphores
-    cons.join();
+    // Console log (LOG_LEVEL): debug (default) prints every sample, info only summaries, warn/error less.
+    // Stages only queue raw values; a writer thread formats them and writes in batches.
+    char *env_log_level = std::getenv("LOG_LEVEL");
+    static AsyncLog app_log; // per-thread record rings (~400 KiB); keep it off the stack
+    if (env_log_level && *env_log_level && !app_log.set_level(env_log_level))
+        std::cout << "log: unknown LOG_LEVEL=" << env_log_level << ", using debug\n";
+
+    // Sampling pipeline, declared once: sensor -> average -> publish. PIPELINE_THREADS=2 (default) runs the
+    // sensor on thread 0 and averaging + publishing on thread 1; 3 gives publishing a thread of its own.
+    // The sensor link drops the oldest sample when full (sampling keeps real time); the readings link
+    // makes averaging wait for publishing instead.
+    static Link<SensorSample, kRingCapacity> raw(LinkBase::Overflow::DropOldest);
+    static Link<Reading, kRingCapacity> readings;
+    static LatencyHistogram pickup; // sample timestamp -> taken by the average stage
+    // Sampling schedule: 50 ms period; SENSOR_MISS_POLICY=catchup (default) takes every missed sample late,
+    // skip drops the missed ones and stays on the grid. TIMING_EXPORT=<file> writes its summary and
+    // histograms as CSV at exit.
+    static PeriodicSchedule schedule(std::chrono::nanoseconds(std::chrono::milliseconds(50)).count());
+    char *env_miss = std::getenv("SENSOR_MISS_POLICY");
+    if (env_miss && *env_miss && !schedule.set_policy(env_miss))
+        std::cout << "sensor: unknown SENSOR_MISS_POLICY=" << env_miss << ", using catchup\n";
+    SensorStage sensor_stage{sensor, sample_count, schedule};
+    static AverageStage average_stage(window, pickup, app_log); // two 256-sample windows; keep it off the stack
+    PublishStage publish_stage(pool, out, readings_topic, block_topic, format, deadband_on ? &deadband : nullptr,
+                               conflate, alarms.configured() ? &alarms : nullptr, alarm_topic, spb,
+                               uadp_on ? &uadp_out : nullptr, uadp, influx, modbus_on ? &modbus : nullptr);
+    char *env_threads = std::getenv("PIPELINE_THREADS");
+    const uint32_t publish_thread = env_threads && std::strtoul(env_threads, nullptr, 10) >= 3 ? 2 : 1;
+    Pipeline pipe;
+    pipe.source("sensor", sensor_stage, raw, 0);
+    pipe.transform("average", raw, average_stage, readings, 1);
+    pipe.sink("publish", readings, publish_stage, publish_thread);
+
+    // Consumer idle strategy (CONSUMER_WAIT) for the averaging/publishing threads: event (default), park,
+    // backoff, yield, spin, or sleep (5 ms polling). The sensor thread parks until its next sample.
+    char *env_wait = std::getenv("CONSUMER_WAIT");
+    const char *wait_name = env_wait && *env_wait ? env_wait : "event";
+    for (uint32_t t = 1; t <= publish_thread; ++t)
+    {
+        if (!pipe.wait(t).select(wait_name))
+        {
+            if (t == 1)
+                std::cout << "consumer: CONSUMER_WAIT=" << wait_name << " unavailable, using park\n";
+            (void)pipe.wait(t).select(AnyWait::Kind::Park);
+        }
+    }
+
+    // Real-time mode (RT_MODE=1): each pipeline thread pins itself to its entry in RT_CPUS ("0,1,1";
+    // none: no pinning) and runs SCHED_FIFO, the sensor at RT_PRIORITY (default 80) and each later
+    // thread one below; memory is locked and the rings and stage state prefaulted before start. Steps
+    // that lack privileges are reported and skipped. Spinning waits keep SCHED_OTHER: a FIFO thread
+    // that never sleeps would starve everything else on its CPU.
+    char *env_rt = std::getenv("RT_MODE");
+    const bool rt_on = env_rt && (std::strcmp(env_rt, "1") == 0 || std::strcmp(env_rt, "on") == 0);
+    if (rt_on)
+    {
+        int cpus[kPipelineMaxThreads];
+        const uint32_t ncpus = rt_parse_cpus(std::getenv("RT_CPUS"), cpus, kPipelineMaxThreads);
+        char *env_prio = std::getenv("RT_PRIORITY");
+        long prio = env_prio ? std::strtol(env_prio, nullptr, 10) : 80;
+        prio = prio < 1 ? 1 : (prio > 99 ? 99 : prio);
+        for (uint32_t t = 0; t <= publish_thread; ++t)
+        {
+            const AnyWait::Kind k = pipe.wait(t).kind();
+            RtThread rt;
+            rt.cpu = t < ncpus ? cpus[t] : -1;
+            rt.priority = k == AnyWait::Kind::Spin || k == AnyWait::Kind::Yield ? 0 : (int)(prio > (long)t ? prio - t : 1);
+            (void)pipe.realtime(t, rt);
+        }
+        const int err = rt_lock_memory();
+        if (err == 0)
+            std::cout << "rt: memory locked (mlockall)\n";
+        else
+            std::cout << "rt: mlockall failed (" << std::strerror(err) << "), memory stays pageable\n";
+        rt_prefault(&average_stage, sizeof(average_stage));
+        rt_prefault(&pickup, sizeof(pickup));
+        rt_prefault(&schedule, sizeof(schedule));
+    }
+    std::cout.flush(); // setup lines go out before the logger's first batch
+    app_log.start(stdout);
+
+    // Host-only demo using std::thread per pipeline thread; on embedded, RTOS tasks or a cooperative main
+    // loop plus ISRs would run the same stages. The run ends when the last sample is through, or 5 s
+    // after the sensor should have finished (then the sensor is stopped and the rest drained).
+    pipe.start();
+    if (!pipe.wait_for(std::chrono::milliseconds(50) * sample_count + std::chrono::seconds(5)))
+        pipe.stop();
+    pipe.join();
+
+    const Pipeline::StageStats averaged = pipe.stats(1);
+    app_log.log(kLogConsumed, (std::size_t)averaged.in);
+    if (pickup.count() > 0)
+    {
+        int64_t cpu_ns = 0;
+        uint64_t wakes = 0;
+        for (uint32_t t = 1; t <= publish_thread; ++t)
+        {
+            cpu_ns += pipe.thread_cpu_ns(t);
+            if (pipe.wait(t).kind() == AnyWait::Kind::Event)
+                wakes += pipe.wait(t).event().doorbell().signals();
+            else if (pipe.wait(t).kind() == AnyWait::Kind::Park)
+                wakes += pipe.wait(t).park().wakes();
+        }
+        const AnyWait::Kind kind = pipe.wait(1).kind();
+        const char *name = pipe.wait(1).name(); // static strings: safe to log by pointer
+        const uint64_t p50 = pickup.percentile(50) / 1000, p99 = pickup.percentile(99) / 1000, max = pickup.max() / 1000;
+        if (kind == AnyWait::Kind::Event || kind == AnyWait::Kind::Park)
+            app_log.log(kLogPickupWakes, name, p50, p99, max, cpu_ns / 1000000, wakes);
+        else
+            app_log.log(kLogPickup, name, p50, p99, max, cpu_ns / 1000000);
+    }
+    const double secs = (double)pipe.elapsed_ns() / 1e9;
+    for (uint32_t i = 0; i < pipe.size(); ++i)
+    {
+        const Pipeline::StageStats st = pipe.stats(i);
+        const uint64_t items = st.capacity > 0 ? st.in : st.out;
+        app_log.log(kLogStage, st.name, st.thread, st.in, st.out, secs > 0 ? (double)items / secs : 0.0, st.dropped,
+                    st.blocked, st.high_water);
+    }
+    if (schedule.iterations() > 0)
+    {
+        const LatencyHistogram &late = schedule.lateness(), &run = schedule.run_time(), &jitter = schedule.jitter();
+        app_log.log(kLogJitter, jitter.percentile(50) / 1000, jitter.percentile(99) / 1000, jitter.max() / 1000,
+                    rt_on ? "on" : "off");
+        app_log.log(kLogLateness, late.percentile(50) / 1000, late.percentile(99) / 1000, late.max() / 1000,
+                    run.percentile(99) / 1000, run.max() / 1000);
+        app_log.log(kLogMisses, schedule.iterations(), schedule.overruns(), schedule.misses(), schedule.skipped(),
+                    schedule.policy_name());
+    }
+    for (uint32_t t = 0; rt_on && t <= publish_thread; ++t)
+    {
+        const RtStatus rs = pipe.rt_status(t);
+        app_log.log(kLogRt, t, rs.cpu, rt_outcome(rs.cpu >= 0, rs.pinned, rs.pin_err), rs.priority,
+                    rt_outcome(rs.priority > 0, rs.fifo, rs.fifo_err), rs.stack ? "yes" : "no");
+    }
+    app_log.stop(); // writes what is still queued before the summaries below
+    char *env_timing = std::getenv("TIMING_EXPORT");
+    if (env_timing && *env_timing)
+    {
+        std::FILE *f = std::fopen(env_timing, "w");
+        const bool ok = f != nullptr && schedule.write_csv(f);
+        if (f != nullptr)
+            std::fclose(f);
+        std::cout << "sensor: timing " << (ok ? "exported to " : "export failed: ") << env_timing << '\n';
+    }
+    stats_run.store(false, std::memory_order_relaxed);
+    if (stats.joinable())
+        stats.join();
+
+    out.stop(); // sinks finish their queues before the publisher and spool go away
+    uadp_out.stop();
+    influx_out.stop();
+    influx_sink.close(); // last flush of whatever is still batched
+    modbus.close();
+    if (deadband_on)
+    {
+        std::cout << "deadband: published=" << deadband.passed() << " suppressed=" << deadband.suppressed()
+                  << " heartbeats=" << deadband.heartbeats() << '\n';
+    }
+    for (std::size_t i = 0; i < Outputs::size(); ++i)
+    {
+        if (!out.enabled(i))
+            continue;
+        Outputs::Stats st = out.stats(i);
+        std::cout << "sink " << out.name(i) << ": frames=" << st.frames << " bytes=" << st.bytes
+                  << " failed=" << st.failed << " dropped=" << st.dropped << " conflated=" << st.conflated << '\n';
+        if (st.priority > 0)
+        {
+            const industrial::LatencyHistogram &lat = out.priority_latency(i);
+            std::cout << "sink " << out.name(i) << ": alarms=" << st.priority
+                      << " latency p50=" << lat.percentile(50) / 1000 << " us p99=" << lat.percentile(99) / 1000
+                      << " us max=" << lat.max() / 1000 << " us\n";
+        }
+    }
+    if (uadp_on)
+    {
+        UadpOutputs::Stats us = uadp_out.stats(0);
+        std::cout << "sink udp: frames=" << us.frames << " bytes=" << us.bytes << " failed=" << us.failed
+                  << " dropped=" << us.dropped << " datagrams=" << udp_sink.datagrams()
+                  << " sendmmsg calls=" << udp_sink.send_calls() << '\n';
+    }
+    if (influx.out != nullptr)
+    {
+        std::cout << "sink influx: lines=" << influx_sink.lines() << " batches=" << influx_sink.batches()
+                  << " bytes=" << influx_sink.bytes_sent() << " dropped=" << influx_sink.dropped_lines()
+                  << " send failures=" << influx_sink.send_failures() << '\n';
+    }
+    if (modbus_on)
+    {
+        std::cout << "modbus: requests=" << modbus.requests() << " exceptions=" << modbus.exceptions()
+                  << " connections=" << modbus.connects() << " dropped=" << modbus.dropped() << '\n';
+    }
+
+    if (mqtt_supervised)
+    {
+        mqtt.stop_reconnect();
+        std::cout << "mqtt: held while disconnected: replayed=" << mqtt_sink.backlog_replayed()
+                  << " dropped=" << mqtt_sink.backlog_dropped() << " still held=" << mqtt_sink.backlog() << '\n';
+        std::cout << "mqtt: reconnects=" << mqtt.reconnects() << " failed attempts=" << mqtt.connect_failures()
+                  << " last recovery=" << mqtt.last_recovery_ns() / 1000000 << " ms"
+                  << " worst recovery=" << mqtt.max_recovery_ns() / 1000000 << " ms\n";
+    }
+    if (mqtt.published() + mqtt.publish_failures() > 0)
+        print_publish_stats(mqtt);
+
+    if (spool.is_open())
+    {
+        spool.close(); // stops the writer after it has flushed the queue
+        std::cout << "spool: appended=" << spool.appended() << " replayed=" << spool.drained()
+                  << " dropped=" << spool.dropped() << '\n';
+    }
+    if (app_log.dropped() > 0)
+        std::cout << "log: written=" << app_log.written() << " dropped=" << app_log.dropped()
+                  << " writes=" << app_log.batches() << '\n';
 
     return 0;
 }
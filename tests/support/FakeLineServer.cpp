@@ -0,0 +1,208 @@
+/**
+ * @file FakeLineServer.cpp
+ * @brief Single-threaded poll() loop behind the stand-in line-protocol listener.
+ */
+#include "FakeLineServer.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace industrial {
+namespace testing {
+
+bool FakeLineServer::start(uint16_t port) {
+    if (running_.load()) return true;
+    if (port == 0) port = port_;
+    listen_fd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0) return false;
+    int one = 1;
+    ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    socklen_t alen = sizeof(addr);
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listen_fd_, 16) != 0 ||
+        ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &alen) != 0 ||
+        ::pipe2(wake_, O_CLOEXEC | O_NONBLOCK) != 0) {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        return false;
+    }
+    port_ = ntohs(addr.sin_port);
+    running_.store(true);
+    thread_ = std::thread([this] { run(); });
+    return true;
+}
+
+void FakeLineServer::stop() {
+    if (!running_.exchange(false)) return;
+    (void)!::write(wake_[1], "x", 1);
+    if (thread_.joinable()) thread_.join();
+    ::close(listen_fd_);
+    ::close(wake_[0]);
+    ::close(wake_[1]);
+    listen_fd_ = wake_[0] = wake_[1] = -1;
+}
+
+void FakeLineServer::drop_clients() {
+    drop_.store(true);
+    (void)!::write(wake_[1], "x", 1);
+    while (drop_.load()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+std::string FakeLineServer::url() const {
+    const std::string hp = "127.0.0.1:" + std::to_string(port_);
+    return mode_ == Mode::Http ? "http://" + hp + "/write?db=test" : "tcp://" + hp;
+}
+
+std::string FakeLineServer::last_target() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return last_target_;
+}
+
+std::vector<std::string> FakeLineServer::received() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return received_;
+}
+
+void FakeLineServer::clear() {
+    std::lock_guard<std::mutex> lk(mu_);
+    received_.clear();
+    lines_.store(0);
+    bytes_.store(0);
+    requests_.store(0);
+}
+
+bool FakeLineServer::wait_lines(uint64_t n, int timeout_ms) const {
+    auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (lines_.load() < n) {
+        if (std::chrono::steady_clock::now() >= until) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// Complete lines in [p, p + n) are counted (and kept); an unterminated tail goes to partial.
+void FakeLineServer::take_lines(const char* p, size_t n, std::string* partial) {
+    bytes_.fetch_add(n);
+    const bool keep = keep_.load();
+    std::lock_guard<std::mutex> lk(mu_);
+    size_t start = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (p[i] != '\n') continue;
+        if (keep) received_.emplace_back(p + start, i - start);
+        lines_.fetch_add(1);
+        start = i + 1;
+    }
+    if (partial != nullptr) partial->assign(p + start, n - start);
+}
+
+bool FakeLineServer::handle(Conn& c) {
+    if (mode_ == Mode::Tcp) {
+        std::string rest;
+        take_lines(c.rx.data(), c.rx.size(), &rest);
+        bytes_.fetch_sub(rest.size()); // counted again once the line completes
+        c.rx.swap(rest);
+        return true;
+    }
+    for (;;) {
+        const size_t head_end = c.rx.find("\r\n\r\n");
+        if (head_end == std::string::npos) return true;
+        size_t body = 0;
+        for (size_t pos = 0; pos < head_end;) {
+            const size_t eol = c.rx.find("\r\n", pos);
+            if (::strncasecmp(c.rx.c_str() + pos, "content-length:", 15) == 0)
+                body = std::strtoul(c.rx.c_str() + pos + 15, nullptr, 10);
+            pos = eol + 2;
+        }
+        const size_t total = head_end + 4 + body;
+        if (c.rx.size() < total) return true;
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            const size_t sp1 = c.rx.find(' ');
+            const size_t sp2 = c.rx.find(' ', sp1 + 1);
+            last_target_ = c.rx.substr(sp1 + 1, sp2 - sp1 - 1);
+        }
+        requests_.fetch_add(1);
+        const int status = status_.load();
+        if (status >= 200 && status < 300) take_lines(c.rx.data() + head_end + 4, body, nullptr);
+        const bool close_after = close_after_.load();
+        const char* err_body = status >= 300 ? "{\"error\":\"rejected\"}" : "";
+        char resp[256];
+        const int n = std::snprintf(resp, sizeof(resp), "HTTP/1.1 %d X\r\nContent-Length: %zu\r\n%s\r\n%s", status,
+                                    std::strlen(err_body), close_after ? "Connection: close\r\n" : "", err_body);
+        (void)::send(c.fd, resp, (size_t)n, MSG_NOSIGNAL);
+        c.rx.erase(0, total);
+        if (close_after) return false;
+    }
+}
+
+void FakeLineServer::run() {
+    std::vector<Conn> conns;
+    std::vector<pollfd> pfds;
+    while (running_.load()) {
+        pfds.clear();
+        pfds.push_back({listen_fd_, POLLIN, 0});
+        pfds.push_back({wake_[0], POLLIN, 0});
+        for (const Conn& c : conns) pfds.push_back({c.fd, POLLIN, 0});
+        if (::poll(pfds.data(), pfds.size(), 100) < 0 && errno != EINTR) break;
+
+        if (pfds[1].revents & POLLIN) {
+            char buf[64];
+            while (::read(wake_[0], buf, sizeof(buf)) > 0) {}
+        }
+        if (drop_.load()) {
+            for (Conn& c : conns) ::close(c.fd);
+            conns.clear();
+            drop_.store(false);
+            continue;
+        }
+
+        std::vector<Conn> keep;
+        for (size_t i = 0; i < conns.size(); ++i) {
+            Conn& c = conns[i];
+            bool alive = true;
+            if (pfds[2 + i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                static char buf[256 * 1024];
+                ssize_t r = ::recv(c.fd, buf, sizeof(buf), MSG_DONTWAIT);
+                if (r > 0) {
+                    c.rx.append(buf, static_cast<size_t>(r));
+                    alive = handle(c);
+                } else if (r == 0 || (errno != EAGAIN && errno != EINTR)) {
+                    alive = false;
+                }
+            }
+            if (alive) {
+                keep.push_back(std::move(c));
+            } else {
+                ::close(c.fd);
+            }
+        }
+        conns.swap(keep);
+
+        if (pfds[0].revents & POLLIN) {
+            int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd >= 0) {
+                conns.push_back({fd, {}});
+                connects_.fetch_add(1);
+            }
+        }
+    }
+    for (Conn& c : conns) ::close(c.fd);
+}
+
+} // namespace testing
+} // namespace industrial
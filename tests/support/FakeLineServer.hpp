@@ -0,0 +1,90 @@
+/**
+ * @file FakeLineServer.hpp
+ * @brief In-process stand-in for a line-protocol listener (raw TCP or InfluxDB-style HTTP write endpoint).
+ *
+ * Listens on 127.0.0.1 (ephemeral port by default) and serves every client from one poll() thread:
+ * - Tcp mode: the stream is split into '\n'-terminated lines
+ * - Http mode: each "POST <target>" request body (Content-Length) is split into lines and answered
+ *   with the configured status (204 by default), keeping the connection alive unless told otherwise
+ *
+ * @note:
+ * - Test support only: uses the heap and a mutex freely.
+ * - drop_clients() closes every connection (simulated server restart).
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace industrial {
+namespace testing {
+
+class FakeLineServer {
+public:
+    enum class Mode { Tcp, Http };
+
+    explicit FakeLineServer(Mode mode = Mode::Tcp) : mode_{mode} {}
+    ~FakeLineServer() { stop(); }
+    FakeLineServer(const FakeLineServer&) = delete;
+    FakeLineServer& operator=(const FakeLineServer&) = delete;
+
+    bool start(uint16_t port = 0);
+    void stop();
+    void drop_clients();
+
+    uint16_t port() const { return port_; }
+    // URL for InfluxSink: tcp://127.0.0.1:<port> or http://127.0.0.1:<port>/write?db=test
+    std::string url() const;
+
+    void set_status(int status) { status_.store(status); }
+    void set_close_after_response(bool on) { close_after_.store(on); }
+    void set_keep_lines(bool on) { keep_.store(on); } // off: count only (benchmarks)
+
+    uint64_t lines() const { return lines_.load(); }
+    uint64_t requests() const { return requests_.load(); } // HTTP requests (any status)
+    uint64_t bytes() const { return bytes_.load(); }        // body bytes
+    uint64_t connects() const { return connects_.load(); }
+    std::string last_target() const;
+
+    std::vector<std::string> received() const; // kept lines, without '\n'
+    void clear();
+    bool wait_lines(uint64_t n, int timeout_ms) const;
+
+private:
+    struct Conn {
+        int fd;
+        std::string rx;
+    };
+
+    void run();
+    bool handle(Conn& c); // false: close the connection
+    void take_lines(const char* p, size_t n, std::string* partial);
+
+    Mode mode_;
+    int listen_fd_{-1};
+    int wake_[2]{-1, -1};
+    uint16_t port_{0};
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> drop_{false};
+
+    std::atomic<int> status_{204};
+    std::atomic<bool> close_after_{false};
+    std::atomic<bool> keep_{true};
+
+    std::atomic<uint64_t> lines_{0};
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> bytes_{0};
+    std::atomic<uint64_t> connects_{0};
+
+    mutable std::mutex mu_;
+    std::vector<std::string> received_;
+    std::string last_target_;
+};
+
+} // namespace testing
+} // namespace industrial
@@ -0,0 +1,304 @@
+/**
+ * @file FakeMqttBroker.cpp
+ * @brief Single-threaded poll() loop behind the stand-in MQTT broker.
+ */
+#include "FakeMqttBroker.hpp"
+
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace industrial {
+namespace testing {
+
+bool FakeMqttBroker::start(uint16_t port) {
+    if (running_.load()) return true;
+    if (port == 0) port = port_;
+    listen_fd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0) return false;
+    int one = 1;
+    ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    socklen_t alen = sizeof(addr);
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listen_fd_, 16) != 0 ||
+        ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &alen) != 0 ||
+        ::pipe2(wake_, O_CLOEXEC | O_NONBLOCK) != 0) {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        return false;
+    }
+    port_ = ntohs(addr.sin_port);
+    running_.store(true);
+    thread_ = std::thread([this] { run(); });
+    return true;
+}
+
+void FakeMqttBroker::stop() {
+    if (!running_.exchange(false)) return;
+    (void)!::write(wake_[1], "x", 1);
+    if (thread_.joinable()) thread_.join();
+    ::close(listen_fd_);
+    ::close(wake_[0]);
+    ::close(wake_[1]);
+    listen_fd_ = wake_[0] = wake_[1] = -1;
+}
+
+void FakeMqttBroker::drop_clients() {
+    drop_.store(true);
+    (void)!::write(wake_[1], "x", 1);
+    while (drop_.load()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+std::vector<FakeMqttBroker::Message> FakeMqttBroker::messages() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return messages_;
+}
+
+void FakeMqttBroker::clear() {
+    std::lock_guard<std::mutex> lk(mu_);
+    messages_.clear();
+    publishes_.store(0);
+    bytes_.store(0);
+}
+
+bool FakeMqttBroker::wait_publishes(uint64_t n, int timeout_ms) const {
+    auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (publishes_.load() < n) {
+        if (std::chrono::steady_clock::now() >= until) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+void FakeMqttBroker::send_all(int fd, const uint8_t* p, size_t n) {
+    while (n > 0) {
+        ssize_t w = ::send(fd, p, n, MSG_NOSIGNAL);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN) {
+                pollfd pfd{fd, POLLOUT, 0};
+                ::poll(&pfd, 1, 100);
+                continue;
+            }
+            return;
+        }
+        p += w;
+        n -= static_cast<size_t>(w);
+    }
+}
+
+void FakeMqttBroker::run() {
+    std::vector<Conn> conns;
+    std::vector<pollfd> pfds;
+    auto close_all = [&] {
+        for (Conn& c : conns) ::close(c.fd);
+        conns.clear();
+        clients_.store(0);
+    };
+
+    while (running_.load()) {
+        pfds.clear();
+        pfds.push_back({listen_fd_, POLLIN, 0});
+        pfds.push_back({wake_[0], POLLIN, 0});
+        for (const Conn& c : conns) pfds.push_back({c.fd, POLLIN, 0});
+        if (::poll(pfds.data(), pfds.size(), 100) < 0 && errno != EINTR) break;
+
+        if (pfds[1].revents & POLLIN) {
+            char buf[64];
+            while (::read(wake_[0], buf, sizeof(buf)) > 0) {}
+        }
+        if (drop_.load()) {
+            close_all();
+            drop_.store(false);
+            continue;
+        }
+
+        // Existing connections first: pfds[2 + i] matches conns[i]; closed ones are erased afterwards
+        // so forwarding can still reach every subscriber meanwhile
+        bool any_closed = false;
+        for (size_t i = 0; i < conns.size(); ++i) {
+            Conn& c = conns[i];
+            bool alive = c.fd >= 0;
+            if (alive && (pfds[2 + i].revents & (POLLIN | POLLHUP | POLLERR))) {
+                uint8_t buf[64 * 1024];
+                ssize_t r = ::recv(c.fd, buf, sizeof(buf), MSG_DONTWAIT);
+                if (r > 0) {
+                    c.rx.append(reinterpret_cast<const char*>(buf), static_cast<size_t>(r));
+                    alive = handle(c, conns);
+                } else if (r == 0 || (errno != EAGAIN && errno != EINTR)) {
+                    alive = false;
+                }
+            }
+            if (!alive && c.fd >= 0) {
+                ::close(c.fd);
+                c.fd = -1;
+                any_closed = true;
+            }
+        }
+        if (any_closed) {
+            std::vector<Conn> keep;
+            for (Conn& c : conns) {
+                if (c.fd >= 0) keep.push_back(std::move(c));
+            }
+            conns.swap(keep);
+        }
+
+        if (pfds[0].revents & POLLIN) {
+            int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd >= 0) conns.push_back({fd, {}, {}});
+        }
+        clients_.store(static_cast<uint32_t>(conns.size()));
+    }
+    close_all();
+}
+
+bool FakeMqttBroker::topic_matches(const std::string& filter, const std::string& topic) {
+    size_t f = 0, t = 0;
+    for (;;) {
+        const size_t fe = filter.find('/', f);
+        const size_t te = t > topic.size() ? std::string::npos : topic.find('/', t);
+        const std::string fl = filter.substr(f, fe == std::string::npos ? std::string::npos : fe - f);
+        if (fl == "#") return true; // also matches the parent level ("a/#" matches "a")
+        if (t > topic.size()) return false; // topic has fewer levels than the filter
+        const std::string tl = topic.substr(t, te == std::string::npos ? std::string::npos : te - t);
+        if (fl != "+" && fl != tl) return false;
+        if (fe == std::string::npos) return te == std::string::npos;
+        f = fe + 1;
+        t = te == std::string::npos ? topic.size() + 1 : te + 1;
+    }
+}
+
+void FakeMqttBroker::forward(std::vector<Conn>& all, const uint8_t* topic, uint32_t tlen,
+                             const uint8_t* payload, uint32_t plen) {
+    const std::string name(reinterpret_cast<const char*>(topic), tlen);
+    std::string frame;
+    for (Conn& s : all) {
+        if (s.fd < 0) continue;
+        bool match = false;
+        for (const std::string& f : s.filters) match = match || topic_matches(f, name);
+        if (!match) continue;
+        if (frame.empty()) {
+            uint32_t rl = 2u + tlen + plen;
+            frame.push_back(static_cast<char>(0x30));
+            do {
+                uint8_t b = rl & 0x7Fu;
+                rl >>= 7;
+                frame.push_back(static_cast<char>(rl ? (b | 0x80u) : b));
+            } while (rl);
+            frame.push_back(static_cast<char>(tlen >> 8));
+            frame.push_back(static_cast<char>(tlen & 0xFFu));
+            frame.append(name);
+            frame.append(reinterpret_cast<const char*>(payload), plen);
+        }
+        forwarded_.fetch_add(1); // counted first so a subscriber that got the frame sees the count
+        send_all(s.fd, reinterpret_cast<const uint8_t*>(frame.data()), frame.size());
+    }
+}
+
+bool FakeMqttBroker::handle(Conn& c, std::vector<Conn>& all) {
+    size_t off = 0;
+    const std::string& rx = c.rx;
+    for (;;) {
+        if (rx.size() - off < 2) break;
+        uint32_t rl = 0, mult = 1;
+        size_t i = 1;
+        bool complete = false;
+        while (off + i < rx.size() && i <= 4) {
+            const uint8_t b = static_cast<uint8_t>(rx[off + i++]);
+            rl += (b & 0x7Fu) * mult;
+            mult <<= 7;
+            if ((b & 0x80u) == 0) {
+                complete = true;
+                break;
+            }
+        }
+        if (!complete) {
+            if (i > 4) return false;
+            break;
+        }
+        if (rx.size() - off < i + rl) break;
+        const uint8_t type = static_cast<uint8_t>(rx[off]);
+        const uint8_t* body = reinterpret_cast<const uint8_t*>(rx.data() + off + i);
+
+        switch (type & 0xF0u) {
+        case 0x10: { // CONNECT
+            const uint8_t rc = connack_rc_.load();
+            const uint8_t ack[4] = {0x20, 0x02, 0x00, rc};
+            send_all(c.fd, ack, sizeof(ack));
+            if (rc != 0) return false;
+            connects_.fetch_add(1);
+            break;
+        }
+        case 0x30: { // PUBLISH
+            if (rl < 2) return false;
+            const uint8_t qos = (type >> 1) & 0x03u;
+            const uint32_t tlen = (uint32_t(body[0]) << 8) | body[1];
+            const uint32_t vh = 2u + tlen + (qos ? 2u : 0u);
+            if (vh > rl) return false;
+            const int64_t arrival = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                        std::chrono::steady_clock::now().time_since_epoch()).count();
+            if (keep_.load()) {
+                Message m;
+                m.topic.assign(reinterpret_cast<const char*>(body + 2), tlen);
+                m.payload.assign(reinterpret_cast<const char*>(body + vh), rl - vh);
+                m.qos = qos;
+                m.retain = (type & 0x01u) != 0;
+                m.arrival_ns = arrival;
+                std::lock_guard<std::mutex> lk(mu_);
+                messages_.push_back(std::move(m));
+            }
+            bytes_.fetch_add(rl - vh);
+            publishes_.fetch_add(1);
+            if (qos && ack_.load()) {
+                const uint8_t ack[4] = {0x40, 0x02, body[2 + tlen], body[3 + tlen]};
+                send_all(c.fd, ack, sizeof(ack));
+            }
+            forward(all, body + 2, tlen, body + vh, rl - vh);
+            break;
+        }
+        case 0x80: { // SUBSCRIBE: [id][len topic qos]...
+            if (rl < 2) return false;
+            uint8_t ack[4 + 64] = {0x90, 0x02, body[0], body[1]};
+            uint32_t p = 2, granted = 0;
+            while (p + 3 <= rl && granted < 64) {
+                const uint32_t flen = (uint32_t(body[p]) << 8) | body[p + 1];
+                if (p + 2 + flen + 1 > rl) return false;
+                c.filters.emplace_back(reinterpret_cast<const char*>(body + p + 2), flen);
+                ack[4 + granted++] = 0x00; // granted QoS 0
+                p += 2 + flen + 1;
+            }
+            ack[1] = static_cast<uint8_t>(2 + granted);
+            send_all(c.fd, ack, 4 + granted);
+            subscribes_.fetch_add(1);
+            break;
+        }
+        case 0xC0: { // PINGREQ
+            static const uint8_t resp[2] = {0xD0, 0x00};
+            send_all(c.fd, resp, sizeof(resp));
+            pings_.fetch_add(1);
+            break;
+        }
+        case 0xE0: // DISCONNECT
+            return false;
+        default:
+            break;
+        }
+        off += i + rl;
+    }
+    c.rx.erase(0, off);
+    return true;
+}
+
+} // namespace testing
+} // namespace industrial
@@ -0,0 +1,108 @@
+/**
+ * @file FakeMqttBroker.hpp
+ * @brief In-process stand-in MQTT 3.1.1 broker for tests and benchmarks.
+ *
+ * Listens on 127.0.0.1 (ephemeral port by default) and serves every client from one poll() thread:
+ * - CONNECT -> CONNACK (return code configurable, to test refusals)
+ * - PUBLISH -> recorded with its arrival time; QoS 1 answered with PUBACK unless acks are switched off,
+ *   then forwarded at QoS 0 to every client whose subscription matches
+ * - SUBSCRIBE -> SUBACK granting QoS 0 (filters may use '+' and '#')
+ * - PINGREQ -> PINGRESP, DISCONNECT -> close
+ *
+ * @note:
+ * - Test support only: uses the heap and a mutex freely.
+ * - drop_clients() closes every session (simulated broker crash); stop()/start() on the same port
+ *   simulates a restart.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace industrial {
+namespace testing {
+
+class FakeMqttBroker {
+public:
+    struct Message {
+        std::string topic;
+        std::string payload;
+        uint8_t qos{0};
+        bool retain{false};
+        int64_t arrival_ns{0}; // steady_clock, taken when the packet was parsed
+    };
+
+    FakeMqttBroker() = default;
+    ~FakeMqttBroker() { stop(); }
+    FakeMqttBroker(const FakeMqttBroker&) = delete;
+    FakeMqttBroker& operator=(const FakeMqttBroker&) = delete;
+
+    // port 0 picks an ephemeral port; restarting with port() reuses the previous one.
+    bool start(uint16_t port = 0);
+    void stop();
+    void drop_clients();
+
+    uint16_t port() const { return port_; }
+    std::string uri() const { return "tcp://127.0.0.1:" + std::to_string(port_); }
+
+    void set_connack_code(uint8_t rc) { connack_rc_.store(rc); }
+    void set_ack(bool on) { ack_.store(on); }
+    void set_keep_messages(bool on) { keep_.store(on); } // off: count only (benchmarks)
+
+    uint64_t connects() const { return connects_.load(); }
+    uint64_t publishes() const { return publishes_.load(); }
+    uint64_t bytes() const { return bytes_.load(); } // PUBLISH payload bytes
+    uint64_t pings() const { return pings_.load(); }
+    uint64_t subscribes() const { return subscribes_.load(); }
+    uint64_t forwarded() const { return forwarded_.load(); } // PUBLISHes sent to subscribers
+    uint32_t clients() const { return clients_.load(); }
+
+    std::vector<Message> messages() const;
+    void clear();
+    // Wait until at least n PUBLISHes arrived; false on timeout.
+    bool wait_publishes(uint64_t n, int timeout_ms) const;
+
+    // MQTT topic filter matching with '+' (one level) and '#' (rest, last level only).
+    static bool topic_matches(const std::string& filter, const std::string& topic);
+
+private:
+    struct Conn {
+        int fd;
+        std::string rx;
+        std::vector<std::string> filters;
+    };
+
+    void run();
+    bool handle(Conn& c, std::vector<Conn>& all); // false: close the connection
+    void forward(std::vector<Conn>& all, const uint8_t* topic, uint32_t tlen, const uint8_t* payload, uint32_t plen);
+    void send_all(int fd, const uint8_t* p, size_t n);
+
+    int listen_fd_{-1};
+    int wake_[2]{-1, -1}; // self-pipe to interrupt poll()
+    uint16_t port_{0};
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> drop_{false};
+
+    std::atomic<uint8_t> connack_rc_{0};
+    std::atomic<bool> ack_{true};
+    std::atomic<bool> keep_{true};
+
+    std::atomic<uint64_t> connects_{0};
+    std::atomic<uint64_t> publishes_{0};
+    std::atomic<uint64_t> bytes_{0};
+    std::atomic<uint64_t> pings_{0};
+    std::atomic<uint64_t> subscribes_{0};
+    std::atomic<uint64_t> forwarded_{0};
+    std::atomic<uint32_t> clients_{0};
+
+    mutable std::mutex mu_;
+    std::vector<Message> messages_;
+};
+
+} // namespace testing
+} // namespace industrial
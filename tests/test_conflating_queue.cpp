@@ -0,0 +1,177 @@
+/**
+ * @file test_conflating_queue.cpp
+ * @brief Unit tests for ConflatingQueue and the conflating lane of SinkFanOut.
+ *
+ * Tests verify:
+ * - One pending entry per topic: a newer push displaces the older handle and keeps the topic's place
+ * - Topics drain round-robin; Full once the topic table is exhausted
+ * - Concurrent producer/consumer: per-topic values only move forward, pushed == popped + conflated
+ * - SinkFanOut with a slow sink: Lane::Latest delivers the newest value of every topic, counts the
+ *   rest as conflated and returns every buffer to the pool; FIFO submissions are untouched
+ */
+
+#include "industrial/ConflatingQueue.hpp"
+#include "industrial/PayloadPool.hpp"
+#include "industrial/SinkFanOut.hpp"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Queue = industrial::ConflatingQueue<uint32_t, 4>;
+using Push = Queue::Push;
+
+static const std::string kA = "plant/a";
+static const std::string kB = "plant/b";
+static const std::string kC = "plant/c";
+
+void test_conflation() {
+    Queue q;
+    uint32_t old = 0;
+    assert(q.push(kA, 1, false, old) == Push::Queued);
+    assert(q.push(kB, 2, true, old) == Push::Queued);
+    assert(q.push(kA, 3, false, old) == Push::Conflated && old == 1);
+    assert(q.push(kA, 4, false, old) == Push::Conflated && old == 3);
+    assert(q.pending() == 2 && q.topics() == 2 && q.conflated() == 2);
+
+    Queue::Entry e{};
+    assert(q.pop(e) && e.handle == 4 && e.topic == kA && !e.binary); // A kept its place, newest value
+    assert(q.pop(e) && e.handle == 2 && e.topic == kB && e.binary);
+    assert(!q.pop(e));
+
+    // A drained topic queues again at the back
+    assert(q.push(kB, 5, true, old) == Push::Queued);
+    assert(q.push(kA, 6, false, old) == Push::Queued);
+    assert(q.pop(e) && e.handle == 5 && q.pop(e) && e.handle == 6);
+
+    // Same text at another address is another topic; the table holds 4
+    const std::string a_copy = kA;
+    const std::string d = "plant/d";
+    assert(q.push(a_copy, 7, false, old) == Push::Queued);
+    assert(q.push(d, 8, false, old) == Push::Queued);
+    assert(q.topics() == 4);
+    assert(q.push(kC, 9, false, old) == Push::Full);
+    assert(q.push(kA, 10, false, old) == Push::Queued); // known topics still work
+    std::cout << "✓ test_conflation passed\n";
+}
+
+void test_fair_drain() {
+    Queue q;
+    uint32_t old = 0;
+    Queue::Entry e{};
+    // A publishes 10x as often as B; B still gets every other turn
+    std::vector<std::string> order;
+    for (uint32_t round = 0; round < 5; ++round) {
+        for (uint32_t i = 0; i < 10; ++i) q.push(kA, round * 100 + i, false, old);
+        q.push(kB, round, false, old);
+        while (q.pop(e)) order.push_back(std::string(e.topic));
+    }
+    for (size_t i = 0; i < order.size(); i += 2) assert(order[i] == kA && order[i + 1] == kB);
+    assert(order.size() == 10 && q.conflated() == 45);
+    std::cout << "✓ test_fair_drain passed\n";
+}
+
+void test_concurrent() {
+    static industrial::ConflatingQueue<uint32_t, 64> q;
+    static std::string topics[8];
+    for (int i = 0; i < 8; ++i) topics[i] = "t/" + std::to_string(i);
+    constexpr uint32_t kPushes = 400000;
+    std::atomic<bool> done{false};
+    uint64_t popped = 0;
+    std::thread consumer([&] {
+        uint32_t last[8] = {};
+        decltype(q)::Entry e{};
+        for (;;) {
+            if (!q.pop(e)) {
+                if (done.load()) {
+                    if (!q.pop(e)) break;
+                } else {
+                    continue;
+                }
+            }
+            const int t = e.topic.back() - '0';
+            assert(e.topic == topics[t]);
+            assert(e.handle > last[t] && e.handle % 8 == (uint32_t)t); // never stale, never torn
+            last[t] = e.handle;
+            ++popped;
+        }
+    });
+    uint32_t old = 0;
+    for (uint32_t i = 8; i < kPushes + 8; ++i) {
+        if (q.push(topics[i % 8], i, false, old) == decltype(q)::Push::Conflated) assert(old < i && old % 8 == i % 8);
+    }
+    done.store(true);
+    consumer.join();
+    assert(popped + q.conflated() == kPushes);
+    assert(popped >= 8);
+    std::cout << "✓ test_concurrent passed (" << popped << " popped, " << q.conflated() << " conflated)\n";
+}
+
+// Sink that takes 2 ms per write, far slower than the submitter
+struct SlowSink {
+    std::mutex mu;
+    std::map<std::string, std::string> last;
+    std::vector<std::string> log;
+
+    bool write(const industrial::Frame& f) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        std::lock_guard<std::mutex> lk(mu);
+        last[std::string(f.topic)] = std::string((const char*)f.data, f.len);
+        log.push_back(std::string(f.topic));
+        return true;
+    }
+    void idle() {}
+    static const char* name() { return "slow"; }
+};
+
+void test_fanout_lane() {
+    using Pool = industrial::PayloadPool<64, 32>;
+    static Pool pool;
+    SlowSink sink;
+    using FanOut = industrial::SinkFanOut<Pool, SlowSink>;
+    FanOut out(pool, sink);
+    out.enable(0, true);
+    out.start();
+
+    auto submit = [&](const std::string& topic, int v, bool conflate) {
+        Pool::Handle h;
+        while ((h = pool.acquire()) == Pool::kInvalid) std::this_thread::yield();
+        const std::string s = std::to_string(v);
+        std::memcpy(pool.data(h), s.data(), s.size());
+        pool.set_len(h, (uint32_t)s.size());
+        out.submit(h, topic, false, conflate ? FanOut::Lane::Latest : FanOut::Lane::Bulk);
+    };
+    const std::string* topics[3] = {&kA, &kB, &kC};
+    for (int i = 0; i < 300; ++i) submit(*topics[i % 3], i, true);
+    // 300 values arrive within ~1 ms: without conflation the pool (64 buffers) would run dry
+    assert(pool.in_use() <= 3 + 1);
+    const std::string fifo = "plant/events";
+    for (int i = 0; i < 5; ++i) submit(fifo, 1000 + i, false);
+    out.stop();
+
+    const auto st = out.stats(0);
+    assert(st.frames + st.conflated == 305 && st.dropped == 0 && st.depth == 0);
+    assert(st.conflated >= 280);
+    assert(sink.last[kA] == "297" && sink.last[kB] == "298" && sink.last[kC] == "299"); // freshest got through
+    assert(sink.last[fifo] == "1004");
+    size_t events = 0;
+    for (const auto& t : sink.log) events += t == fifo ? 1 : 0;
+    assert(events == 5); // the FIFO lane is never conflated
+    assert(pool.in_use() == 0);
+    std::cout << "✓ test_fanout_lane passed (" << st.frames << " written, " << st.conflated << " conflated)\n";
+}
+
+int main() {
+    test_conflation();
+    test_fair_drain();
+    test_concurrent();
+    test_fanout_lane();
+    std::cout << "✓ All tests passed!\n";
+    return 0;
+}
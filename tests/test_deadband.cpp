@@ -0,0 +1,105 @@
+/**
+ * @file test_deadband.cpp
+ * @brief Unit tests for the report-by-exception DeadbandFilter.
+ *
+ * Tests verify:
+ * - First sample passes; small moves are suppressed and counted
+ * - Absolute and percentage deadbands per channel, with drift accumulating against the last report
+ * - Max-silence heartbeat forces a report of an unchanged value
+ * - Zero deadbands suppress only exact repeats
+ */
+
+#include "industrial/Deadband.hpp"
+#include <cassert>
+#include <chrono>
+#include <iostream>
+
+using industrial::DeadbandFilter;
+using industrial::TimePoint;
+using std::chrono::milliseconds;
+
+void test_absolute_and_drift() {
+    DeadbandFilter<2> f;
+    f.set_channel(0, 0.5f, 0.0f);
+    f.set_channel(1, 2.0f, 0.0f);
+    TimePoint t{};
+    float v[2] = {20.0f, 100.0f};
+    assert(f.update(v, t)); // first sample always passes
+
+    v[0] = 20.3f;
+    assert(!f.update(v, t));
+    v[0] = 20.45f;
+    assert(!f.update(v, t));
+    v[0] = 20.6f; // 0.6 from the last report, although each step was small
+    assert(f.update(v, t));
+
+    v[1] = 101.5f;
+    assert(!f.update(v, t));
+    v[1] = 97.9f; // channel 1 alone moving is enough
+    assert(f.update(v, t));
+
+    assert(f.passed() == 3);
+    assert(f.suppressed() == 3);
+    assert(f.heartbeats() == 0);
+
+    std::cout << "✓ test_absolute_and_drift passed\n";
+}
+
+void test_percentage() {
+    DeadbandFilter<1> f;
+    f.set_channel(0, 0.0f, 1.0f); // 1% of the last reported value
+    TimePoint t{};
+    float v[1] = {1400.0f};
+    assert(f.update(v, t));
+    v[0] = 1413.0f;
+    assert(!f.update(v, t));
+    v[0] = 1385.0f; // 15 > 14
+    assert(f.update(v, t));
+    v[0] = -10.0f;
+    assert(f.update(v, t));
+    v[0] = -10.05f; // 1% of |-10| is 0.1
+    assert(!f.update(v, t));
+
+    std::cout << "✓ test_percentage passed\n";
+}
+
+void test_heartbeat() {
+    DeadbandFilter<1> f;
+    f.set_channel(0, 1.0f, 0.0f);
+    f.set_max_silence(milliseconds(1000));
+    TimePoint t{};
+    float v[1] = {5.0f};
+    assert(f.update(v, t));
+    assert(!f.update(v, t + milliseconds(500)));
+    assert(!f.update(v, t + milliseconds(999)));
+    assert(f.update(v, t + milliseconds(1000))); // silence expired
+    assert(!f.update(v, t + milliseconds(1500)));
+    assert(f.update(v, t + milliseconds(2000)));
+    assert(f.heartbeats() == 2);
+    assert(f.passed() == 3 && f.suppressed() == 3);
+
+    std::cout << "✓ test_heartbeat passed\n";
+}
+
+void test_zero_deadband_and_reset() {
+    DeadbandFilter<1> f;
+    TimePoint t{};
+    float v[1] = {1.0f};
+    assert(f.update(v, t));
+    assert(!f.update(v, t)); // exact repeat
+    v[0] = 1.0001f;
+    assert(f.update(v, t));
+    f.reset();
+    assert(f.update(v, t)); // unprimed again
+
+    std::cout << "✓ test_zero_deadband_and_reset passed\n";
+}
+
+int main() {
+    test_absolute_and_drift();
+    test_percentage();
+    test_heartbeat();
+    test_zero_deadband_and_reset();
+    std::cout << "✓ All tests passed!\n";
+    return 0;
+}
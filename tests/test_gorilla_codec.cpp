@@ -0,0 +1,154 @@
+/**
+ * @file test_gorilla_codec.cpp
+ * @brief Unit tests for the Gorilla-style SensorSample block codec.
+ *
+ * Tests verify:
+ * - Bit-exact round trip for regular, jittery and constant streams
+ * - Compression on slowly varying data
+ * - Large timestamp jumps (64-bit fallback)
+ * - Overflow detection for undersized buffers and rejection of bad headers
+ * - Rejection of a block that reuses a float window before one was set
+ */
+
+#include "industrial/GorillaCodec.hpp"
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+using industrial::SensorSample;
+using industrial::TimePoint;
+
+static TimePoint at_ns(long long ns) {
+    return TimePoint(std::chrono::duration_cast<TimePoint::duration>(std::chrono::nanoseconds(ns)));
+}
+
+static bool same(const SensorSample& a, const SensorSample& b) {
+    return a.ts == b.ts &&
+           std::memcmp(&a.temperature_c, &b.temperature_c, sizeof(float)) == 0 &&
+           std::memcmp(&a.pressure_kpa, &b.pressure_kpa, sizeof(float)) == 0;
+}
+
+static void roundtrip(const SensorSample* in, size_t n, size_t* encoded_bytes = nullptr) {
+    static uint8_t buf[industrial::max_block_bytes(1024)];
+    static SensorSample out[1024];
+    size_t bytes = industrial::gorilla_encode(in, n, buf, sizeof(buf));
+    assert(bytes > 0);
+    size_t got = industrial::gorilla_decode(buf, bytes, out, 1024);
+    assert(got == n);
+    for (size_t i = 0; i < n; ++i) {
+        assert(same(in[i], out[i]));
+    }
+    if (encoded_bytes) *encoded_bytes = bytes;
+}
+
+void test_regular_stream() {
+    static SensorSample s[512];
+    long long ts = 123456789000LL;
+    for (int i = 0; i < 512; ++i) {
+        s[i].ts = at_ns(ts);
+        s[i].temperature_c = 25.0f + 0.01f * (i / 8);
+        s[i].pressure_kpa = 1400.0f + std::sin(i * 0.01f);
+        ts += 50000000LL; // 50 ms, constant period
+    }
+    size_t bytes = 0;
+    roundtrip(s, 512, &bytes);
+    // 512 * 16 raw bytes; slowly varying data must compress well
+    assert(bytes < 512 * sizeof(SensorSample) / 2);
+
+    std::cout << "✓ test_regular_stream passed (" << bytes << " bytes for 512 samples)\n";
+}
+
+void test_jitter_and_noise() {
+    static SensorSample s[300];
+    long long ts = 1000;
+    unsigned seed = 12345;
+    for (int i = 0; i < 300; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        long long jitter = (long long)(seed % 2000001u) - 1000000; // +/- 1 ms
+        if (i % 97 == 0) jitter *= 5000;                            // occasional multi-second stall
+        s[i].ts = at_ns(ts + jitter);
+        s[i].temperature_c = (float)(seed % 1000) - 500.0f;
+        s[i].pressure_kpa = (i % 50 == 0) ? -0.0f : 1400.0f + (float)(seed % 37) * 0.125f;
+        ts += 50000000LL;
+    }
+    roundtrip(s, 300);
+
+    std::cout << "✓ test_jitter_and_noise passed\n";
+}
+
+void test_constant_and_extremes() {
+    SensorSample s[6];
+    for (int i = 0; i < 6; ++i) {
+        s[i].ts = at_ns(10);
+        s[i].temperature_c = 1.0f;
+        s[i].pressure_kpa = 2.0f;
+    }
+    s[3].ts = at_ns(INT64_MAX / 2);            // huge jump forward
+    s[4].ts = at_ns(-1000);                    // and back past zero
+    s[5].temperature_c = std::nanf("");
+    s[5].pressure_kpa = 3.4e38f;
+    roundtrip(s, 6);
+    roundtrip(s, 1);
+
+    std::cout << "✓ test_constant_and_extremes passed\n";
+}
+
+void test_overflow_and_bad_header() {
+    SensorSample s[64]{};
+    for (int i = 0; i < 64; ++i) {
+        s[i].ts = at_ns(i * 7919LL * 1000);
+        s[i].temperature_c = (float)i * 3.7f;
+        s[i].pressure_kpa = (float)(i * i);
+    }
+    uint8_t small[40];
+    size_t bytes = industrial::gorilla_encode(s, 64, small, sizeof(small));
+    assert(bytes == 0);
+
+    uint8_t buf[industrial::max_block_bytes(64)];
+    bytes = industrial::gorilla_encode(s, 64, buf, sizeof(buf));
+    assert(bytes > 0);
+
+    SensorSample out[64];
+    size_t got = industrial::gorilla_decode(buf, bytes / 2, out, 64); // truncated block
+    assert(got == 0);
+    got = industrial::gorilla_decode(buf, bytes, out, 10);            // caller buffer too small
+    assert(got == 0);
+    buf[0] = 0x7F;                                                    // unknown version
+    got = industrial::gorilla_decode(buf, bytes, out, 64);
+    assert(got == 0);
+
+    std::cout << "✓ test_overflow_and_bad_header passed\n";
+}
+
+void test_reuse_before_window() {
+    // Two samples: an all-zero first sample, then dod '0' and a temperature coded '10' (reuse the
+    // previous window) although no window exists yet
+    uint8_t buf[industrial::kGorillaHeaderBytes + 16 + 8]{};
+    buf[0] = industrial::kGorillaVersion;
+    buf[1] = 2;
+    buf[industrial::kGorillaHeaderBytes + 16] = 0x40; // bits 0 1 0
+    SensorSample out[2];
+    assert(industrial::gorilla_decode(buf, sizeof(buf), out, 2) == 0);
+
+    industrial::GorillaDecoder dec(buf, sizeof(buf));
+    SensorSample s;
+    assert(dec.next(s));
+    assert(!dec.next(s));
+
+    std::cout << "✓ test_reuse_before_window passed\n";
+}
+
+int main() {
+    std::cout << "Running GorillaCodec tests...\n\n";
+
+    test_regular_stream();
+    test_jitter_and_noise();
+    test_constant_and_extremes();
+    test_overflow_and_bad_header();
+    test_reuse_before_window();
+
+    std::cout << "\n✓ All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,206 @@
+/**
+ * @file test_influx_sink.cpp
+ * @brief Unit tests for line-protocol formatting and the batched InfluxSink against a stand-in listener.
+ *
+ * Tests verify:
+ * - format_fixed() agrees with "%.3f"; golden lines with escaping and integer ns timestamps; NaN refused
+ * - TCP: size- and age-triggered batches arrive complete and in order
+ * - HTTP: keep-alive POSTs to the configured target, one request per batch, "Connection: close" honored
+ * - HTTP 4xx drops the batch; 5xx and a server restart keep it and deliver it later without loss
+ * - close() with the server down counts the unsent batch as dropped
+ */
+
+#include "industrial/InfluxSink.hpp"
+#include "industrial/LineProtocol.hpp"
+#include "support/FakeLineServer.hpp"
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+
+using industrial::Frame;
+using industrial::InfluxField;
+using industrial::InfluxSink;
+using industrial::testing::FakeLineServer;
+using std::chrono::milliseconds;
+
+static std::string line(int i) {
+    char buf[128];
+    const InfluxField f[2] = {{"temperature", 20.0f + (float)i * 0.125f}, {"pressure", 1400.5f}};
+    size_t n = industrial::influx_line(buf, sizeof(buf), "sensor_sim,host=gw1", f, 2, 1700000000000000000LL + i);
+    assert(n > 0);
+    return std::string(buf, n);
+}
+
+static bool write_line(InfluxSink& sink, const std::string& l) {
+    return sink.write(Frame{"", (const uint8_t*)l.data(), l.size(), false});
+}
+
+void test_formatting() {
+    char a[64], b[64];
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-100000.0f, 100000.0f);
+    for (int i = 0; i < 200000; ++i) {
+        const float v = i < 100 ? (float)(i - 50) * 0.01f : dist(rng);
+        const double scaled = (double)v * 1000.0;
+        if (std::fabs(scaled - std::floor(scaled)) == 0.5) continue; // ties: printf rounds half to even
+        size_t n = industrial::format_fixed(a, sizeof(a), v, 3);
+        int m = std::snprintf(b, sizeof(b), "%.3f", (double)v);
+        if (std::strcmp(b, "-0.000") == 0) std::strcpy(b, "0.000"), m = 5;
+        assert(n == (size_t)m && std::memcmp(a, b, n) == 0);
+    }
+    assert(industrial::format_fixed(a, sizeof(a), 12.5, 0) == 2 && std::memcmp(a, "13", 2) == 0);
+    assert(industrial::format_fixed(a, sizeof(a), NAN, 3) == 0);
+    assert(industrial::format_fixed(a, sizeof(a), INFINITY, 3) == 0);
+    assert(industrial::format_fixed(a, 4, 123.25, 3) == 0);
+
+    assert(line(1) == "sensor_sim,host=gw1 temperature=20.125,pressure=1400.500 1700000000000000001\n");
+    char buf[64];
+    const InfluxField bad[1] = {{"t", NAN}};
+    assert(industrial::influx_line(buf, sizeof(buf), "m", bad, 1, 1) == 0);
+    const InfluxField one[1] = {{"t", 1.0f}};
+    assert(industrial::influx_line(buf, 10, "m", one, 1, 1234567890) == 0); // too small
+
+    std::string esc;
+    industrial::influx_escape("line 1,a", false, esc);
+    esc += ',';
+    industrial::influx_escape("site", true, esc);
+    esc += '=';
+    industrial::influx_escape("a=b c", true, esc);
+    assert(esc == "line\\ 1\\,a,site=a\\=b\\ c");
+    std::cout << "✓ test_formatting passed\n";
+}
+
+void test_tcp_batches() {
+    FakeLineServer server(FakeLineServer::Mode::Tcp);
+    assert(server.start());
+    InfluxSink sink;
+    assert(sink.open(server.url()));
+    assert(sink.connected());
+    const size_t len = line(0).size();
+    sink.set_flush(10 * len, milliseconds(30));
+
+    for (int i = 0; i < 95; ++i) assert(write_line(sink, line(i)));
+    assert(sink.batches() == 9 && sink.buffered_bytes() == 5 * len); // size-triggered batches of 10 lines
+    sink.idle();
+    assert(sink.batches() == 9); // the tail is not old enough yet
+    std::this_thread::sleep_for(milliseconds(40));
+    sink.idle();
+    assert(sink.batches() == 10 && sink.buffered_bytes() == 0);
+
+    // A frame without its '\n' still becomes one line
+    std::string l = line(95);
+    l.pop_back();
+    assert(write_line(sink, l));
+    assert(sink.flush());
+
+    assert(server.wait_lines(96, 2000));
+    auto got = server.received();
+    for (int i = 0; i < 96; ++i) assert(got[i] + "\n" == line(i));
+    assert(sink.lines() == 96 && sink.dropped_lines() == 0 && sink.last_status() == 0);
+    assert(server.connects() == 1);
+    std::cout << "✓ test_tcp_batches passed\n";
+}
+
+void test_http_keepalive() {
+    FakeLineServer server(FakeLineServer::Mode::Http);
+    assert(server.start());
+    InfluxSink sink;
+    assert(sink.open(server.url()));
+    sink.set_flush(64 * 1024, milliseconds(1000));
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < 100; ++i) assert(write_line(sink, line(round * 100 + i)));
+        assert(sink.flush());
+        assert(sink.last_status() == 204);
+    }
+    assert(server.wait_lines(500, 2000));
+    assert(server.requests() == 5 && sink.batches() == 5);
+    assert(server.connects() == 1); // one persistent connection
+    assert(server.last_target() == "/write?db=test");
+
+    // Server asks to close after each response: the sink reconnects transparently
+    server.set_close_after_response(true);
+    for (int i = 0; i < 3; ++i) {
+        assert(write_line(sink, line(i)));
+        assert(sink.flush());
+    }
+    assert(server.wait_lines(503, 2000));
+    assert(sink.connects() == 3); // the first flush reused the open connection
+    std::cout << "✓ test_http_keepalive passed\n";
+}
+
+void test_http_errors_and_restart() {
+    FakeLineServer server(FakeLineServer::Mode::Http);
+    assert(server.start());
+    InfluxSink sink;
+    assert(sink.open(server.url()));
+
+    // 400: the server will never take this batch, so it is dropped
+    server.set_status(400);
+    for (int i = 0; i < 10; ++i) write_line(sink, line(i));
+    assert(!sink.flush());
+    assert(sink.last_status() == 400 && sink.dropped_lines() == 10 && sink.buffered_bytes() == 0);
+
+    // 503: kept and retried after the backoff
+    server.set_status(503);
+    for (int i = 0; i < 10; ++i) write_line(sink, line(i));
+    assert(!sink.flush());
+    assert(sink.buffered_bytes() > 0 && sink.send_failures() >= 1);
+    server.set_status(204);
+    assert(!sink.flush()); // still backing off
+    std::this_thread::sleep_for(milliseconds(industrial::kInfluxRetryMs + 50));
+    assert(sink.flush());
+    assert(server.wait_lines(10, 2000));
+
+    // Restart: the kept-alive connection is dead, the batch goes out on a fresh one
+    server.drop_clients();
+    for (int i = 0; i < 10; ++i) write_line(sink, line(i));
+    assert(sink.flush());
+    assert(server.wait_lines(20, 2000));
+    assert(sink.dropped_lines() == 10);
+
+    // Down at startup: open() succeeds, data waits for the server
+    const uint16_t port = server.port();
+    server.stop();
+    InfluxSink late;
+    assert(late.open("http://127.0.0.1:" + std::to_string(port) + "/write?db=test"));
+    assert(!late.connected());
+    write_line(late, line(0));
+    assert(!late.flush());
+    server.clear();
+    assert(server.start(port));
+    std::this_thread::sleep_for(milliseconds(industrial::kInfluxRetryMs + 50));
+    assert(late.flush());
+    assert(server.wait_lines(1, 2000));
+
+    assert(!sink.open("udp://x:1") && !sink.open("http://:80") && !sink.open("tcp://h:99999"));
+    std::cout << "✓ test_http_errors_and_restart passed\n";
+}
+
+void test_close_unreachable() {
+    FakeLineServer server(FakeLineServer::Mode::Tcp);
+    assert(server.start());
+    const std::string url = server.url();
+    server.stop(); // nothing listens on the port any more
+    InfluxSink sink;
+    assert(sink.open(url));
+    assert(!sink.connected());
+    for (int i = 0; i < 7; ++i) assert(write_line(sink, line(i)));
+    sink.close();
+    assert(sink.dropped_lines() == 7 && sink.buffered_bytes() == 0 && sink.lines() == 0);
+    std::cout << "✓ test_close_unreachable passed\n";
+}
+
+int main() {
+    test_formatting();
+    test_tcp_batches();
+    test_http_keepalive();
+    test_http_errors_and_restart();
+    test_close_unreachable();
+    std::cout << "✓ All tests passed!\n";
+    return 0;
+}
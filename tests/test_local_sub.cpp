@@ -0,0 +1,141 @@
+/**
+ * @file test_local_sub.cpp
+ * @brief Integration tests for the Unix domain socket subscription server behind a SinkFanOut.
+ *
+ * Tests verify:
+ * - Subscribe/unsubscribe acks, rejected filters
+ * - Each frame reaches exactly the clients whose filters match, with topic, payload and binary flag intact
+ * - A client that never reads loses frames (counted) without slowing down the others
+ * - Disconnected clients are forgotten
+ */
+
+#include "industrial/LocalSubServer.hpp"
+#include "industrial/PayloadPool.hpp"
+#include "industrial/SinkFanOut.hpp"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using industrial::LocalSubClient;
+using industrial::LocalSubServer;
+using Pool = industrial::PayloadPool<industrial::kPayloadPoolSlots, industrial::kPayloadSlotBytes>;
+using FanOut = industrial::SinkFanOut<Pool, LocalSubServer>;
+using Kind = LocalSubClient::Kind;
+
+static Pool pool;
+static const std::string kTemp1 = "plant/line1/temp";
+static const std::string kTemp2 = "plant/line2/temp";
+static const std::string kPress1 = "plant/line1/press";
+static const std::string kOther = "other/x";
+
+static std::string socket_path() { return "/tmp/test_local_sub_" + std::to_string(::getpid()) + ".sock"; }
+
+static void submit(FanOut& out, const std::string& topic, const char* payload, bool binary = false) {
+    Pool::Handle h;
+    while ((h = pool.acquire()) == Pool::kInvalid) std::this_thread::yield();
+    const size_t n = std::strlen(payload);
+    std::memcpy(pool.data(h), payload, n);
+    pool.set_len(h, (uint32_t)n);
+    out.submit(h, topic, binary);
+}
+
+static bool expect(LocalSubClient& c, const std::string& topic, const char* payload, bool binary = false) {
+    LocalSubClient::Message m = c.recv(1000);
+    return m.kind == Kind::Data && m.topic == topic && m.binary == binary && m.len == std::strlen(payload) &&
+           std::memcmp(m.data, payload, m.len) == 0;
+}
+
+void test_matching_delivery() {
+    const std::string path = socket_path();
+    LocalSubServer server;
+    assert(server.open(path));
+    FanOut out(pool, server);
+    out.enable(0, true);
+    out.start();
+
+    LocalSubClient a, b, c;
+    assert(a.connect(path) && b.connect(path) && c.connect(path));
+    assert(a.subscribe("plant/+/temp"));
+    assert(b.subscribe("plant/line1/#"));
+    assert(c.subscribe("other/#"));
+    assert(!c.subscribe("bad/#/filter")); // rejected with a nack
+
+    submit(out, kTemp1, "21.5");
+    submit(out, kTemp2, "22.0");
+    submit(out, kPress1, "\x01\x02", true);
+    submit(out, kOther, "o");
+
+    assert(expect(a, kTemp1, "21.5"));
+    assert(expect(a, kTemp2, "22.0"));
+    assert(expect(b, kTemp1, "21.5"));
+    assert(expect(b, kPress1, "\x01\x02", true));
+    assert(expect(c, kOther, "o"));
+    assert(a.recv(50).kind == Kind::None && b.recv(50).kind == Kind::None && c.recv(50).kind == Kind::None);
+
+    // Unsubscribe takes effect at once; a closed client is dropped with its filters
+    assert(a.unsubscribe("plant/+/temp"));
+    assert(!a.unsubscribe("plant/+/temp"));
+    c.close();
+    submit(out, kTemp1, "23.0");
+    submit(out, kOther, "o2");
+    assert(expect(b, kTemp1, "23.0"));
+    assert(a.recv(50).kind == Kind::None);
+
+    out.stop();
+    server.service();
+    assert(server.clients() == 2);
+    assert(server.delivered() == 6);
+    assert(out.stats(0).frames == 6 && out.stats(0).failed == 0);
+    server.close();
+    assert(::access(path.c_str(), F_OK) != 0); // socket file removed
+    std::cout << "✓ test_matching_delivery passed\n";
+}
+
+void test_slow_client_isolated() {
+    const std::string path = socket_path();
+    LocalSubServer server;
+    assert(server.open(path));
+    FanOut out(pool, server);
+    out.enable(0, true);
+    out.start();
+
+    LocalSubClient fast, slow;
+    assert(fast.connect(path) && slow.connect(path));
+    assert(fast.subscribe("plant/#"));
+    assert(slow.subscribe("#")); // never reads again
+
+    std::atomic<int> received{0};
+    std::thread reader([&] {
+        for (;;) {
+            LocalSubClient::Message m = fast.recv(500);
+            if (m.kind == Kind::None) break;
+            assert(m.kind == Kind::Data && m.topic == kTemp1 && m.len == 10);
+            received.fetch_add(1);
+        }
+    });
+
+    const int kFrames = 5000;
+    for (int i = 0; i < kFrames; ++i) {
+        submit(out, kTemp1, "0123456789");
+        if (i % 64 == 63) // pace to the fast reader so only the slow one can fall behind
+            while (received.load() < i - 64) std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    reader.join();
+    out.stop();
+    assert(received.load() == kFrames);
+    assert(server.dropped() > 0);
+    assert(server.delivered() + server.dropped() == 2u * kFrames);
+    std::cout << "✓ test_slow_client_isolated passed (slow client dropped " << server.dropped() << ")\n";
+}
+
+int main() {
+    test_matching_delivery();
+    test_slow_client_isolated();
+    std::cout << "✓ All tests passed!\n";
+    return 0;
+}
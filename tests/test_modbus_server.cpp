@@ -0,0 +1,220 @@
+/**
+ * @file test_modbus_server.cpp
+ * @brief Unit tests for the Modbus TCP server (FC 3/4 over the latest-value snapshot).
+ *
+ * Tests verify:
+ * - Holding and input tables map channels with their own scales; rounding, clamping, NaN, counter
+ * - Exception responses 01/02/03 echo the transaction and unit ids
+ * - Pipelined requests in one segment are all answered, in order
+ * - A non-Modbus frame closes the connection; many concurrent clients see consistent snapshots
+ */
+
+#include "industrial/ModbusServer.hpp"
+#include <arpa/inet.h>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using industrial::ModbusServer;
+
+namespace {
+
+// Blocking Modbus TCP test client
+struct Client {
+    int fd{-1};
+    uint16_t tid{0};
+
+    explicit Client(uint16_t port) {
+        fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in sa{};
+        sa.sin_family = AF_INET;
+        sa.sin_port = htons(port);
+        sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        assert(::connect(fd, reinterpret_cast<sockaddr*>(&sa), sizeof(sa)) == 0);
+        timeval tv{2, 0};
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    }
+    ~Client() { ::close(fd); }
+
+    static size_t frame(uint8_t* out, uint16_t tid, uint8_t unit, uint8_t fc, uint16_t start, uint16_t qty) {
+        const uint8_t f[12] = {(uint8_t)(tid >> 8), (uint8_t)tid, 0, 0, 0, 6, unit, fc,
+                               (uint8_t)(start >> 8), (uint8_t)start, (uint8_t)(qty >> 8), (uint8_t)qty};
+        std::memcpy(out, f, sizeof(f));
+        return sizeof(f);
+    }
+
+    bool send_raw(const uint8_t* p, size_t n) { return ::send(fd, p, n, MSG_NOSIGNAL) == (ssize_t)n; }
+
+    // Reads one response ADU; returns its PDU (function code first), empty on EOF/timeout.
+    std::vector<uint8_t> read_response(uint16_t* rtid = nullptr, uint8_t* unit = nullptr) {
+        uint8_t hdr[7];
+        if (!read_exact(hdr, 7)) return {};
+        const uint16_t len = (uint16_t)((hdr[4] << 8) | hdr[5]);
+        std::vector<uint8_t> pdu(len - 1);
+        if (!read_exact(pdu.data(), pdu.size())) return {};
+        if (rtid) *rtid = (uint16_t)((hdr[0] << 8) | hdr[1]);
+        if (unit) *unit = hdr[6];
+        return pdu;
+    }
+
+    // FC 3/4 round trip; registers as signed values.
+    std::vector<int16_t> read(uint8_t fc, uint16_t start, uint16_t qty) {
+        uint8_t req[12];
+        const uint16_t t = ++tid;
+        send_raw(req, frame(req, t, 1, fc, start, qty));
+        uint16_t rt = 0;
+        auto pdu = read_response(&rt);
+        assert(rt == t && !pdu.empty() && pdu[0] == fc && pdu[1] == 2 * qty);
+        std::vector<int16_t> regs(qty);
+        for (uint16_t i = 0; i < qty; ++i) regs[i] = (int16_t)((pdu[2 + 2 * i] << 8) | pdu[3 + 2 * i]);
+        return regs;
+    }
+
+    bool read_exact(uint8_t* p, size_t n) {
+        while (n > 0) {
+            ssize_t r = ::recv(fd, p, n, 0);
+            if (r <= 0) return false;
+            p += r;
+            n -= (size_t)r;
+        }
+        return true;
+    }
+};
+
+} // namespace
+
+void test_register_map() {
+    ModbusServer server;
+    assert(server.open(0, "127.0.0.1"));
+    assert(server.map(ModbusServer::Table::Input, 0, 0, 10.0f));
+    assert(server.map(ModbusServer::Table::Input, 1, 1, 10.0f));
+    assert(server.map(ModbusServer::Table::Input, 2, 2, 1.0f));
+    assert(server.map_counter(ModbusServer::Table::Input, 10));
+    assert(server.map(ModbusServer::Table::Holding, 100, 0, 100.0f));
+    assert(!server.map(ModbusServer::Table::Input, (uint16_t)industrial::kModbusRegisters, 0, 1.0f));
+    assert(!server.map(ModbusServer::Table::Input, 0, industrial::kModbusChannels, 1.0f));
+    assert(server.start());
+
+    Client c(server.port());
+    auto regs = c.read(ModbusServer::kFcReadInput, 0, 11);
+    for (int16_t r : regs) assert(r == 0); // nothing published yet
+
+    const float v[3] = {23.456f, -1.25f, 1e6f};
+    server.update(v, 3);
+    regs = c.read(ModbusServer::kFcReadInput, 0, 11);
+    assert(regs[0] == 235 && regs[1] == -13 && regs[2] == 32767); // rounded, clamped
+    assert(regs[3] == 0 && regs[10] == 1);                        // unmapped, update counter
+    assert(c.read(ModbusServer::kFcReadHolding, 100, 1)[0] == 2346);
+    assert(c.read(ModbusServer::kFcReadHolding, 0, 1)[0] == 0); // tables are independent
+
+    const float bad[3] = {NAN, 0.0f, -1e6f};
+    server.update(bad, 3);
+    regs = c.read(ModbusServer::kFcReadInput, 0, 11);
+    assert((uint16_t)regs[0] == 0x8000 && regs[2] == -32767 && regs[10] == 2);
+    assert(server.updates() == 2);
+    assert(c.read(ModbusServer::kFcReadInput, (uint16_t)(industrial::kModbusRegisters - 125), 125).size() == 125);
+    std::cout << "✓ test_register_map passed\n";
+}
+
+void test_exceptions_and_pipelining() {
+    ModbusServer server;
+    assert(server.open(0, "127.0.0.1"));
+    assert(server.map(ModbusServer::Table::Holding, 0, 0, 1.0f));
+    assert(server.start());
+    Client c(server.port());
+
+    struct Case {
+        uint8_t fc;
+        uint16_t start, qty;
+        uint8_t ex;
+    } cases[] = {{6, 0, 1, ModbusServer::kExIllegalFunction},
+                 {ModbusServer::kFcReadHolding, (uint16_t)(industrial::kModbusRegisters - 1), 2,
+                  ModbusServer::kExIllegalAddress},
+                 {ModbusServer::kFcReadHolding, 0, 0, ModbusServer::kExIllegalValue},
+                 {ModbusServer::kFcReadInput, 0, 126, ModbusServer::kExIllegalValue}};
+    uint8_t req[12];
+    for (const Case& k : cases) {
+        c.send_raw(req, Client::frame(req, 0xBEEF, 0x11, k.fc, k.start, k.qty));
+        uint16_t tid = 0;
+        uint8_t unit = 0;
+        auto pdu = c.read_response(&tid, &unit);
+        assert(pdu.size() == 2 && pdu[0] == (k.fc | 0x80) && pdu[1] == k.ex);
+        assert(tid == 0xBEEF && unit == 0x11);
+    }
+    assert(server.exceptions() == 4);
+
+    // 20 requests in one segment, plus a split one: all answered in order
+    const float v[1] = {7.0f};
+    server.update(v, 1);
+    uint8_t batch[21 * 12];
+    size_t n = 0;
+    for (uint16_t i = 0; i < 21; ++i) n += Client::frame(batch + n, (uint16_t)(100 + i), 1, 3, 0, 1);
+    assert(c.send_raw(batch, n - 5));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    assert(c.send_raw(batch + n - 5, 5));
+    for (uint16_t i = 0; i < 21; ++i) {
+        uint16_t tid = 0;
+        auto pdu = c.read_response(&tid);
+        assert(tid == 100 + i && pdu.size() == 4 && pdu[3] == 7);
+    }
+    assert(server.requests() == 25);
+
+    // Protocol id != 0: not Modbus, the connection is closed
+    uint8_t junk[12];
+    Client::frame(junk, 1, 1, 3, 0, 1);
+    junk[3] = 1;
+    c.send_raw(junk, sizeof(junk));
+    assert(c.read_response().empty());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    assert(server.clients() == 0);
+    std::cout << "✓ test_exceptions_and_pipelining passed\n";
+}
+
+void test_many_clients() {
+    ModbusServer server;
+    assert(server.open(0, "127.0.0.1"));
+    for (uint16_t ch = 0; ch < 4; ++ch) assert(server.map(ModbusServer::Table::Input, ch, ch, 1.0f));
+    assert(server.map_counter(ModbusServer::Table::Input, 4));
+    assert(server.start());
+
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        float v[4];
+        for (int i = 1; !done.load(); ++i) {
+            for (float& f : v) f = (float)(i % 30000);
+            server.update(v, 4);
+        }
+    });
+    std::vector<std::thread> clients;
+    for (int t = 0; t < 50; ++t) {
+        clients.emplace_back([&] {
+            Client c(server.port());
+            for (int i = 0; i < 200; ++i) {
+                auto regs = c.read(ModbusServer::kFcReadInput, 0, 5);
+                // One snapshot per response: all channels come from the same update
+                assert(regs[0] == regs[1] && regs[1] == regs[2] && regs[2] == regs[3]);
+            }
+        });
+    }
+    for (auto& t : clients) t.join();
+    done.store(true);
+    writer.join();
+    assert(server.requests() == 50 * 200 && server.connects() == 50);
+    server.close();
+    assert(!server.is_open() && server.clients() == 0);
+    std::cout << "✓ test_many_clients passed\n";
+}
+
+int main() {
+    test_register_map();
+    test_exceptions_and_pipelining();
+    test_many_clients();
+    std::cout << "✓ All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file test_periodic_schedule.cpp
+ * @brief Unit tests for the periodic-task schedule and its timing accounting (PeriodicSchedule).
+ *
+ * Tests verify:
+ * - On-time iterations: releases on the period grid, zero lateness, no overruns or misses
+ * - A long iteration counts an overrun and a deadline miss; a late wake-up alone counts only a miss
+ * - CatchUp runs every passed release back to back; Skip drops them, counts them and stays on the grid
+ * - Skipped releases and deadline misses are counted separately: a skip alone is not a miss
+ * - Policy names parse; the CSV export holds the counters and every recorded sample in its buckets
+ */
+
+#include "industrial/PeriodicSchedule.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+using industrial::PeriodicSchedule;
+
+void test_on_time() {
+    PeriodicSchedule s(1000);
+    assert(!s.started());
+    s.start(5000);
+    assert(s.started() && s.until_due(5000) == 0);
+    for (int64_t k = 0; k < 10; ++k) {
+        const int64_t release = 5000 + k * 1000;
+        assert(s.until_due(release - 300) == 300);
+        s.begin(release);
+        s.end(release + 200);
+    }
+    assert(s.iterations() == 10 && s.overruns() == 0 && s.misses() == 0 && s.skipped() == 0);
+    assert(s.lateness().max() == 0 && s.jitter().max() == 0 && s.jitter().count() == 9);
+    assert(s.run_time().count() == 10 && s.run_time().max() == 200);
+    std::cout << "✓ test_on_time passed\n";
+}
+
+void test_overrun_and_miss() {
+    PeriodicSchedule s(1000);
+    s.start(0);
+    s.begin(0);
+    s.end(1500); // ran longer than the period: overrun and miss
+    assert(s.overruns() == 1 && s.misses() == 1);
+    s.begin(1500); // release 1000, half a period late
+    s.end(1700);   // deadline 2000 still met
+    assert(s.overruns() == 1 && s.misses() == 1);
+    assert(s.lateness().max() == 500 && s.jitter().max() == 500);
+    s.begin(2900); // release 2000, woke 900 late
+    s.end(3100);   // short run, but past the 3000 deadline
+    assert(s.overruns() == 1 && s.misses() == 2 && s.iterations() == 3);
+    std::cout << "✓ test_overrun_and_miss passed\n";
+}
+
+void test_catch_up() {
+    PeriodicSchedule s(1000);
+    s.start(0);
+    s.begin(0);
+    s.end(100);
+    // Woken at 3500: releases 1000, 2000 and 3000 have passed and all of them still run, now
+    int runs = 0;
+    int64_t now = 3500;
+    while (s.until_due(now) <= 0) {
+        s.begin(now);
+        s.end(now + 10);
+        now += 20;
+        ++runs;
+    }
+    assert(runs == 3 && s.skipped() == 0 && s.iterations() == 4);
+    assert(s.until_due(now) == 4000 - now); // back on the grid
+    assert(s.misses() == 2);                // releases 1000 and 2000 finished after their deadlines
+    std::cout << "✓ test_catch_up passed\n";
+}
+
+void test_skip() {
+    PeriodicSchedule s(1000, PeriodicSchedule::MissPolicy::Skip);
+    s.start(0);
+    s.begin(0);
+    s.end(100);
+    s.begin(3500); // release 1000 is 2500 late: 1000 and 2000 are dropped, this one stands for 3000
+    s.end(3510);   // before 3000's deadline (4000): skipped, but not a miss
+    assert(s.skipped() == 2 && s.misses() == 0 && s.iterations() == 2);
+    assert(s.until_due(3510) == 490); // next release 4000, on the original grid
+    assert(s.lateness().max() == 2500);
+    s.begin(4000);
+    s.end(4100);
+    assert(s.skipped() == 2 && s.misses() == 0);
+    // Less than a full period late: nothing to skip
+    s.begin(5900);
+    s.end(5950);
+    assert(s.skipped() == 2 && s.until_due(5950) == 50);
+    // A skip whose iteration then runs past the deadline of the release it stands for: both counted
+    s.begin(8200); // release 6000: 6000 and 7000 dropped, runs as 8000 (deadline 9000)
+    s.end(9100);
+    assert(s.skipped() == 4 && s.misses() == 1 && s.overruns() == 0);
+    std::cout << "✓ test_skip passed\n";
+}
+
+void test_policy_and_export() {
+    PeriodicSchedule s(1000);
+    assert(std::strcmp(s.policy_name(), "catchup") == 0);
+    assert(s.set_policy("skip") && s.policy() == PeriodicSchedule::MissPolicy::Skip);
+    assert(!s.set_policy("drop") && s.policy() == PeriodicSchedule::MissPolicy::Skip);
+    assert(s.set_policy("catchup") && std::strcmp(s.policy_name(), "catchup") == 0);
+
+    s.start(0);
+    for (int64_t k = 0; k < 50; ++k) {
+        const int64_t wake = k * 1000 + (k % 5) * 37;
+        s.begin(wake);
+        s.end(wake + (k == 7 ? 1200 : 50));
+    }
+    std::FILE* f = std::tmpfile();
+    assert(f != nullptr && s.write_csv(f));
+    std::rewind(f);
+    char line[128];
+    bool header = false, misses = false, overruns = false, buckets = false;
+    unsigned long long late_n = 0, run_n = 0, jitter_n = 0;
+    while (std::fgets(line, sizeof(line), f) != nullptr) {
+        unsigned long long lo, hi, n;
+        header = header || std::strcmp(line, "name,value\n") == 0;
+        misses = misses || std::strcmp(line, "deadline_misses,1\n") == 0;
+        overruns = overruns || std::strcmp(line, "overruns,1\n") == 0;
+        buckets = buckets || std::strcmp(line, "series,lower_ns,upper_ns,count\n") == 0;
+        if (std::sscanf(line, "lateness,%llu,%llu,%llu", &lo, &hi, &n) == 3) {
+            assert(lo <= hi);
+            late_n += n;
+        }
+        if (std::sscanf(line, "run,%llu,%llu,%llu", &lo, &hi, &n) == 3) run_n += n;
+        if (std::sscanf(line, "jitter,%llu,%llu,%llu", &lo, &hi, &n) == 3) jitter_n += n;
+    }
+    std::fclose(f);
+    assert(header && misses && overruns && buckets);
+    assert(late_n == 50 && run_n == 50 && jitter_n == 49);
+    assert(!s.write_csv(nullptr));
+    std::cout << "✓ test_policy_and_export passed\n";
+}
+
+int main() {
+    test_on_time();
+    test_overrun_and_miss();
+    test_catch_up();
+    test_skip();
+    test_policy_and_export();
+    std::cout << "✓ All tests passed!\n";
+    return 0;
+}
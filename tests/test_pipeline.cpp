@@ -0,0 +1,224 @@
+/**
+ * @file test_pipeline.cpp
+ * @brief Unit tests for the stage-graph runtime (Pipeline, Link).
+ *
+ * Tests verify:
+ * - source -> transform -> sink delivers every item in order, on separate threads or all on one, with
+ *   every wait strategy; filtered items are not forwarded; finish() runs once, after the last item
+ * - Overflow::Block applies back pressure (nothing lost, producer blocked, depth bounded by capacity);
+ *   Overflow::DropOldest keeps the source running, drops the oldest on the consumer side and counts
+ *   every drop exactly once
+ * - stop() ends an endless source and drains the rest; a paced source is woken on time
+ * - Topology errors are refused: a second consumer or producer for a link, a dangling link, bad thread
+ */
+
+#include "industrial/Pipeline.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using industrial::Link;
+using industrial::LinkBase;
+using industrial::Pipeline;
+using industrial::Step;
+using namespace std::chrono;
+
+// Emits 0..count-1 as fast as allowed; count 0 means forever
+struct Counter {
+    uint32_t count;
+    uint32_t next{0};
+    Step produce(uint32_t& out, int64_t&) {
+        if (count != 0 && next == count) return Step::Done;
+        out = next++;
+        return Step::Busy;
+    }
+};
+
+// Keeps even values, halves them
+struct Decimate {
+    bool process(const uint32_t& in, uint32_t& out) {
+        out = in / 2;
+        return in % 2 == 0;
+    }
+};
+
+struct Collect {
+    std::vector<uint32_t> seen;
+    uint32_t finished{0};
+    size_t seen_at_finish{0};
+    int sleep_us{0};
+    void consume(const uint32_t& v) {
+        seen.push_back(v);
+        if (sleep_us > 0) std::this_thread::sleep_for(microseconds(sleep_us));
+    }
+    void finish() {
+        ++finished;
+        seen_at_finish = seen.size();
+    }
+};
+
+static void run_linear(uint32_t t_src, uint32_t t_mid, uint32_t t_sink, const char* wait, uint32_t kItems) {
+    Link<uint32_t, 64> a, b;
+    Counter src{kItems};
+    Decimate dec;
+    Collect sink;
+    Pipeline pipe;
+    for (uint32_t t = 0; t < 3; ++t) assert(pipe.wait(t).select(wait));
+    assert(pipe.source("count", src, a, t_src));
+    assert(pipe.transform("decimate", a, dec, b, t_mid));
+    assert(pipe.sink("collect", b, sink, t_sink));
+    assert(pipe.start());
+    assert(pipe.wait_for(seconds(20)));
+    pipe.join();
+
+    assert(sink.seen.size() == kItems / 2 && sink.finished == 1 && sink.seen_at_finish == kItems / 2);
+    for (uint32_t i = 0; i < kItems / 2; ++i) assert(sink.seen[i] == i);
+    const Pipeline::StageStats s0 = pipe.stats(0), s1 = pipe.stats(1), s2 = pipe.stats(2);
+    assert(s0.out == kItems && s0.in == 0 && s0.capacity == 0 && s0.done);
+    assert(s1.in == kItems && s1.out == kItems / 2 && s1.capacity == 64 && s1.depth == 0);
+    assert(s2.in == kItems / 2 && s2.high_water <= 64 && s2.done);
+    assert(s0.dropped == 0 && s1.dropped == 0);
+    assert(pipe.elapsed_ns() > 0 && pipe.thread_cpu_ns(t_sink) > 0);
+}
+
+void test_linear() {
+    run_linear(0, 1, 2, "park", 50000);
+    run_linear(0, 0, 0, "park", 50000); // everything on one thread
+    for (const char* w : {"spin", "yield", "backoff", "event"}) run_linear(0, 1, 1, w, 20000);
+    run_linear(0, 1, 1, "sleep", 2000); // 5 ms polls: ~30 of them
+    std::cout << "✓ test_linear passed\n";
+}
+
+void test_back_pressure() {
+    Link<uint32_t, 4> q;
+    Counter src{300};
+    Collect sink;
+    sink.sleep_us = 100;
+    Pipeline pipe;
+    assert(pipe.source("count", src, q, 0));
+    assert(pipe.sink("slow", q, sink, 1));
+    assert(pipe.start());
+    assert(pipe.wait_for(seconds(10)));
+    pipe.join();
+    assert(sink.seen.size() == 300);
+    for (uint32_t i = 0; i < 300; ++i) assert(sink.seen[i] == i);
+    const auto s0 = pipe.stats(0), s1 = pipe.stats(1);
+    assert(s0.blocked > 0 && s0.dropped == 0);
+    assert(s1.high_water == 4);
+    std::cout << "✓ test_back_pressure passed (source blocked " << s0.blocked << " times)\n";
+}
+
+void test_drop_oldest() {
+    Link<uint32_t, 4> q(LinkBase::Overflow::DropOldest);
+    Counter src{3000};
+    Collect sink;
+    sink.sleep_us = 50;
+    Pipeline pipe;
+    assert(pipe.source("count", src, q, 0));
+    assert(pipe.sink("slow", q, sink, 1));
+    assert(pipe.start());
+    assert(pipe.wait_for(seconds(10)));
+    pipe.join();
+    const auto s0 = pipe.stats(0), s1 = pipe.stats(1);
+    assert(s0.blocked == 0 && s0.dropped > 0);
+    assert(s1.in + s0.dropped == 3000);                  // everything was either consumed or dropped
+    for (size_t i = 1; i < sink.seen.size(); ++i) assert(sink.seen[i] > sink.seen[i - 1]); // still in order
+    std::cout << "✓ test_drop_oldest passed (" << s0.dropped << " dropped)\n";
+}
+
+// Single-threaded: the consumer drops the oldest items, and refuses the newest only past the spare slots
+void test_drop_oldest_link() {
+    Link<uint32_t, 4> q(LinkBase::Overflow::DropOldest);
+    for (uint32_t i = 0; i < 7; ++i) q.put(i);
+    assert(q.full() && q.depth() == 4 && q.dropped() == 0); // 3 drops requested, not done yet
+    uint32_t v;
+    for (uint32_t want = 3; want < 7; ++want) assert(q.take(v) && v == want);
+    assert(!q.take(v) && q.dropped() == 3 && q.depth() == 0);
+
+    for (uint32_t i = 0; i < 10; ++i) q.put(i); // 8 slots: 8 and 9 are refused
+    assert(q.dropped() == 5);
+    for (uint32_t want = 4; want < 8; ++want) assert(q.take(v) && v == want);
+    assert(!q.take(v) && q.dropped() == 9 && q.high_water() == 4);
+    std::cout << "✓ test_drop_oldest_link passed\n";
+}
+
+// One value every period, forever
+struct Ticker {
+    steady_clock::duration period;
+    steady_clock::time_point next;
+    std::vector<int64_t> late_us;
+    Step produce(uint32_t& out, int64_t& wait_ns) {
+        const auto now = steady_clock::now();
+        if (now < next) {
+            const int64_t left = duration_cast<nanoseconds>(next - now).count();
+            if (left < wait_ns) wait_ns = left;
+            return Step::Idle;
+        }
+        late_us.push_back(duration_cast<microseconds>(now - next).count());
+        next += period;
+        out = (uint32_t)late_us.size();
+        return Step::Busy;
+    }
+};
+
+void test_stop_and_timing() {
+    Link<uint32_t, 16> q;
+    Ticker tick{milliseconds(10), steady_clock::now() + milliseconds(10), {}};
+    tick.late_us.reserve(64);
+    Collect sink;
+    sink.seen.reserve(64);
+    Pipeline pipe;
+    assert(pipe.source("tick", tick, q, 0));
+    assert(pipe.sink("collect", q, sink, 1));
+    assert(pipe.start());
+    assert(!pipe.wait_for(milliseconds(205)));
+    assert(!pipe.stats(0).done);
+    pipe.stop();
+    assert(pipe.wait_for(seconds(2)));
+    pipe.join();
+    assert(sink.finished == 1 && sink.seen.size() == tick.late_us.size());
+    assert(sink.seen.size() >= 15 && sink.seen.size() <= 21);
+    std::vector<int64_t> late = tick.late_us;
+    std::sort(late.begin(), late.end());
+    assert(late[late.size() / 2] < 5000); // the parked source thread wakes for its deadline, not 100 ms later
+    std::cout << "✓ test_stop_and_timing passed (" << sink.seen.size() << " ticks, median lateness "
+              << late[late.size() / 2] << " us)\n";
+}
+
+void test_topology_errors() {
+    Link<uint32_t, 8> a, b, dangling;
+    Counter src{10}, src2{10};
+    Decimate dec;
+    Collect sink, sink2;
+    Pipeline pipe;
+    assert(!pipe.source("bad thread", src, a, industrial::kPipelineMaxThreads));
+    assert(pipe.source("count", src, a, 0));
+    assert(!pipe.source("second producer", src2, a, 0));
+    assert(pipe.transform("decimate", a, dec, b, 1));
+    assert(!pipe.sink("second consumer", a, sink2, 1));
+    assert(!pipe.start()); // b has no consumer yet
+    assert(pipe.sink("collect", b, sink, 1));
+    assert(pipe.start());
+    assert(!pipe.start());
+    assert(!pipe.sink("late", dangling, sink2, 0));
+    assert(pipe.wait_for(seconds(5)));
+    pipe.join();
+    assert(sink.seen.size() == 5);
+    std::cout << "✓ test_topology_errors passed\n";
+}
+
+int main() {
+    test_linear();
+    test_back_pressure();
+    test_drop_oldest();
+    test_drop_oldest_link();
+    test_stop_and_timing();
+    test_topology_errors();
+    std::cout << "✓ All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file test_priority_lane.cpp
+ * @brief Unit tests for the alarm path: ThresholdAlarm, LatencyHistogram and SinkFanOut's priority lane.
+ *
+ * Tests verify:
+ * - High/low alarms raise and clear once, with hysteresis; NaN leaves the state alone
+ * - Histogram buckets cover every value within 12.5 %; percentiles and max on a known distribution
+ * - A priority frame overtakes a telemetry backlog: it is written right after the write in progress
+ *   and its latency is recorded; Bulk order is unchanged
+ * - MqttSink publishes each lane with its own QoS and retain flag and flushes alarms at once in
+ *   Batched mode
+ */
+
+#include "industrial/LatencyHistogram.hpp"
+#include "industrial/MqttPublisher.hpp"
+#include "industrial/PayloadPool.hpp"
+#include "industrial/SinkFanOut.hpp"
+#include "industrial/ThresholdAlarm.hpp"
+#include "support/FakeMqttBroker.hpp"
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using industrial::LatencyHistogram;
+using industrial::testing::FakeMqttBroker;
+
+void test_threshold_alarm() {
+    using Alarms = industrial::ThresholdAlarm<2>;
+    Alarms a;
+    assert(!a.configured());
+    a.set_high(0, 50.0f, 1.0f);
+    a.set_low(1, 100.0f, 5.0f);
+    assert(a.configured());
+    Alarms::Event ev[4];
+
+    auto step = [&](float t, float p) {
+        const float v[2] = {t, p};
+        return a.update(v, ev);
+    };
+    assert(step(45.0f, 200.0f) == 0);
+    assert(step(50.5f, 200.0f) == 1 && ev[0].channel == 0 && ev[0].kind == Alarms::Kind::High && ev[0].active &&
+           ev[0].value == 50.5f);
+    assert(step(51.0f, 200.0f) == 0);  // still active: no repeat
+    assert(step(49.5f, 200.0f) == 0);  // inside the hysteresis band
+    assert(step(NAN, NAN) == 0);       // no state change on NaN
+    assert(a.active(0, Alarms::Kind::High));
+    assert(step(48.9f, 99.0f) == 2);   // temp clears, pressure low raises
+    assert(ev[0].channel == 0 && !ev[0].active && ev[1].channel == 1 && ev[1].kind == Alarms::Kind::Low &&
+           ev[1].active);
+    assert(step(48.9f, 104.0f) == 0);
+    assert(step(48.9f, 105.5f) == 1 && !ev[0].active);
+    assert(a.raised() == 2);
+    std::cout << "✓ test_threshold_alarm passed\n";
+}
+
+void test_histogram() {
+    for (uint64_t v : {0ull, 1ull, 7ull, 8ull, 9ull, 15ull, 16ull, 17ull, 1000ull, 123456789ull, 1ull << 40,
+                       ~0ull >> 1, ~0ull}) {
+        const uint32_t i = LatencyHistogram::index(v);
+        assert(i < LatencyHistogram::kBuckets);
+        assert(LatencyHistogram::lower_edge(i) <= v && v <= LatencyHistogram::upper_edge(i));
+        assert((double)(LatencyHistogram::upper_edge(i) - v) <= (double)v / LatencyHistogram::kSubBuckets + 1.0);
+    }
+    for (uint32_t i = 1; i < LatencyHistogram::kBuckets; ++i)
+        assert(LatencyHistogram::lower_edge(i) == LatencyHistogram::upper_edge(i - 1) + 1); // contiguous
+
+    static LatencyHistogram h;
+    assert(h.percentile(99) == 0 && h.count() == 0);
+    for (int64_t us = 1; us <= 1000; ++us) h.record(us * 1000); // 1 us .. 1 ms, uniform
+    h.record(-5);                                                // clock hiccup: counted as 0
+    assert(h.count() == 1001 && h.max() == 1000000);
+    const double p50 = (double)h.percentile(50), p99 = (double)h.percentile(99);
+    assert(p50 >= 500000.0 && p50 <= 500000.0 * 1.125);
+    assert(p99 >= 990000.0 && p99 <= 1000000.0);
+    assert(h.percentile(100) == 1000000 && h.percentile(0) == 0);
+    assert(std::fabs(h.mean() - 500500000.0 / 1001.0) < 1.0);
+    h.clear();
+    assert(h.count() == 0 && h.max() == 0);
+    std::cout << "✓ test_histogram passed\n";
+}
+
+// Takes 1 ms per write and remembers the order
+struct SlowSink {
+    std::mutex mu;
+    std::vector<std::string> log;
+
+    bool write(const industrial::Frame& f) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::lock_guard<std::mutex> lk(mu);
+        log.push_back(std::string((const char*)f.data, f.len) + (f.priority ? "!" : ""));
+        return true;
+    }
+    void idle() {}
+    static const char* name() { return "slow"; }
+};
+
+void test_priority_overtakes_backlog() {
+    using Pool = industrial::PayloadPool<256, 32>;
+    using FanOut = industrial::SinkFanOut<Pool, SlowSink>;
+    static Pool pool;
+    SlowSink sink;
+    FanOut out(pool, sink);
+    out.enable(0, true);
+    out.start();
+    static const std::string tele = "t", alarm = "t/alarm";
+
+    auto submit = [&](const std::string& topic, const std::string& payload, FanOut::Lane lane) {
+        Pool::Handle h = pool.acquire();
+        assert(h != Pool::kInvalid);
+        std::memcpy(pool.data(h), payload.data(), payload.size());
+        pool.set_len(h, (uint32_t)payload.size());
+        out.submit(h, topic, false, lane);
+    };
+    for (int i = 0; i < 200; ++i) submit(tele, std::to_string(i), FanOut::Lane::Bulk); // ~200 ms of backlog
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    submit(alarm, "A", FanOut::Lane::Priority);
+    out.stop();
+
+    size_t at = 0;
+    while (sink.log[at] != "A!") ++at;
+    size_t before = 0;
+    for (const auto& e : sink.log) before += e == "A!" ? 0 : 1;
+    assert(before == 200);
+    assert(at <= 40); // behind ~20 written ones, not behind the 180 still queued
+    for (size_t i = 0, k = 0; i < sink.log.size(); ++i)
+        if (i != at) assert(sink.log[i] == std::to_string(k++)); // Bulk order unchanged
+
+    const auto st = out.stats(0);
+    assert(st.priority == 1 && st.frames == 201 && st.depth == 0);
+    const LatencyHistogram& lat = out.priority_latency(0);
+    assert(lat.count() == 1);
+    assert(lat.max() < 20 * 1000000ull); // one write in progress, not the backlog
+    std::cout << "✓ test_priority_overtakes_backlog passed (alarm latency " << lat.max() / 1000 << " us)\n";
+}
+
+void test_mqtt_lane_options() {
+    FakeMqttBroker broker;
+    assert(broker.start());
+    industrial::MqttPublisher pub;
+    pub.set_mode(industrial::MqttPublisher::Mode::Batched, 64);
+    assert(pub.connect(broker.uri(), "t-lanes", 60));
+    industrial::MqttSink sink(pub, nullptr, 0.0, 0);
+    sink.set_lanes({0, false}, {1, true});
+
+    const std::string tele = "s/readings", alarm = "s/readings/alarm";
+    const char* payload = "x";
+    assert(sink.write({tele, (const uint8_t*)payload, 1, false, false}));
+    assert(sink.write({alarm, (const uint8_t*)payload, 1, false, true}));
+    // The alarm flushed the batch; no idle() needed
+    assert(broker.wait_publishes(2, 2000));
+    auto msgs = broker.messages();
+    assert(msgs[0].topic == tele && msgs[0].qos == 0 && !msgs[0].retain);
+    assert(msgs[1].topic == alarm && msgs[1].qos == 1 && msgs[1].retain);
+    pub.disconnect();
+    std::cout << "✓ test_mqtt_lane_options passed\n";
+}
+
+int main() {
+    test_threshold_alarm();
+    test_histogram();
+    test_priority_overtakes_backlog();
+    test_mqtt_lane_options();
+    std::cout << "✓ All tests passed!\n";
+    return 0;
+}
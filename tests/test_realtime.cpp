@@ -0,0 +1,163 @@
+/**
+ * @file test_realtime.cpp
+ * @brief Unit tests for the real-time thread setup (Realtime.hpp) and its use by Pipeline.
+ *
+ * Tests verify:
+ * - CPU lists parse up to the first bad entry and never past the caller's array
+ * - Prefaulting leaves buffer contents unchanged
+ * - rt_apply() changes nothing by default; with a CPU and a priority it pins the thread and either
+ *   switches it to SCHED_FIFO or reports the errno (without privileges), never both
+ * - mlockall either succeeds or reports why not
+ * - Pipeline threads apply their settings as they start and still deliver everything
+ */
+
+#include "industrial/Pipeline.hpp"
+#include "industrial/Realtime.hpp"
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+using namespace industrial;
+
+// First CPU this process may run on
+static int first_cpu() {
+    cpu_set_t set;
+    assert(::sched_getaffinity(0, sizeof(set), &set) == 0);
+    for (int c = 0; c < CPU_SETSIZE; ++c)
+        if (CPU_ISSET(c, &set)) return c;
+    return 0;
+}
+
+void test_parse_cpus() {
+    int cpus[4];
+    assert(rt_parse_cpus("0,2,3", cpus, 4) == 3 && cpus[0] == 0 && cpus[1] == 2 && cpus[2] == 3);
+    assert(rt_parse_cpus("1", cpus, 4) == 1 && cpus[0] == 1);
+    assert(rt_parse_cpus("5,x,6", cpus, 4) == 1 && cpus[0] == 5);
+    assert(rt_parse_cpus("0,1,2,3,4,5", cpus, 4) == 4 && cpus[3] == 3);
+    assert(rt_parse_cpus("", cpus, 4) == 0);
+    assert(rt_parse_cpus("-1", cpus, 4) == 0);
+    assert(rt_parse_cpus(nullptr, cpus, 4) == 0);
+    assert(rt_cpu_count() >= 1);
+    std::cout << "✓ test_parse_cpus passed\n";
+}
+
+void test_prefault() {
+    static unsigned char buf[3 * 4096 + 100];
+    for (size_t i = 0; i < sizeof(buf); ++i) buf[i] = static_cast<unsigned char>(i * 7);
+    rt_prefault(buf, sizeof(buf));
+    for (size_t i = 0; i < sizeof(buf); ++i) assert(buf[i] == static_cast<unsigned char>(i * 7));
+    rt_prefault(buf, 0);
+    std::cout << "✓ test_prefault passed\n";
+}
+
+void test_apply() {
+    // Defaults: nothing requested, nothing touched
+    std::thread([] {
+        const RtStatus s = rt_apply(RtThread{});
+        assert(!s.requested && !s.pinned && !s.fifo && !s.stack);
+        int policy;
+        sched_param sp{};
+        assert(::pthread_getschedparam(::pthread_self(), &policy, &sp) == 0 && policy == SCHED_OTHER);
+    }).join();
+
+    // Pinned to an allowed CPU and SCHED_FIFO 10 (or the reason it was refused)
+    const int cpu = first_cpu();
+    std::thread([cpu] {
+        RtThread rt;
+        rt.cpu = cpu;
+        rt.priority = 10;
+        const RtStatus s = rt_apply(rt);
+        assert(s.requested && s.pinned && s.pin_err == 0 && s.stack);
+        assert(::sched_getcpu() == cpu);
+        assert(s.fifo != (s.fifo_err != 0));
+        int policy;
+        sched_param sp{};
+        assert(::pthread_getschedparam(::pthread_self(), &policy, &sp) == 0);
+        if (s.fifo) {
+            assert(policy == SCHED_FIFO && sp.sched_priority == 10);
+        } else {
+            assert(policy == SCHED_OTHER && s.fifo_err == EPERM);
+        }
+        std::cout << "  SCHED_FIFO " << (s.fifo ? "granted" : "refused (no privileges)") << '\n';
+    }).join();
+
+    // A CPU we may not use is reported, the rest still applies
+    std::thread([] {
+        RtThread rt;
+        rt.cpu = CPU_SETSIZE - 1;
+        const RtStatus s = rt_apply(rt);
+        assert(s.requested && !s.pinned && s.pin_err != 0 && !s.fifo && s.fifo_err == 0);
+    }).join();
+    std::cout << "✓ test_apply passed\n";
+}
+
+void test_lock_memory() {
+    const int err = rt_lock_memory();
+    assert(err == 0 || err == EPERM || err == ENOMEM || err == EAGAIN);
+    std::cout << "  mlockall " << (err == 0 ? "ok" : std::strerror(err)) << '\n';
+    (void)::munlockall();
+    std::cout << "✓ test_lock_memory passed\n";
+}
+
+struct Counter {
+    uint32_t count;
+    uint32_t next{0};
+    Step produce(uint32_t& out, int64_t&) {
+        if (next == count) return Step::Done;
+        out = next++;
+        return Step::Busy;
+    }
+};
+
+struct Check {
+    uint32_t expect{0};
+    void consume(const uint32_t& v) {
+        assert(v == expect);
+        ++expect;
+    }
+};
+
+void test_pipeline_realtime() {
+    Link<uint32_t, 64> q;
+    Counter src{5000};
+    Check sink;
+    Pipeline pipe;
+    assert(pipe.source("src", src, q, 0));
+    assert(pipe.sink("sink", q, sink, 1));
+    RtThread pinned;
+    pinned.cpu = first_cpu();
+    RtThread fifo;
+    fifo.priority = 5; // the sink parks when idle, so FIFO cannot starve the source
+    assert(pipe.realtime(0, pinned));
+    assert(pipe.realtime(1, fifo));
+    assert(!pipe.realtime(kPipelineMaxThreads, pinned));
+    assert(!pipe.rt_status(0).requested); // not applied before the thread runs
+    assert(pipe.start());
+    assert(!pipe.realtime(0, fifo));
+    assert(pipe.wait_for(std::chrono::seconds(10)));
+    pipe.join();
+    assert(sink.expect == 5000);
+    const RtStatus s0 = pipe.rt_status(0), s1 = pipe.rt_status(1);
+    assert(s0.requested && s0.pinned && s0.cpu == pinned.cpu && s0.priority == 0 && !s0.fifo);
+    assert(s1.requested && !s1.pinned && s1.priority == 5 && s1.fifo != (s1.fifo_err != 0));
+    assert(!pipe.rt_status(2).requested); // unused thread
+    std::cout << "✓ test_pipeline_realtime passed\n";
+}
+
+int main() {
+    test_parse_cpus();
+    test_prefault();
+    test_apply();
+    test_lock_memory();
+    test_pipeline_realtime();
+    std::cout << "✓ All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,208 @@
+/**
+ * @file test_sparkplug.cpp
+ * @brief Unit tests for ProtoWriter and the Sparkplug B encoder.
+ *
+ * A tiny protobuf reader in this file decodes what the encoder wrote. Tests verify:
+ * - Wire format of varints, fixed32 and nested messages (including bodies > 127 bytes)
+ * - NBIRTH: seq 0, bdSeq metric, names + aliases + datatypes + values
+ * - DDATA: alias-only metrics with per-metric timestamps, batched, seq incrementing and wrapping
+ * - rebirth() advances bdSeq; too-small buffers yield 0
+ */
+
+#include "industrial/ProtoWriter.hpp"
+#include "industrial/Sparkplug.hpp"
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using industrial::ProtoWriter;
+using industrial::SparkplugEncoder;
+using industrial::SparkplugSession;
+namespace sp = industrial::sparkplug;
+
+// Decoded field: wire type 0/1/5 in num, 2 in bytes
+struct Field {
+    uint32_t number;
+    uint32_t wire;
+    uint64_t num;
+    std::string bytes;
+};
+
+static std::vector<Field> parse(const uint8_t* p, size_t n) {
+    std::vector<Field> out;
+    size_t i = 0;
+    auto varint = [&]() {
+        uint64_t v = 0;
+        int shift = 0;
+        for (;;) {
+            assert(i < n);
+            uint8_t b = p[i++];
+            v |= uint64_t(b & 0x7F) << shift;
+            if (!(b & 0x80)) return v;
+            shift += 7;
+        }
+    };
+    while (i < n) {
+        Field f{};
+        uint64_t key = varint();
+        f.number = (uint32_t)(key >> 3);
+        f.wire = (uint32_t)(key & 7);
+        if (f.wire == 0) {
+            f.num = varint();
+        } else if (f.wire == 2) {
+            uint64_t len = varint();
+            assert(i + len <= n);
+            f.bytes.assign((const char*)p + i, len);
+            i += len;
+        } else if (f.wire == 5 || f.wire == 1) {
+            const size_t w = f.wire == 5 ? 4 : 8;
+            assert(i + w <= n);
+            for (size_t k = 0; k < w; ++k) f.num |= uint64_t(p[i + k]) << (8 * k);
+            i += w;
+        } else {
+            assert(false && "unexpected wire type");
+        }
+        out.push_back(f);
+    }
+    assert(i == n);
+    return out;
+}
+
+static std::vector<Field> parse(const std::string& s) { return parse((const uint8_t*)s.data(), s.size()); }
+
+static const Field* find(const std::vector<Field>& fs, uint32_t number) {
+    for (const Field& f : fs)
+        if (f.number == number) return &f;
+    return nullptr;
+}
+
+static float as_float(uint64_t bits) {
+    uint32_t u = (uint32_t)bits;
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+void test_proto_writer() {
+    uint8_t buf[512];
+    ProtoWriter w(buf, sizeof(buf));
+    w.varint(1, 300);
+    w.fixed32(2, 0x01020304u);
+    const uint8_t expect[] = {0x08, 0xAC, 0x02, 0x15, 0x04, 0x03, 0x02, 0x01};
+    assert(w.size() == sizeof(expect) && std::memcmp(buf, expect, sizeof(expect)) == 0);
+
+    // Nested bodies of 5 and 200 bytes: the second needs a two-byte length and a shift
+    size_t m = w.begin(3);
+    w.string(1, "abc");
+    w.end(m);
+    m = w.begin(4);
+    std::string big(197, 'x');
+    w.string(1, big);
+    w.end(m);
+    w.varint(5, 7);
+    assert(w.ok());
+    auto fs = parse(buf, w.size());
+    assert(fs.size() == 5);
+    assert(fs[2].number == 3 && parse(fs[2].bytes)[0].bytes == "abc");
+    assert(fs[3].number == 4 && fs[3].bytes.size() == 200 && parse(fs[3].bytes)[0].bytes == big);
+    assert(fs[4].number == 5 && fs[4].num == 7);
+
+    ProtoWriter tiny(buf, 3);
+    tiny.varint(1, 300);
+    tiny.varint(2, 1);
+    assert(!tiny.ok());
+
+    std::cout << "✓ test_proto_writer passed\n";
+}
+
+static const sp::MetricDef kDefs[] = {
+    {"temperature", 1, sp::DataType::Float},
+    {"pressure", 2, sp::DataType::Float},
+    {"state", 3, sp::DataType::String},
+};
+
+void test_nbirth() {
+    SparkplugSession session;
+    const sp::Value values[] = {sp::Value::of_float(21.5f), sp::Value::of_float(1400.25f), sp::Value::of_string("run")};
+    uint8_t buf[512];
+    size_t n = industrial::sparkplug_nbirth(buf, sizeof(buf), session, 1700000000123ull, kDefs, values, 3);
+    assert(n > 0);
+    auto payload = parse(buf, n);
+    assert(find(payload, 1)->num == 1700000000123ull);
+    assert(find(payload, 3)->num == 0); // NBIRTH seq
+
+    std::vector<std::vector<Field>> metrics;
+    for (const Field& f : payload)
+        if (f.number == 2) metrics.push_back(parse(f.bytes));
+    assert(metrics.size() == 4);
+    assert(find(metrics[0], 1)->bytes == "bdSeq" && find(metrics[0], 4)->num == 8 && find(metrics[0], 11)->num == 0);
+    assert(find(metrics[1], 1)->bytes == "temperature" && find(metrics[1], 2)->num == 1);
+    assert(find(metrics[1], 4)->num == 9 && as_float(find(metrics[1], 12)->num) == 21.5f);
+    assert(find(metrics[2], 1)->bytes == "pressure" && as_float(find(metrics[2], 12)->num) == 1400.25f);
+    assert(find(metrics[3], 4)->num == 12 && find(metrics[3], 15)->bytes == "run");
+    assert(find(metrics[1], 3)->num == 1700000000123ull);
+
+    size_t d = industrial::sparkplug_dbirth(buf, sizeof(buf), session, 1700000000124ull, kDefs, values, 3);
+    assert(d > 0 && find(parse(buf, d), 3)->num == 1);
+
+    std::cout << "✓ test_nbirth passed\n";
+}
+
+void test_ddata_batch_and_seq() {
+    SparkplugSession session;
+    uint8_t buf[640];
+    const sp::Value v0[] = {sp::Value::of_float(0), sp::Value::of_float(0), sp::Value::of_string("")};
+    assert(industrial::sparkplug_nbirth(buf, sizeof(buf), session, 1, kDefs, v0, 3) > 0);
+
+    SparkplugEncoder enc(buf, sizeof(buf));
+    const uint64_t t0 = 1700000000000ull;
+    enc.begin(t0 + 70);
+    for (int i = 0; i < 8; ++i) {
+        enc.metric_float(1, t0 + 10 * i, 20.0f + i);
+        enc.metric_float(2, t0 + 10 * i, 1400.0f - i);
+    }
+    size_t n = enc.finish(session.next_seq());
+    assert(n > 0);
+    assert(n <= industrial::kSparkplugEnvelopeMax + 16 * industrial::kSparkplugFloatMetricMax);
+    auto payload = parse(buf, n);
+    assert(find(payload, 3)->num == 1);
+    int k = 0;
+    for (const Field& f : payload) {
+        if (f.number != 2) continue;
+        auto m = parse(f.bytes);
+        assert(find(m, 1) == nullptr);    // no names in data messages
+        assert(find(m, 4) == nullptr);    // nor datatypes
+        const int i = k / 2;
+        assert(find(m, 2)->num == (uint64_t)(k % 2 ? 2 : 1));
+        assert(find(m, 3)->num == t0 + 10 * i);
+        assert(as_float(find(m, 12)->num) == (k % 2 ? 1400.0f - i : 20.0f + i));
+        ++k;
+    }
+    assert(k == 16);
+
+    // seq wraps after 255; rebirth starts over at 0 with the next bdSeq
+    for (int i = 0; i < 254; ++i) session.next_seq();
+    assert(session.next_seq() == 0);
+    n = industrial::sparkplug_nbirth(buf, sizeof(buf), session, 2, kDefs, v0, 3);
+    payload = parse(buf, n);
+    assert(find(payload, 3)->num == 0);
+    assert(find(parse(find(payload, 2)->bytes), 11)->num == 1); // bdSeq 1
+
+    // Too small
+    SparkplugEncoder small(buf, 10);
+    small.begin(t0);
+    small.metric_float(1, t0, 1.0f);
+    assert(small.finish(0) == 0);
+
+    std::cout << "✓ test_ddata_batch_and_seq passed\n";
+}
+
+int main() {
+    test_proto_writer();
+    test_nbirth();
+    test_ddata_batch_and_seq();
+    std::cout << "✓ All tests passed!\n";
+    return 0;
+}
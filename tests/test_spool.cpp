@@ -0,0 +1,251 @@
+/**
+ * @file test_spool.cpp
+ * @brief Unit tests for the mmap-backed store-and-forward Spool.
+ *
+ * Tests verify:
+ * - FIFO append/drain across segment rollover
+ * - Drop-newest accounting when every segment is full, and reuse after draining
+ * - Recovery after reopen: unread records survive, read progress is kept,
+ *   and a torn (uncommitted) tail record is ignored
+ * - Background writer thread fed through enqueue(); a full enqueue ring refuses and counts, never overwrites
+ */
+
+#include "industrial/Spool.hpp"
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using industrial::Spool;
+
+static std::string make_dir() {
+    char tmpl[] = "/tmp/spool_test_XXXXXX";
+    char* d = ::mkdtemp(tmpl);
+    assert(d != nullptr);
+    return std::string(d) + "/spool";
+}
+
+static void remove_dir(const std::string& dir) {
+    std::string cmd = "rm -rf '" + dir.substr(0, dir.rfind('/')) + "'";
+    int rc = std::system(cmd.c_str());
+    (void)rc;
+}
+
+static bool put(Spool& sp, int i) {
+    char payload[64];
+    int n = std::snprintf(payload, sizeof(payload), "payload-%d", i);
+    return sp.append("t/x", 3, payload, (size_t)n);
+}
+
+static int take_all(Spool& sp, int expect_from) {
+    int next = expect_from;
+    sp.drain(1000000, [&](const Spool::Record& r) {
+        char want[64];
+        int n = std::snprintf(want, sizeof(want), "payload-%d", next);
+        assert(r.topic_len == 3 && std::memcmp(r.topic, "t/x", 3) == 0);
+        assert(r.len == (uint32_t)n && std::memcmp(r.payload, want, (size_t)n) == 0);
+        ++next;
+        return true;
+    });
+    return next;
+}
+
+void test_fifo_across_segments() {
+    std::string dir = make_dir();
+    Spool sp;
+    bool ok = sp.open(dir, 4096, 4);
+    assert(ok);
+    for (int i = 0; i < 300; ++i) {
+        ok = put(sp, i); // ~32 bytes per record, several segments worth
+        assert(ok);
+    }
+    int next = take_all(sp, 0);
+    assert(next == 300);
+    assert(sp.drained() == 300);
+
+    Spool::Record r;
+    assert(!sp.peek(r));
+    sp.close();
+    remove_dir(dir);
+
+    std::cout << "✓ test_fifo_across_segments passed\n";
+}
+
+void test_full_then_reuse() {
+    std::string dir = make_dir();
+    Spool sp;
+    bool ok = sp.open(dir, 2048, 2);
+    assert(ok);
+    int written = 0;
+    while (put(sp, written)) ++written;
+    assert(written > 0);
+    assert(sp.dropped() == 1);
+
+    // Stop after half, leaving the rest spooled; the freed segment becomes writable again
+    int half = 70; // more than one 2 KiB segment holds
+    int next = 0;
+    sp.drain((size_t)half, [&](const Spool::Record&) { ++next; return true; });
+    assert(next == half);
+    ok = put(sp, written);
+    assert(ok);
+    next = take_all(sp, half);
+    assert(next == written + 1);
+    sp.close();
+    remove_dir(dir);
+
+    std::cout << "✓ test_full_then_reuse passed\n";
+}
+
+void test_recovery_after_reopen() {
+    std::string dir = make_dir();
+    {
+        Spool sp;
+        bool ok = sp.open(dir, 4096, 4);
+        assert(ok);
+        for (int i = 0; i < 200; ++i) {
+            ok = put(sp, i);
+            assert(ok);
+        }
+        // Consume the first 50; refuse the 51st so it stays spooled
+        int seen = 0;
+        size_t n = sp.drain(1000, [&](const Spool::Record&) { return ++seen <= 50; });
+        assert(n == 50);
+        sp.close(); // acts like a crash: nothing but the mapping survives
+    }
+    {
+        // Reopen resumes after the 50 consumed records, then appends to the recovered tail
+        Spool sp;
+        bool ok = sp.open(dir, 4096, 4);
+        assert(ok);
+        int next = take_all(sp, 50);
+        assert(next == 200);
+        ok = put(sp, 200);
+        assert(ok);
+        sp.close();
+    }
+    {
+        Spool sp;
+        bool ok = sp.open(dir, 4096, 4);
+        assert(ok);
+        int next = take_all(sp, 200);
+        assert(next == 201);
+        sp.close();
+    }
+    {
+        // Different geometry must be refused rather than misread
+        Spool sp;
+        bool ok = sp.open(dir, 8192, 4);
+        assert(!ok);
+    }
+    remove_dir(dir);
+
+    std::cout << "✓ test_recovery_after_reopen passed\n";
+}
+
+void test_torn_tail_ignored() {
+    std::string dir = make_dir();
+    {
+        Spool sp;
+        bool ok = sp.open(dir, 4096, 1);
+        assert(ok);
+        for (int i = 0; i < 5; ++i) {
+            ok = put(sp, i);
+            assert(ok);
+        }
+        sp.close();
+    }
+    {
+        // Write a plausible record header with a bogus commit word past the committed tail
+        FILE* f = std::fopen((dir + "/spool-000.seg").c_str(), "r+b");
+        assert(f != nullptr);
+        long tail = 64 + 5 * 32; // header + 5 records of 12 + 3 + 9 bytes, 8-aligned
+        uint32_t torn[3] = {0x12345678u, 9u, 3u};
+        int rc = std::fseek(f, tail, SEEK_SET);
+        assert(rc == 0);
+        size_t w = std::fwrite(torn, sizeof(torn), 1, f);
+        assert(w == 1);
+        std::fclose(f);
+    }
+    {
+        Spool sp;
+        bool ok = sp.open(dir, 4096, 1);
+        assert(ok);
+        int next = take_all(sp, 0);
+        assert(next == 5);
+        sp.close();
+    }
+    remove_dir(dir);
+
+    std::cout << "✓ test_torn_tail_ignored passed\n";
+}
+
+void test_background_writer() {
+    std::string dir = make_dir();
+    Spool sp;
+    bool ok = sp.open(dir, 1 << 16, 4);
+    assert(ok);
+    sp.start();
+    int next = 0;
+    for (int i = 0; i < 1000; ++i) {
+        char payload[64];
+        int n = std::snprintf(payload, sizeof(payload), "payload-%d", i);
+        while (!sp.enqueue("t/x", payload, (size_t)n)) // ring full: the writer is behind, retry
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if (i % 16 == 15) {
+            // Let the writer keep up with the 64-entry ring, and drain concurrently
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            next = take_all(sp, next);
+        }
+    }
+    sp.stop();
+    next = take_all(sp, next);
+    assert(next == 1000);
+    assert(sp.appended() == 1000);
+    sp.close();
+    remove_dir(dir);
+
+    std::cout << "✓ test_background_writer passed\n";
+}
+
+void test_enqueue_full_refuses() {
+    std::string dir = make_dir();
+    Spool sp;
+    bool ok = sp.open(dir, 1 << 16, 4);
+    assert(ok);
+    // No writer thread yet: the ring fills up and then refuses, keeping what it holds
+    char payload[64];
+    int i = 0;
+    for (;; ++i) {
+        int n = std::snprintf(payload, sizeof(payload), "payload-%d", i);
+        if (!sp.enqueue("t/x", payload, (size_t)n)) break;
+    }
+    assert(i == (int)industrial::kSpoolQueueCapacity);
+    assert(sp.dropped() == 1);
+    sp.start();
+    sp.stop();
+    assert(sp.appended() == (uint64_t)i);
+    assert(take_all(sp, 0) == i); // the first i in order, none overwritten
+    sp.close();
+    remove_dir(dir);
+
+    std::cout << "✓ test_enqueue_full_refuses passed\n";
+}
+
+int main() {
+    std::cout << "Running Spool tests...\n\n";
+
+    test_fifo_across_segments();
+    test_full_then_reuse();
+    test_recovery_after_reopen();
+    test_torn_tail_ignored();
+    test_background_writer();
+    test_enqueue_full_refuses();
+
+    std::cout << "\n✓ All tests passed!\n";
+    return 0;
+}
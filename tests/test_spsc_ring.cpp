@@ -7,6 +7,7 @@
  * - Drop-oldest (overwrite) behavior when ring is full
  * - Size and capacity tracking
  * - Empty/full state detection
+ * - try_push refusing (drop-newest) when full
  */
 
 #include "industrial/SpscRing.hpp"
@@ -140,6 +141,29 @@ void test_clear() {
     std::cout << "✓ test_clear passed\n";
 }
 
+void test_try_push_refuses_when_full() {
+    TestRing ring;
+
+    for (int i = 0; i < 4; ++i) {
+        assert(ring.try_push(i));
+    }
+    assert(ring.full());
+    assert(!ring.try_push(99));  // Refused, nothing overwritten
+
+    int val;
+    assert(ring.try_pop(val));
+    assert(val == 0);
+    assert(ring.try_push(4));    // Room again
+
+    for (int expect = 1; expect <= 4; ++expect) {
+        assert(ring.try_pop(val));
+        assert(val == expect);
+    }
+    assert(ring.empty());
+
+    std::cout << "✓ test_try_push_refuses_when_full passed\n";
+}
+
 int main() {
     std::cout << "Running SpscRing tests...\n\n";
     
@@ -147,6 +171,7 @@ int main() {
     test_drop_oldest();
     test_continuous_overwrite();
     test_clear();
+    test_try_push_refuses_when_full();
     
     std::cout << "\n✓ All tests passed!\n";
     return 0;
@@ -0,0 +1,136 @@
+/**
+ * @file test_topic_trie.cpp
+ * @brief Unit tests for the TopicTrie subscription matcher.
+ *
+ * Tests verify:
+ * - Literal, '+' and '#' filters, "a/#" matching its parent, '$' topics hidden from leading wildcards
+ * - Invalid filters rejected; per-filter and per-subscriber removal; node reuse on re-subscribe
+ * - Capacity limits reported instead of overflowing
+ * - Randomized agreement with the stand-in broker's reference matcher
+ */
+
+#include "industrial/TopicTrie.hpp"
+#include "support/FakeMqttBroker.hpp"
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using industrial::TopicTrie;
+using industrial::testing::FakeMqttBroker;
+using Mask = TopicTrie<>::Mask;
+
+void test_wildcards() {
+    TopicTrie<> t;
+    assert(t.add("plant/line1/temp", 0));
+    assert(t.add("plant/+/temp", 1));
+    assert(t.add("plant/#", 2));
+    assert(t.add("#", 3));
+    assert(t.add("+/+", 4));
+    assert(t.add("plant/line1/+", 5));
+
+    assert(t.match("plant/line1/temp") == (Mask)0b101111);
+    assert(t.match("plant/line2/temp") == (Mask)0b001110);
+    assert(t.match("plant/line1/press") == (Mask)0b101100);
+    assert(t.match("plant") == (Mask)0b001100); // "plant/#" matches the parent level
+    assert(t.match("plant/x") == (Mask)0b011100);
+    assert(t.match("other/a/b") == (Mask)0b001000);
+    assert(t.match("$SYS/x") == 0);             // no leading wildcards for '$' topics
+    assert(t.add("$SYS/#", 6));
+    assert(t.match("$SYS/x") == (Mask)1 << 6);
+    assert(t.match("") == 0);
+
+    // Empty levels are levels too
+    assert(t.add("a//b", 7));
+    assert(t.match("a//b") & ((Mask)1 << 7));
+    assert(!(t.match("a/b") & ((Mask)1 << 7)));
+
+    std::cout << "✓ test_wildcards passed\n";
+}
+
+void test_invalid_and_remove() {
+    TopicTrie<> t;
+    assert(!t.add("", 0));
+    assert(!t.add("a/#/b", 0));
+    assert(!t.add("a/b#", 0));
+    assert(!t.add("a+/b", 0));
+    assert(!t.add("a", 64)); // subscriber ids are bits of a 64-bit mask
+    assert(t.nodes_used() == 1);
+
+    assert(t.add("s/+/t", 1));
+    assert(t.add("s/#", 1));
+    assert(t.add("s/+/t", 2));
+    assert(t.match("s/x/t") == 0b110);
+    assert(t.remove("s/+/t", 1));
+    assert(!t.remove("s/+/t", 1));
+    assert(!t.remove("s/never", 1));
+    assert(t.match("s/x/t") == 0b110); // subscriber 1 still has "s/#"
+    t.remove_all(1);
+    assert(t.match("s/x/t") == 0b100);
+    const uint32_t nodes = t.nodes_used();
+    assert(t.add("s/+/t", 1));
+    assert(t.nodes_used() == nodes);
+
+    TopicTrie<3, 4> small;
+    assert(small.add("ab/cd", 0));
+    assert(!small.add("ab/ce", 0)); // both the node and the label storage are exhausted
+    assert(!small.add("x", 0));
+    assert(small.match("ab/cd") == 1);
+
+    std::cout << "✓ test_invalid_and_remove passed\n";
+}
+
+void test_against_reference() {
+    const char* levels[] = {"a", "b", "c", "$d", ""};
+    std::mt19937 rng(1234);
+    auto pick = [&](uint32_t n) { return (uint32_t)(rng() % n); };
+    auto make = [&](bool filter) {
+        std::string s;
+        const uint32_t depth = 1 + pick(4);
+        for (uint32_t i = 0; i < depth; ++i) {
+            if (i) s += '/';
+            const uint32_t r = pick(filter ? 7 : 5);
+            if (r == 5) {
+                s += '+';
+            } else if (r == 6) {
+                s += '#';
+                break;
+            } else {
+                s += levels[r];
+            }
+        }
+        return s;
+    };
+
+    for (int round = 0; round < 200; ++round) {
+        TopicTrie<> t;
+        std::vector<std::string> filters;
+        for (uint32_t sub = 0; sub < 16; ++sub) {
+            std::string f;
+            while (f.empty()) f = make(true);
+            filters.push_back(f);
+            assert(t.add(filters.back(), sub));
+        }
+        for (int k = 0; k < 50; ++k) {
+            const std::string topic = make(false);
+            if (topic.empty()) continue;
+            Mask expect = 0;
+            for (uint32_t sub = 0; sub < 16; ++sub) {
+                // The reference matcher has no '$' rule; such topics only match literal first levels
+                const bool dollar_skip = topic[0] == '$' && (filters[sub][0] == '+' || filters[sub][0] == '#');
+                if (!dollar_skip && FakeMqttBroker::topic_matches(filters[sub], topic)) expect |= (Mask)1 << sub;
+            }
+            assert(t.match(topic) == expect);
+        }
+    }
+    std::cout << "✓ test_against_reference passed\n";
+}
+
+int main() {
+    test_wildcards();
+    test_invalid_and_remove();
+    test_against_reference();
+    std::cout << "✓ All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,147 @@
+/**
+ * @file test_wait_strategy.cpp
+ * @brief Unit tests for the consumer wait strategies (WaitStrategy.hpp).
+ *
+ * Tests verify:
+ * - Every strategy delivers all items of a producer/consumer run through SpscRing in order
+ * - FutexPark never sleeps through a push: a parked consumer is woken, a busy one costs no wake calls
+ * - Backoff sleeps grow while idle and never exceed the caller's deadline
+ * - AnyWait selects by name, rejects unknown names and rings only the selected strategy
+ */
+
+#include "industrial/SpscRing.hpp"
+#include "industrial/WaitStrategy.hpp"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace std::chrono;
+
+// Producer pushes kItems with a pause every 64 so the consumer has to idle in between
+template <typename Wait>
+static void run_pipeline(Wait& wait) {
+    constexpr uint32_t kItems = 20000;
+    static industrial::SpscRing<uint32_t, 256, Wait> ring;
+    ring.clear();
+    ring.set_signal(&wait);
+    std::thread consumer([&] {
+        uint32_t expect = 0, v;
+        while (expect < kItems) {
+            if (ring.try_pop(v)) {
+                assert(v == expect);
+                ++expect;
+                wait.reset();
+            } else {
+                wait.idle([&] { return !ring.empty(); }, 1000000000); // 1 s: a lost wake-up stalls the test
+            }
+        }
+    });
+    for (uint32_t i = 0; i < kItems; ++i) {
+        while (!ring.try_push(i)) std::this_thread::yield();
+        if (i % 64 == 63) std::this_thread::sleep_for(microseconds(50));
+    }
+    consumer.join();
+    assert(ring.empty());
+}
+
+void test_all_strategies_deliver() {
+    static industrial::BusySpin spin;
+    static industrial::SpinYield yield;
+    static industrial::Backoff backoff;
+    static industrial::FutexPark park;
+    static industrial::EventfdWait event;
+    assert(event.open());
+    const auto t0 = steady_clock::now();
+    run_pipeline(spin);
+    run_pipeline(yield);
+    run_pipeline(backoff);
+    run_pipeline(park);
+    run_pipeline(event);
+    assert(steady_clock::now() - t0 < seconds(20));
+    std::cout << "✓ test_all_strategies_deliver passed\n";
+}
+
+void test_park_wakeups() {
+    industrial::FutexPark park;
+    // Busy consumer: ring() makes no syscall
+    for (int i = 0; i < 1000; ++i) park.ring();
+    assert(park.wakes() == 0);
+
+    // Ready before parking: the re-check returns without sleeping
+    for (uint32_t i = 0; i < industrial::FutexPark::kSpins; ++i) park.idle([] { return false; }, 1000000);
+    const auto t0 = steady_clock::now();
+    park.idle([] { return true; }, 1000000000);
+    assert(steady_clock::now() - t0 < milliseconds(100) && park.parks() == 0);
+
+    // Parked consumer is woken by ring(), long before its timeout
+    std::atomic<bool> item{false};
+    std::thread consumer([&] {
+        park.reset();
+        while (!item.load()) park.idle([&] { return item.load(); }, 5000000000);
+    });
+    std::this_thread::sleep_for(milliseconds(50)); // consumer spins briefly, then parks
+    const auto t1 = steady_clock::now();
+    item.store(true);
+    park.ring();
+    consumer.join();
+    assert(steady_clock::now() - t1 < seconds(2)); // not the 5 s timeout
+    assert(park.parks() == 1 && park.wakes() == 1);
+
+    // A timed-out park returns on its own
+    const auto t2 = steady_clock::now();
+    park.idle([] { return false; }, 20000000);
+    assert(steady_clock::now() - t2 >= milliseconds(15) && park.parks() >= 1);
+    std::cout << "✓ test_park_wakeups passed (" << park.wakes() << " wake calls)\n";
+}
+
+void test_backoff_deadline() {
+    industrial::Backoff b(1000, 4000000); // 1 us .. 4 ms
+    for (uint32_t i = 0; i < industrial::Backoff::kSpins + industrial::Backoff::kYields; ++i)
+        b.idle([] { return false; }, 1000000000);
+    // Sleeps now double: 1+2+4+...+2048 us in 12 steps, then capped at 4 ms
+    auto t0 = steady_clock::now();
+    for (int i = 0; i < 12; ++i) b.idle([] { return false; }, 1000000000);
+    assert(steady_clock::now() - t0 >= microseconds(4095));
+    // The deadline wins over the current sleep
+    t0 = steady_clock::now();
+    b.idle([] { return false; }, 100000);
+    assert(steady_clock::now() - t0 < milliseconds(3));
+    b.reset();
+    t0 = steady_clock::now();
+    b.idle([] { return false; }, 1000000000);
+    assert(steady_clock::now() - t0 < milliseconds(3)); // back to spinning
+    std::cout << "✓ test_backoff_deadline passed\n";
+}
+
+void test_any_wait() {
+    industrial::AnyWait w;
+    assert(w.kind() == industrial::AnyWait::Kind::Park && std::string(w.name()) == "park");
+    assert(!w.select("nap") && w.kind() == industrial::AnyWait::Kind::Park);
+    for (const char* n : {"spin", "yield", "backoff", "park", "event", "sleep"}) {
+        assert(w.select(n));
+        assert(std::string(w.name()) == n);
+    }
+    assert(w.event().doorbell().is_open());
+    assert(w.select("event"));
+    run_pipeline(w);
+    assert(w.select("park"));
+    run_pipeline(w);
+    assert(w.select("spin"));
+    const uint64_t signals = w.event().doorbell().signals(), wakes = w.park().wakes();
+    run_pipeline(w);
+    assert(w.event().doorbell().signals() == signals && w.park().wakes() == wakes); // spin rings nothing
+    std::cout << "✓ test_any_wait passed\n";
+}
+
+int main() {
+    test_all_strategies_deliver();
+    test_park_wakeups();
+    test_backoff_deadline();
+    test_any_wait();
+    std::cout << "✓ All tests passed!\n";
+    return 0;
+}